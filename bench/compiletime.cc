@@ -0,0 +1,112 @@
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <utility>
+
+#include <unistd.h>
+
+#include "compiletime.h"
+#include "harness.h"
+
+// Compile time of translation units including a single VecCore header, with
+// the compiler and flags of this build. Parsing (-fsyntax-only) is what each
+// header adds to every translation unit of a project including it. Compiling
+// (-c) adds the code generation for what the header defines outside of
+// templates, e.g. static objects. The empty translation unit gives the time
+// to start the compiler, which is part of all others. A header may be
+// included with a macro defined first, e.g. VecCore/Agner with the opt-in
+// AgnerAVX512 backend, which VecCore/VecCore always enables.
+//
+// Each compilation takes about a second, so a quick comparison is
+//
+//   compiletime --min-runs=1 --min-time=0 --warmup=0
+
+struct Header {
+  const char *name;
+  const char *define; // macro defined before the header, or null
+};
+
+static const Header kHeaders[] = {
+    {"", nullptr}, // empty translation unit
+    {"VecCore/Core", nullptr},
+    {"VecCore/Scalar", nullptr},
+    {"VecCore/Library", nullptr}, // VecCore/Scalar with all containers and utilities
+    {"VecCore/Agner", nullptr},
+    {"VecCore/Agner", "VECCORE_ENABLE_AGNER_AVX512"},
+#ifdef VECCORE_ENABLE_VC
+    {"VecCore/Vc", nullptr},
+#endif
+#ifdef VECCORE_ENABLE_UMESIMD
+    {"VecCore/UMESimd", nullptr},
+#endif
+    {"VecCore/VecCore", nullptr},
+};
+
+// Name of the header in the results, with the macro defined before it
+static std::string Label(const Header &header)
+{
+  if (!*header.name) return "(none)";
+  if (!header.define) return header.name;
+  return std::string(header.name) + " +" + header.define;
+}
+
+// Translation unit including the header, in a file of the directory
+static std::string Source(const std::string &dir, const Header &header)
+{
+  const std::string path = dir + "/tu.cc";
+
+  FILE *file = fopen(path.c_str(), "w");
+  if (!file) {
+    perror(path.c_str());
+    exit(1);
+  }
+  if (header.define) fprintf(file, "#define %s\n", header.define);
+  if (*header.name) fprintf(file, "#include <%s>\n", header.name);
+  fprintf(file, "int main() { return 0; }\n");
+  fclose(file);
+
+  return path;
+}
+
+int main(int argc, char *argv[])
+{
+  bench::Harness harness(argc, argv, "compiletime", {"Header", "Mode"}, "TU");
+
+  char tmp[] = "/tmp/veccore-compiletime-XXXXXX";
+  if (!mkdtemp(tmp)) {
+    perror("mkdtemp");
+    return 1;
+  }
+  const std::string dir(tmp);
+  const std::string object = dir + "/tu.o";
+
+  for (const Header &header : kHeaders) {
+    const std::string label = Label(header);
+    const std::string source = Source(dir, header);
+    const std::string compiler = std::string(VECCORE_BENCH_CXX) + " " + VECCORE_BENCH_CXX_FLAGS;
+
+    const std::pair<const char *, std::string> modes[] = {
+        {"parse", compiler + " -fsyntax-only " + source},
+        {"compile", compiler + " -c " + source + " -o " + object},
+    };
+
+    for (auto &mode : modes) {
+      // the first compilation shows errors, later ones are silent
+      if (std::system(mode.second.c_str()) != 0) {
+        fprintf(stderr, "compiletime: failed to compile %s with\n  %s\n", label.c_str(), mode.second.c_str());
+        continue;
+      }
+
+      const std::string quiet = mode.second + " > /dev/null 2>&1";
+      harness.Run({label, mode.first}, 1, [&] {
+        if (std::system(quiet.c_str()) != 0) fprintf(stderr, "compiletime: compilation failed\n");
+      });
+    }
+  }
+
+  unlink((dir + "/tu.cc").c_str());
+  unlink(object.c_str());
+  rmdir(dir.c_str());
+
+  return 0;
+}
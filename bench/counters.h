@@ -0,0 +1,233 @@
+#ifndef VECCORE_BENCH_COUNTERS_H
+#define VECCORE_BENCH_COUNTERS_H
+
+#include <cerrno>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <limits>
+#include <string>
+#include <vector>
+
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+// Hardware performance counters of the calling thread, read with the Linux
+// perf_event_open system call.
+//
+// Each event is opened on its own, so that events the processor or kernel do
+// not support, or which are not allowed, e.g. in containers or virtual
+// machines without a virtual PMU, are simply missing from the results. When
+// the kernel multiplexes more events than there are hardware counters, counts
+// are scaled by the fraction of time each event was actually counted. Only
+// user space is counted, which is allowed with perf_event_paranoid <= 2.
+//
+// Floating point operations by vector width use the FP_ARITH_INST_RETIRED
+// event of Intel processors since Broadwell, and count instructions, not
+// lanes. They are only opened when a probe with a loop of scalar additions
+// counts them, so they are missing on other processors.
+
+namespace bench {
+
+class Counters {
+public:
+  enum Event {
+    kCycles,
+    kInstructions,
+    kCacheMisses,
+    kBranchMisses,
+    kContextSwitches,
+    kFPScalar,
+    kFP128,
+    kFP256,
+    kFP512,
+    kEvents
+  };
+
+  Counters()
+  {
+    for (int i = 0; i < kEvents; ++i) {
+      fFD[i]    = -1;
+      fCount[i] = 0.0;
+    }
+
+#if defined(__linux__)
+    Open(kCycles, PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES);
+    Open(kInstructions, PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS);
+    Open(kCacheMisses, PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES);
+    Open(kBranchMisses, PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES);
+    Open(kContextSwitches, PERF_TYPE_SOFTWARE, PERF_COUNT_SW_CONTEXT_SWITCHES);
+
+    // event 0xc7, with umask bits for scalar single and double precision,
+    // then packed double and single precision for each width
+    if (IsIntelCore()) {
+      Open(kFPScalar, PERF_TYPE_RAW, 0x03c7);
+      Open(kFP128, PERF_TYPE_RAW, 0x0cc7);
+      Open(kFP256, PERF_TYPE_RAW, 0x30c7);
+      Open(kFP512, PERF_TYPE_RAW, 0xc0c7);
+
+      if (!ProbeFP()) {
+        for (int i = kFPScalar; i <= kFP512; ++i) {
+          if (fFD[i] >= 0) close(fFD[i]);
+          fFD[i] = -1;
+        }
+      }
+    }
+#endif
+  }
+
+  Counters(const Counters &) = delete;
+  Counters &operator=(const Counters &) = delete;
+
+  ~Counters()
+  {
+#if defined(__linux__)
+    for (int i = 0; i < kEvents; ++i)
+      if (fFD[i] >= 0) close(fFD[i]);
+#endif
+  }
+
+  static const char *Name(int event)
+  {
+    static const char *names[kEvents] = {"cycles",     "instr",     "cache-miss", "br-miss",    "ctx-switch",
+                                         "fp-scalar", "fp-128", "fp-256",     "fp-512"};
+    return names[event];
+  }
+
+  bool Available(int event) const { return fFD[event] >= 0; }
+
+  // Whether the processor counters could be opened at all
+  bool Available() const { return Available(kCycles) || Available(kInstructions); }
+
+  // Reason the processor counters are not available, if any
+  const std::string &Error() const { return fError; }
+
+  void Reset()
+  {
+    for (int i = 0; i < kEvents; ++i)
+      fCount[i] = 0.0;
+  }
+
+  void Start()
+  {
+#if defined(__linux__)
+    for (int i = 0; i < kEvents; ++i) {
+      if (fFD[i] < 0) continue;
+      Read(i, fStart[i]);
+      ioctl(fFD[i], PERF_EVENT_IOC_ENABLE, 0);
+    }
+#endif
+  }
+
+  // Adds the counts since the last call to Start()
+  void Stop()
+  {
+#if defined(__linux__)
+    for (int i = 0; i < kEvents; ++i) {
+      if (fFD[i] < 0) continue;
+      ioctl(fFD[i], PERF_EVENT_IOC_DISABLE, 0);
+
+      Value end;
+      Read(i, end);
+
+      const double enabled = double(end.enabled - fStart[i].enabled);
+      const double running = double(end.running - fStart[i].running);
+      const double value   = double(end.value - fStart[i].value);
+
+      if (running > 0.0) fCount[i] += value * enabled / running;
+    }
+#endif
+  }
+
+  // Accumulated count of an event, NaN if it is not available
+  double Count(int event) const
+  {
+    return Available(event) ? fCount[event] : std::numeric_limits<double>::quiet_NaN();
+  }
+
+private:
+  struct Value {
+    uint64_t value;
+    uint64_t enabled;
+    uint64_t running;
+  };
+
+#if defined(__linux__)
+  void Open(int event, uint32_t type, uint64_t config)
+  {
+    struct perf_event_attr attr;
+    memset(&attr, 0, sizeof(attr));
+    attr.size           = sizeof(attr);
+    attr.type           = type;
+    attr.config         = config;
+    attr.disabled       = 1;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv     = 1;
+    attr.read_format    = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+    fFD[event] = int(syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+
+    if (fFD[event] < 0 && type == PERF_TYPE_HARDWARE && fError.empty()) fError = strerror(errno);
+  }
+
+  void Read(int event, Value &v) const
+  {
+    if (read(fFD[event], &v, sizeof(v)) != ssize_t(sizeof(v))) v = Value();
+  }
+
+  // Whether the processor is an Intel processor of family 6, which has the
+  // FP_ARITH_INST_RETIRED event from Broadwell on. Older models, and the Atom
+  // and Xeon Phi models of the same family, are rejected by ProbeFP().
+  static bool IsIntelCore()
+  {
+#if defined(__x86_64__) || defined(__i386__)
+    uint32_t a = 0, b, c, d;
+    asm volatile("cpuid" : "+a"(a), "=b"(b), "=c"(c), "=d"(d));
+    if (b != 0x756e6547 || d != 0x49656e69 || c != 0x6c65746e) return false; // "GenuineIntel"
+
+    a = 1;
+    asm volatile("cpuid" : "+a"(a), "=b"(b), "=c"(c), "=d"(d));
+    return ((a >> 8) & 0xf) == 6;
+#else
+    return false;
+#endif
+  }
+
+  // Whether the scalar floating point event counts the additions of a known
+  // loop. Processors without the event may accept its code for another event
+  // or count nothing, as may virtual machines.
+  bool ProbeFP() const
+  {
+    const int kAdds = 1000;
+    if (fFD[kFPScalar] < 0) return false;
+
+    Value start, end;
+    Read(kFPScalar, start);
+    ioctl(fFD[kFPScalar], PERF_EVENT_IOC_ENABLE, 0);
+
+    volatile double x = 0.0;
+    for (int i = 0; i < kAdds; ++i)
+      x = x + 1.0;
+
+    ioctl(fFD[kFPScalar], PERF_EVENT_IOC_DISABLE, 0);
+    Read(kFPScalar, end);
+
+    // at least the additions, and not some unrelated, much more frequent event
+    const uint64_t count = end.value - start.value;
+    return count >= uint64_t(kAdds) && count < uint64_t(4 * kAdds);
+  }
+#endif
+
+  int fFD[kEvents];
+  Value fStart[kEvents];
+  double fCount[kEvents];
+  std::string fError;
+};
+} // namespace bench
+
+#endif
@@ -0,0 +1,468 @@
+#ifndef VECCORE_BENCH_HARNESS_H
+#define VECCORE_BENCH_HARNESS_H
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#if defined(__linux__)
+#include <sched.h>
+#endif
+
+#include "counters.h"
+#include "timer.h"
+#include <VecCore/VecCore>
+
+// Common driver for the benchmarks.
+//
+// Each benchmark is a function run repeatedly on the same data. The harness
+// first runs it for a warmup time, then repeats it until both a minimum number
+// of runs and a minimum total time are reached, and reports robust statistics
+// of the time per item processed: median, median absolute deviation (MAD),
+// and 5th and 95th percentiles. Results with a MAD above 5% of the median are
+// flagged as noisy. A fixed scalar loop is timed before and after each
+// benchmark, and a change in its speed of more than 5% is flagged as a drift
+// of the clock frequency, such as from turbo or thermal throttling.
+//
+// The process is pinned to the CPU it starts on, so that timings are not
+// disturbed by migrations. Results are printed as a table, or as CSV or JSON
+// for tracking them over time. With --counters, hardware performance
+// counters per item are reported as well, when they are available. Options:
+//
+//   --format=table|csv|json   output format (table)
+//   --output=FILE             write results to FILE instead of stdout
+//   --cpu=N|none              pin to CPU N, or do not pin
+//   --filter=TEXT             only run benchmarks with TEXT in their labels
+//   --min-time=SECONDS        minimum total time of the timed runs (0.2)
+//   --min-runs=N              minimum number of timed runs (5)
+//   --max-runs=N              maximum number of timed runs (1000)
+//   --warmup=SECONDS          time of untimed runs before timing (0.05)
+//   --counters                report performance counters (see counters.h)
+//
+// Other arguments are left for the benchmark, in Arguments().
+
+namespace bench {
+
+// Keeps the compiler from removing computations whose result is unused
+template <typename T>
+inline void DoNotOptimize(T const &value)
+{
+  asm volatile("" : : "g"(&value) : "memory");
+}
+
+struct Statistics {
+  size_t runs;
+  double median, mad, min, mean, p05, p95;
+  double drift;
+  bool noisy;
+  bool drifted;
+  double counters[Counters::kEvents]; // per item, NaN if not counted
+};
+
+// Percentile p in [0, 1] of sorted values, interpolated linearly
+inline double Percentile(const std::vector<double> &sorted, double p)
+{
+  if (sorted.empty()) return 0.0;
+  double x = p * (sorted.size() - 1);
+  size_t i = size_t(x);
+  size_t j = std::min(i + 1, sorted.size() - 1);
+  return sorted[i] + (x - i) * (sorted[j] - sorted[i]);
+}
+
+inline Statistics Summarize(std::vector<double> t)
+{
+  Statistics s = Statistics();
+
+  for (double &c : s.counters)
+    c = std::numeric_limits<double>::quiet_NaN();
+
+  std::sort(t.begin(), t.end());
+
+  s.runs   = t.size();
+  s.median = Percentile(t, 0.5);
+  s.min    = t.empty() ? 0.0 : t.front();
+  s.p05    = Percentile(t, 0.05);
+  s.p95    = Percentile(t, 0.95);
+
+  for (double x : t)
+    s.mean += x / t.size();
+
+  std::vector<double> deviation;
+  for (double x : t)
+    deviation.push_back(std::abs(x - s.median));
+  std::sort(deviation.begin(), deviation.end());
+
+  s.mad   = Percentile(deviation, 0.5);
+  s.noisy = s.mad > 0.05 * s.median;
+  return s;
+}
+
+// Calls f(BackendTag<B>(), name) for each enabled backend B
+
+template <class B>
+struct BackendTag {
+  using Backend = B;
+};
+
+// Float_v or Double_v of backend B, for the scalar type S
+template <class B, typename S>
+using FloatVector =
+    typename std::conditional<std::is_same<S, float>::value, typename B::Float_v, typename B::Double_v>::type;
+
+// Int32_v or Int64_v of backend B, for the scalar type S
+template <class B, typename S>
+using IntVector =
+    typename std::conditional<std::is_same<S, int32_t>::value, typename B::Int32_v, typename B::Int64_v>::type;
+
+template <class F>
+void ForEachBackend(F &&f)
+{
+  f(BackendTag<vecCore::backend::Scalar>(), "Scalar");
+  f(BackendTag<vecCore::backend::ScalarWrapper>(), "ScalarWrapper");
+
+#ifdef VECCORE_ENABLE_VC
+  f(BackendTag<vecCore::backend::VcScalar>(), "VcScalar");
+  f(BackendTag<vecCore::backend::VcVector>(), "VcVector");
+  f(BackendTag<vecCore::backend::VcSimdArray<16>>(), "VcSimdArray<16>");
+#endif
+
+#ifdef VECCORE_ENABLE_UMESIMD
+  f(BackendTag<vecCore::backend::UMESimd>(), "UME::SIMD");
+  f(BackendTag<vecCore::backend::UMESimdArray<16>>(), "UME::SIMD<16>");
+#endif
+
+#ifdef VECCORE_ENABLE_AGNER
+  f(BackendTag<vecCore::backend::AgnerAVX>(), "AgnerAVX");
+  f(BackendTag<vecCore::backend::AgnerAVX512>(), "AgnerAVX512");
+#endif
+}
+
+class Harness {
+public:
+  enum class Format { Table, CSV, JSON };
+
+  // columns are the names of the labels of each result, e.g. kernel and
+  // backend, and item what the times are normalized to, e.g. "element"
+  Harness(int argc, char *argv[], const char *name, std::vector<std::string> columns, const char *item)
+      : fName(name), fItem(item), fColumns(columns), fFormat(Format::Table), fOut(stdout), fCPU(-1),
+        fMinTime(0.2), fWarmup(0.05), fMinRuns(5), fMaxRuns(1000), fRows(0), fWidth(0)
+  {
+    bool pin = true;
+
+    for (int i = 1; i < argc; ++i) {
+      std::string arg(argv[i]);
+
+      if (arg.compare(0, 2, "--") != 0) {
+        fArguments.push_back(arg);
+        continue;
+      }
+
+      std::string key = arg.substr(2, arg.find('=') - 2);
+      std::string value = arg.find('=') == std::string::npos ? "" : arg.substr(arg.find('=') + 1);
+
+      if (key == "format" && value == "table")
+        fFormat = Format::Table;
+      else if (key == "format" && value == "csv")
+        fFormat = Format::CSV;
+      else if (key == "format" && value == "json")
+        fFormat = Format::JSON;
+      else if (key == "output")
+        fOut = fopen(value.c_str(), "w");
+      else if (key == "cpu" && value == "none")
+        pin = false;
+      else if (key == "cpu")
+        fCPU = atoi(value.c_str());
+      else if (key == "filter")
+        fFilter = value;
+      else if (key == "min-time")
+        fMinTime = atof(value.c_str());
+      else if (key == "min-runs")
+        fMinRuns = size_t(atol(value.c_str()));
+      else if (key == "max-runs")
+        fMaxRuns = size_t(atol(value.c_str()));
+      else if (key == "warmup")
+        fWarmup = atof(value.c_str());
+      else if (key == "counters")
+        fCounters.reset(new Counters());
+      else {
+        fprintf(stderr, "%s: unknown option %s\n", argv[0], argv[i]);
+        exit(1);
+      }
+    }
+
+    if (!fOut) {
+      perror("output");
+      exit(1);
+    }
+
+    if (pin) Pin();
+
+    if (fCounters && !fCounters->Available())
+      fprintf(stderr, "warning: performance counters are not available (%s)\n", fCounters->Error().c_str());
+
+    if (fFormat == Format::CSV) {
+      fprintf(fOut, "benchmark,section");
+      for (const std::string &c : fColumns)
+        fprintf(fOut, ",%s", c.c_str());
+      fprintf(fOut, ",unit,runs,median,mad,min,mean,p05,p95,drift,noisy");
+      if (fCounters) {
+        for (int e = 0; e < Counters::kEvents; ++e)
+          fprintf(fOut, ",%s", Counters::Name(e));
+        fprintf(fOut, ",ipc");
+      }
+      fprintf(fOut, "\n");
+    }
+  }
+
+  Harness(const Harness &) = delete;
+  Harness &operator=(const Harness &) = delete;
+
+  ~Harness()
+  {
+    EndSection();
+
+    if (fFormat == Format::JSON) {
+      fprintf(fOut, "{\n  \"benchmark\": \"%s\",\n  \"cpu\": %d,\n  \"results\": [", Escape(fName).c_str(), fCPU);
+      for (size_t i = 0; i < fJSON.size(); ++i)
+        fprintf(fOut, "%s\n    %s", i ? "," : "", fJSON[i].c_str());
+      fprintf(fOut, "\n  ]\n}\n");
+    }
+
+    if (fOut != stdout) fclose(fOut);
+  }
+
+  const std::vector<std::string> &Arguments() const { return fArguments; }
+
+  // Starts a group of results, e.g. for single or double precision
+  void Section(const std::string &title)
+  {
+    EndSection();
+    fSection = title;
+    fRows    = 0;
+  }
+
+  // Times f(), which processes the given number of items per call. Returns
+  // statistics of the time per item in nanoseconds, with zero runs if the
+  // labels do not match the filter.
+  template <class F>
+  Statistics Run(const std::vector<std::string> &labels, size_t items, F &&f)
+  {
+    std::string all;
+    for (const std::string &l : labels)
+      all += l + " ";
+
+    if (!fFilter.empty() && all.find(fFilter) == std::string::npos) return Statistics();
+
+    const double before = Calibrate();
+
+    Timer<nanoseconds> timer;
+    do
+      f();
+    while (timer.Elapsed() < 1.0e9 * fWarmup);
+
+    std::vector<double> t;
+    double total = 0.0;
+    if (fCounters) fCounters->Reset();
+    while ((t.size() < fMinRuns || total < 1.0e9 * fMinTime) && t.size() < fMaxRuns) {
+      if (fCounters) fCounters->Start();
+      timer.Start();
+      f();
+      double elapsed = timer.Elapsed();
+      if (fCounters) fCounters->Stop();
+      total += elapsed;
+      t.push_back(elapsed / items);
+    }
+
+    Statistics s = Summarize(t);
+    if (fCounters)
+      for (int e = 0; e < Counters::kEvents; ++e)
+        s.counters[e] = fCounters->Count(e) / (double(items) * t.size());
+    s.drift      = Calibrate() / before - 1.0;
+    s.drifted    = std::abs(s.drift) > 0.05;
+
+    Report(labels, s);
+    return s;
+  }
+
+private:
+  void Pin()
+  {
+#if defined(__linux__)
+    if (fCPU < 0) fCPU = sched_getcpu();
+
+    // sched_getcpu() returns -1 on failure, and --cpu takes any number
+    cpu_set_t set;
+    bool pinned = fCPU >= 0 && fCPU < CPU_SETSIZE;
+    if (pinned) {
+      CPU_ZERO(&set);
+      CPU_SET(fCPU, &set);
+      pinned = sched_setaffinity(0, sizeof(set), &set) == 0;
+    }
+    if (!pinned) {
+      fprintf(stderr, "warning: could not pin to CPU %d\n", fCPU);
+      fCPU = -1;
+    }
+#else
+    fCPU = -1;
+#endif
+  }
+
+  // Time in ns of a fixed chain of dependent integer operations, the best
+  // of five, which changes only with the clock frequency
+  static double Calibrate()
+  {
+    double best = 0.0;
+    for (int k = 0; k < 5; ++k) {
+      Timer<nanoseconds> timer;
+      uint64_t x = 1;
+      for (int i = 0; i < (1 << 20); ++i) {
+        x = x * 6364136223846793005ull + 1442695040888963407ull;
+        asm volatile("" : "+r"(x));
+      }
+      double t = timer.Elapsed();
+      best     = k == 0 ? t : std::min(best, t);
+    }
+    return best;
+  }
+
+  static std::string Escape(const std::string &s)
+  {
+    std::string out;
+    for (char c : s) {
+      if (c == '"' || c == '\\') out += '\\';
+      out += c;
+    }
+    return out;
+  }
+
+  bool HasIPC() const { return fCounters->Available(Counters::kCycles) && fCounters->Available(Counters::kInstructions); }
+
+  static double IPC(const Statistics &s)
+  {
+    return s.counters[Counters::kInstructions] / s.counters[Counters::kCycles];
+  }
+
+  std::string Flags(const Statistics &s) const
+  {
+    std::string flags;
+    if (s.noisy) flags += "noisy";
+    if (s.drifted) flags += flags.empty() ? "drift" : " drift";
+    return flags;
+  }
+
+  void Report(const std::vector<std::string> &labels, const Statistics &s)
+  {
+    char buffer[512];
+
+    switch (fFormat) {
+    case Format::Table:
+      if (fRows++ == 0) BeginSection();
+      for (const std::string &l : labels)
+        fprintf(fOut, "%16s ", l.c_str());
+      fprintf(fOut, "%10.2lf %8.2lf %10.2lf %10.2lf %6zu", s.median, s.mad, s.p05, s.p95, s.runs);
+      if (fCounters) {
+        for (int e = 0; e < Counters::kEvents; ++e)
+          if (fCounters->Available(e)) fprintf(fOut, " %10.3g", s.counters[e]);
+        if (HasIPC()) fprintf(fOut, " %6.2lf", IPC(s));
+      }
+      fprintf(fOut, s.noisy || s.drifted ? "  %s\n" : "%s\n", Flags(s).c_str());
+      break;
+
+    case Format::CSV:
+      fprintf(fOut, "%s,\"%s\"", fName.c_str(), fSection.c_str());
+      for (const std::string &l : labels)
+        fprintf(fOut, ",\"%s\"", l.c_str());
+      fprintf(fOut, ",ns/%s,%zu,%g,%g,%g,%g,%g,%g,%g,%d", fItem.c_str(), s.runs, s.median, s.mad, s.min, s.mean,
+              s.p05, s.p95, s.drift, int(s.noisy));
+      if (fCounters) {
+        for (int e = 0; e < Counters::kEvents; ++e)
+          fprintf(fOut, std::isnan(s.counters[e]) ? "," : ",%g", s.counters[e]);
+        fprintf(fOut, HasIPC() ? ",%g" : ",", IPC(s));
+      }
+      fprintf(fOut, "\n");
+      break;
+
+    case Format::JSON: {
+      std::string row = "{\"section\": \"" + Escape(fSection) + "\"";
+      for (size_t i = 0; i < labels.size() && i < fColumns.size(); ++i)
+        row += ", \"" + Escape(fColumns[i]) + "\": \"" + Escape(labels[i]) + "\"";
+      snprintf(buffer, sizeof(buffer),
+               ", \"unit\": \"ns/%s\", \"runs\": %zu, \"median\": %g, \"mad\": %g, \"min\": %g, \"mean\": %g, "
+               "\"p05\": %g, \"p95\": %g, \"drift\": %g, \"noisy\": %s}",
+               Escape(fItem).c_str(), s.runs, s.median, s.mad, s.min, s.mean, s.p05, s.p95, s.drift,
+               s.noisy ? "true" : "false");
+      row += buffer;
+      if (fCounters) {
+        row.resize(row.size() - 1);
+        row += ", \"counters\": {";
+        for (int e = 0; e < Counters::kEvents; ++e) {
+          if (!fCounters->Available(e)) continue;
+          snprintf(buffer, sizeof(buffer), "\"%s\": %g, ", Counters::Name(e), s.counters[e]);
+          row += buffer;
+        }
+        if (HasIPC()) {
+          snprintf(buffer, sizeof(buffer), "\"ipc\": %g, ", IPC(s));
+          row += buffer;
+        }
+        if (row.back() == ' ') row.resize(row.size() - 2);
+        row += "}}";
+      }
+      fJSON.push_back(row);
+      break;
+    }
+    }
+
+    fflush(fOut);
+  }
+
+  void BeginSection()
+  {
+    if (!fSection.empty()) fprintf(fOut, "\n%s\n\n", fSection.c_str());
+    for (const std::string &c : fColumns)
+      fprintf(fOut, "%16s ", c.c_str());
+    int n = fprintf(fOut, "%10s %8s %10s %10s %6s", "Median", "MAD", "P05", "P95", "Runs");
+    if (fCounters) {
+      for (int e = 0; e < Counters::kEvents; ++e)
+        if (fCounters->Available(e)) n += fprintf(fOut, " %10s", Counters::Name(e));
+      if (HasIPC()) n += fprintf(fOut, " %6s", "IPC");
+    }
+    n += fprintf(fOut, fCounters ? "  (ns, counts per %s)" : "  (ns/%s)", fItem.c_str());
+    fWidth = 17 * fColumns.size() + size_t(n);
+    fprintf(fOut, "\n%s\n", std::string(fWidth, '-').c_str());
+  }
+
+  void EndSection()
+  {
+    if (fFormat == Format::Table && fRows > 0) fprintf(fOut, "%s\n", std::string(fWidth, '-').c_str());
+    fRows = 0;
+  }
+
+  std::string fName;
+  std::string fItem;
+  std::vector<std::string> fColumns;
+  std::vector<std::string> fArguments;
+  std::vector<std::string> fJSON;
+  std::string fFilter;
+  std::string fSection;
+  Format fFormat;
+  FILE *fOut;
+  int fCPU;
+  double fMinTime;
+  double fWarmup;
+  size_t fMinRuns;
+  size_t fMaxRuns;
+  size_t fRows;
+  size_t fWidth;
+  std::unique_ptr<Counters> fCounters;
+};
+} // namespace bench
+
+#endif
@@ -2,8 +2,7 @@
 #include <cstdlib>
 #include <string>
 
-#include "timer.h"
-#include <VecCore/VecCore>
+#include "harness.h"
 
 using namespace vecCore;
 
@@ -20,15 +19,12 @@ void julia(T xmin, T xmax, size_t nx,
     for (size_t i = 0; i < nx; ++i) {
         for (size_t j = 0; j < ny; ++j) {
             size_t k = 0;
-            T x = xmin + T(i) * dx, cr = real, zr = x;
-            T y = ymin + T(j) * dy, ci = im, zi = y;
+            Complex<T> c(real, im);
+            Complex<T> z(xmin + T(i) * dx, ymin + T(j) * dy);
 
             do {
-                x  = zr*zr - zi*zi + cr;
-                y  = T(2.0) * zr*zi + ci;
-                zr = x;
-                zi = y;
-            } while (++k < max_iter && (zr*zr + zi*zi < T(4.0)));
+                z = z * z + c;
+            } while (++k < max_iter && math::Abs2(z) < T(4.0));
 
             image[ny*i + j] = k;
         }
@@ -40,7 +36,7 @@ void julia_v(Scalar<T> xmin, Scalar<T> xmax, size_t nx,
              Scalar<T> ymin, Scalar<T> ymax, size_t ny,
              Scalar<Index<T>> max_iter, unsigned char *image, Scalar<T> real, Scalar<T> im)
 {
-    T iota;
+    T iota(Scalar<T>(0));
     for (size_t i = 0; i < VectorSize<T>(); ++i)
         Set<T>(iota, i, i);
 
@@ -50,19 +46,16 @@ void julia_v(Scalar<T> xmin, Scalar<T> xmax, size_t nx,
     for (size_t i = 0; i < nx; ++i) {
         for (size_t j = 0; j < ny; j += VectorSize<T>()) {
             Scalar<Index<T>> k{0};
-            T x = xmin + T(i) * dx,       cr = real, zr = x;
-            T y = ymin + T(j) * dy + dyv, ci = im, zi = y;
+            Complex<T> c(real, im);
+            Complex<T> z(xmin + T(i) * dx, ymin + T(j) * dy + dyv);
 
             Index<T> kv{0};
             Mask<T> m{true};
 
             do {
-                x = zr*zr - zi*zi + cr;
-                y = T(2.0) * zr*zi + ci;
-                MaskedAssign<T>(zr, m, x);
-                MaskedAssign<T>(zi, m, y);
+                MaskedAssign(z, m, z * z + c);
                 MaskedAssign<Index<T>>(kv, m, ++k);
-                m = zr*zr + zi*zi < T(4.0);
+                m = math::Abs2(z) < T(4.0);
             } while (k < max_iter && !MaskEmpty(m));
 
             for (size_t k = 0; k < VectorSize<T>(); ++k)
@@ -72,30 +65,28 @@ void julia_v(Scalar<T> xmin, Scalar<T> xmax, size_t nx,
 }
 
 template<typename T>
-void bench_julia(T xmin, T xmax, size_t nx, T ymin, T ymax, size_t ny,
+void bench_julia(bench::Harness &harness, T xmin, T xmax, size_t nx, T ymin, T ymax, size_t ny,
                  int max_iter, unsigned char *image, const char *backend, T cr, T ci)
 {
     std::string filename = "julia_" + std::string(backend) + ".png";
-    Timer<milliseconds> timer;
-    julia<T>(xmin, xmax, nx, ymin, ymax, ny, max_iter, image, cr, ci);
-    printf("%15s: %7.2lf ms\n", backend, timer.Elapsed());
+    harness.Run({backend}, nx * ny, [&] { julia<T>(xmin, xmax, nx, ymin, ymax, ny, max_iter, image, cr, ci); });
     write_png(filename.c_str(), image, nx, ny);
 }
 
 template<typename T>
-void bench_julia_v(Scalar<T> xmin, Scalar<T> xmax, size_t nx,
+void bench_julia_v(bench::Harness &harness, Scalar<T> xmin, Scalar<T> xmax, size_t nx,
                    Scalar<T> ymin, Scalar<T> ymax, size_t ny,
                    int max_iter, unsigned char *image, const char *backend, Scalar<T> cr, Scalar<T> ci)
 {
     std::string filename = "julia_" + std::string(backend) + ".png";
-    Timer<milliseconds> timer;
-    julia_v<T>(xmin, xmax, nx, ymin, ymax, ny, max_iter, image, cr, ci);
-    printf("%15s: %7.2lf ms\n", backend, timer.Elapsed());
+    harness.Run({backend}, nx * ny, [&] { julia_v<T>(xmin, xmax, nx, ymin, ymax, ny, max_iter, image, cr, ci); });
     write_png(filename.c_str(), image, nx, ny);
 }
 
 int main(int argc, char *argv[])
 {
+    bench::Harness harness(argc, argv, "julia", {"Backend"}, "pixel");
+
     double xmin = -2, xmax = 2;
     double ymin = -2, ymax = 2;
 
@@ -103,68 +94,70 @@ int main(int argc, char *argv[])
     double cr = 0.285, ci = 0.01;
     unsigned char *image = new unsigned char[nx*ny];
 
-    if (argc > 1) {
-        if (argc != 3) {
+    const std::vector<std::string> &args = harness.Arguments();
+
+    if (!args.empty()) {
+        if (args.size() != 2) {
            fprintf(stderr, "%s: incorrect number of parameters\n\n"
-                           "Usage: julia [<Re(c)> <Im(c)>]\n\n\twhere f(z) = z*z + c\n",
+                           "Usage: julia [options] [<Re(c)> <Im(c)>]\n\n\twhere f(z) = z*z + c\n",
                            argv[0]);
            return 1;
         } else {
-            cr = atof(argv[1]);
-            ci = atof(argv[2]);
+            cr = atof(args[0].c_str());
+            ci = atof(args[1].c_str());
         }
     }
 
     /* single precision */
 
-    bench_julia<float>(xmin, xmax, nx, ymin, ymax, ny,
+    bench_julia<float>(harness, xmin, xmax, nx, ymin, ymax, ny,
                        max_iter, image, "float", cr, ci);
 
-    bench_julia_v<float>(xmin, xmax, nx, ymin, ymax, ny,
+    bench_julia_v<float>(harness, xmin, xmax, nx, ymin, ymax, ny,
                          max_iter, image, "float_v", cr, ci);
 
 #ifdef VECCORE_ENABLE_VC
-    bench_julia_v<backend::VcVector::Float_v>(xmin, xmax, nx, ymin, ymax, ny,
+    bench_julia_v<backend::VcVector::Float_v>(harness, xmin, xmax, nx, ymin, ymax, ny,
                                               max_iter, image, "float_vc", cr, ci);
 #endif
 
 #ifdef VECCORE_ENABLE_UMESIMD
-    bench_julia_v<backend::UMESimd::Float_v>(xmin, xmax, nx, ymin, ymax, ny,
+    bench_julia_v<backend::UMESimd::Float_v>(harness, xmin, xmax, nx, ymin, ymax, ny,
                                              max_iter, image, "float_umesimd", cr, ci);
 #endif
 
 #ifdef VECCORE_ENABLE_AGNER
-    bench_julia_v<backend::AgnerAVX::Float_v>(xmin, xmax, nx, ymin, ymax, ny,
+    bench_julia_v<backend::AgnerAVX::Float_v>(harness, xmin, xmax, nx, ymin, ymax, ny,
                                               max_iter, image, "float_agnerAVX",
                                               cr, ci);
-    bench_julia_v<backend::AgnerAVX512::Float_v>(xmin, xmax, nx, ymin, ymax, ny,
+    bench_julia_v<backend::AgnerAVX512::Float_v>(harness, xmin, xmax, nx, ymin, ymax, ny,
                                                  max_iter, image,
                                                  "float_agnerAVX512", cr, ci);
 #endif
 
     /* double precision */
 
-    bench_julia<double>(xmin, xmax, nx, ymin, ymax, ny,
+    bench_julia<double>(harness, xmin, xmax, nx, ymin, ymax, ny,
                              max_iter, image, "double", cr, ci);
 
-    bench_julia_v<backend::Scalar::Double_v>(xmin, xmax, nx, ymin, ymax, ny,
+    bench_julia_v<backend::Scalar::Double_v>(harness, xmin, xmax, nx, ymin, ymax, ny,
                                                   max_iter, image, "double_v", cr, ci);
 
 #ifdef VECCORE_ENABLE_VC
-    bench_julia_v<backend::VcVector::Double_v>(xmin, xmax, nx, ymin, ymax, ny,
+    bench_julia_v<backend::VcVector::Double_v>(harness, xmin, xmax, nx, ymin, ymax, ny,
                                                     max_iter, image, "double_vc", cr, ci);
 #endif
 
 #ifdef VECCORE_ENABLE_UMESIMD
-    bench_julia_v<backend::UMESimd::Double_v>(xmin, xmax, nx, ymin, ymax, ny,
+    bench_julia_v<backend::UMESimd::Double_v>(harness, xmin, xmax, nx, ymin, ymax, ny,
                                                    max_iter, image, "double_umesimd", cr, ci);
 #endif
 
 #ifdef VECCORE_ENABLE_AGNER
-    bench_julia_v<backend::AgnerAVX::Double_v>(xmin, xmax, nx, ymin, ymax, ny,
+    bench_julia_v<backend::AgnerAVX::Double_v>(harness, xmin, xmax, nx, ymin, ymax, ny,
                                                max_iter, image,
                                                "double_agnerAVX", cr, ci);
-    bench_julia_v<backend::AgnerAVX512::Double_v>(xmin, xmax, nx, ymin, ymax,
+    bench_julia_v<backend::AgnerAVX512::Double_v>(harness, xmin, xmax, nx, ymin, ymax,
                                                   ny, max_iter, image,
                                                   "double_agnerAVX512", cr, ci);
 #endif
@@ -0,0 +1,194 @@
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <numeric>
+#include <random>
+#include <vector>
+
+#include "harness.h"
+
+using namespace vecCore;
+
+static constexpr size_t kN       = (1024 * 1024);
+static constexpr size_t kNfields = 10;
+
+// A particle with enough fields that a structure of arrays needs many streams
+// of memory at once, advanced with a streaming kernel that uses all of them
+
+template <typename T>
+struct Particle {
+  T x, y, z, px, py, pz, m, e, t, w;
+};
+
+template <typename T>
+VECCORE_FORCE_INLINE
+void Step(T &x, T &y, T &z, const T &px, const T &py, const T &pz, const T &m, T &e, T &t, T &w)
+{
+  const Scalar<T> dt(0.01);
+  e       = math::Sqrt(px * px + py * py + pz * pz + m * m);
+  T s     = dt / e;
+  x      += px * s;
+  y      += py * s;
+  z      += pz * s;
+  t      += dt;
+  w      *= Scalar<T>(0.999);
+}
+
+template <typename S>
+using AoS = std::vector<Particle<S>, AlignedAllocator<Particle<S>>>;
+
+template <typename S>
+using SoA = std::vector<std::vector<S, AlignedAllocator<S>>>;
+
+template <typename T>
+using AoSoA_t = AoSoA<T, T, T, T, T, T, T, T, T, T>;
+
+// Order in which blocks of VectorSize<T>() particles are processed, either
+// sequential or shuffled to defeat the hardware prefetcher
+
+template <typename T>
+std::vector<size_t> BlockOrder(bool shuffle)
+{
+  std::vector<size_t> order(kN / VectorSize<T>());
+  std::iota(order.begin(), order.end(), 0);
+  if (shuffle) std::shuffle(order.begin(), order.end(), std::mt19937(42));
+  return order;
+}
+
+template <typename T>
+void TestSoA(bench::Harness &harness, SoA<Scalar<T>> &soa, bool shuffle, const char *name)
+{
+  const std::vector<size_t> order = BlockOrder<T>(shuffle);
+  Scalar<T> *f[kNfields];
+  for (size_t k = 0; k < kNfields; ++k)
+    f[k] = soa[k].data();
+
+  harness.Run({"SoA", shuffle ? "shuffled" : "sequential", name}, kN, [&] {
+    for (size_t b : order) {
+      const size_t i = b * VectorSize<T>();
+      Particle<T> p;
+      T *v = &p.x;
+      for (size_t k = 0; k < kNfields; ++k)
+        Load(v[k], f[k] + i);
+      Step(p.x, p.y, p.z, p.px, p.py, p.pz, p.m, p.e, p.t, p.w);
+      for (size_t k = 0; k < kNfields; ++k)
+        Store(v[k], f[k] + i);
+    }
+  });
+}
+
+template <typename T>
+void TestAoS(bench::Harness &harness, AoS<Scalar<T>> &aos, bool shuffle, const char *name)
+{
+  const std::vector<size_t> order = BlockOrder<T>(shuffle);
+  Scalar<T> *base = &aos[0].x;
+
+  Index<T> idx = Index<T>(Scalar<Index<T>>(0));
+  for (size_t k = 0; k < VectorSize<T>(); ++k)
+    Set(idx, k, Scalar<Index<T>>(k * kNfields));
+
+  harness.Run({"AoS", shuffle ? "shuffled" : "sequential", name}, kN, [&] {
+    for (size_t b : order) {
+      Scalar<T> *ptr = base + b * VectorSize<T>() * kNfields;
+      Particle<T> p;
+      T *v = &p.x;
+      for (size_t k = 0; k < kNfields; ++k)
+        v[k] = Gather<T>(ptr + k, idx);
+      Step(p.x, p.y, p.z, p.px, p.py, p.pz, p.m, p.e, p.t, p.w);
+      for (size_t k = 0; k < kNfields; ++k)
+        Scatter(v[k], ptr + k, idx);
+    }
+  });
+}
+
+template <typename T>
+void TestAoSoA(bench::Harness &harness, AoSoA_t<T> &aosoa, bool shuffle, const char *name)
+{
+  const std::vector<size_t> order = BlockOrder<T>(shuffle);
+
+  harness.Run({"AoSoA", shuffle ? "shuffled" : "sequential", name}, kN, [&] {
+    for (size_t b : order) {
+      auto &p = aosoa.GetBlock(b);
+      Step(p.template Field<0>(), p.template Field<1>(), p.template Field<2>(), p.template Field<3>(),
+           p.template Field<4>(), p.template Field<5>(), p.template Field<6>(), p.template Field<7>(),
+           p.template Field<8>(), p.template Field<9>());
+    }
+  });
+}
+
+// Sets the first K fields of an element of an AoSoA from an array
+template <size_t K>
+struct SetFields {
+  template <class Element, typename S>
+  static void Apply(const Element &e, const S *p)
+  {
+    e.template Set<K - 1>(p[K - 1]);
+    SetFields<K - 1>::Apply(e, p);
+  }
+};
+
+template <>
+struct SetFields<0> {
+  template <class Element, typename S>
+  static void Apply(const Element &, const S *)
+  {
+  }
+};
+
+template <typename T>
+void TestLayouts(bench::Harness &harness, bool shuffle, const char *name)
+{
+  using S = Scalar<T>;
+
+  SoA<S> soa(kNfields, std::vector<S, AlignedAllocator<S>>(kN));
+  AoS<S> aos(kN);
+  AoSoA_t<T> aosoa(kN);
+
+  for (size_t i = 0; i < kN; ++i) {
+    S *p = &aos[i].x;
+    for (size_t k = 0; k < kNfields; ++k) {
+      S value = S(drand48());
+      soa[k][i] = value;
+      p[k]      = value;
+    }
+    SetFields<kNfields>::Apply(aosoa[i], p);
+  }
+
+  TestSoA<T>(harness, soa, shuffle, name);
+  TestAoS<T>(harness, aos, shuffle, name);
+  TestAoSoA<T>(harness, aosoa, shuffle, name);
+}
+
+template <typename S>
+struct TestBackends {
+  bench::Harness &harness;
+  bool shuffle;
+
+  template <class B>
+  void operator()(bench::BackendTag<B>, const char *name) const
+  {
+    TestLayouts<bench::FloatVector<B, S>>(harness, shuffle, name);
+  }
+};
+
+template <typename S>
+void Benchmark(bench::Harness &harness, const char *type)
+{
+  harness.Section(type);
+
+  for (bool shuffle : {false, true})
+    bench::ForEachBackend(TestBackends<S>{harness, shuffle});
+}
+
+int main(int argc, char *argv[])
+{
+  bench::Harness harness(argc, argv, "layouts", {"Layout", "Access", "Backend"}, "particle");
+
+  srand48(time(NULL));
+
+  Benchmark<Float_s>(harness, "Single Precision");
+  Benchmark<Double_s>(harness, "Double Precision");
+
+  return 0;
+}
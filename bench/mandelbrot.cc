@@ -2,8 +2,7 @@
 #include <cstdlib>
 #include <string>
 
-#include "timer.h"
-#include <VecCore/VecCore>
+#include "harness.h"
 
 using namespace vecCore;
 
@@ -20,15 +19,11 @@ void mandelbrot(T xmin, T xmax, size_t nx,
     for (size_t i = 0; i < nx; ++i) {
         for (size_t j = 0; j < ny; ++j) {
             size_t k = 0;
-            T x = xmin + T(i) * dx, cr = x, zr = x;
-            T y = ymin + T(j) * dy, ci = y, zi = y;
+            Complex<T> c(xmin + T(i) * dx, ymin + T(j) * dy), z = c;
 
             do {
-                x  = zr*zr - zi*zi + cr;
-                y  = T(2.0) * zr*zi + ci;
-                zr = x;
-                zi = y;
-            } while (++k < max_iter && (zr*zr + zi*zi < T(4.0)));
+                z = z * z + c;
+            } while (++k < max_iter && math::Abs2(z) < T(4.0));
 
             image[ny*i + j] = k;
         }
@@ -40,7 +35,7 @@ void mandelbrot_v(Scalar<T> xmin, Scalar<T> xmax, size_t nx,
                   Scalar<T> ymin, Scalar<T> ymax, size_t ny,
                   Scalar<Index<T>> max_iter, unsigned char *image)
 {
-    T iota;
+    T iota(Scalar<T>(0));
     for (size_t i = 0; i < VectorSize<T>(); ++i)
         Set<T>(iota, i, i);
 
@@ -50,19 +45,15 @@ void mandelbrot_v(Scalar<T> xmin, Scalar<T> xmax, size_t nx,
     for (size_t i = 0; i < nx; ++i) {
         for (size_t j = 0; j < ny; j += VectorSize<T>()) {
             Scalar<Index<T>> k{0};
-            T x = xmin + T(i) * dx,       cr = x, zr = x;
-            T y = ymin + T(j) * dy + dyv, ci = y, zi = y;
+            Complex<T> c(xmin + T(i) * dx, ymin + T(j) * dy + dyv), z = c;
 
             Index<T> kv{0};
             Mask<T> m{true};
 
             do {
-                x = zr*zr - zi*zi + cr;
-                y = T(2.0) * zr*zi + ci;
-                MaskedAssign<T>(zr, m, x);
-                MaskedAssign<T>(zi, m, y);
+                MaskedAssign(z, m, z * z + c);
                 MaskedAssign<Index<T>>(kv, m, ++k);
-                m = zr*zr + zi*zi < T(4.0);
+                m = math::Abs2(z) < T(4.0);
             } while (k < max_iter && !MaskEmpty(m));
 
             for (size_t k = 0; k < VectorSize<T>(); ++k)
@@ -72,30 +63,28 @@ void mandelbrot_v(Scalar<T> xmin, Scalar<T> xmax, size_t nx,
 }
 
 template<typename T>
-void bench_mandelbrot(T xmin, T xmax, size_t nx, T ymin, T ymax, size_t ny,
+void bench_mandelbrot(bench::Harness &harness, T xmin, T xmax, size_t nx, T ymin, T ymax, size_t ny,
                       int max_iter, unsigned char *image, const char *backend)
 {
     std::string filename = "mandelbrot_" + std::string(backend) + ".png";
-    Timer<milliseconds> timer;
-    mandelbrot<T>(xmin, xmax, nx, ymin, ymax, ny, max_iter, image);
-    printf("%15s: %7.2lf ms\n", backend, timer.Elapsed());
+    harness.Run({backend}, nx * ny, [&] { mandelbrot<T>(xmin, xmax, nx, ymin, ymax, ny, max_iter, image); });
     write_png(filename.c_str(), image, nx, ny);
 }
 
 template<typename T>
-void bench_mandelbrot_v(Scalar<T> xmin, Scalar<T> xmax, size_t nx,
+void bench_mandelbrot_v(bench::Harness &harness, Scalar<T> xmin, Scalar<T> xmax, size_t nx,
                         Scalar<T> ymin, Scalar<T> ymax, size_t ny,
                         int max_iter, unsigned char *image, const char *backend)
 {
     std::string filename = "mandelbrot_" + std::string(backend) + ".png";
-    Timer<milliseconds> timer;
-    mandelbrot_v<T>(xmin, xmax, nx, ymin, ymax, ny, max_iter, image);
-    printf("%15s: %7.2lf ms\n", backend, timer.Elapsed());
+    harness.Run({backend}, nx * ny, [&] { mandelbrot_v<T>(xmin, xmax, nx, ymin, ymax, ny, max_iter, image); });
     write_png(filename.c_str(), image, nx, ny);
 }
 
 int main(int argc, char *argv[])
 {
+    bench::Harness harness(argc, argv, "mandelbrot", {"Backend"}, "pixel");
+
     double xmin = -2.1, xmax = 1.1;
     double ymin = -1.35, ymax = 1.35;
 
@@ -104,52 +93,52 @@ int main(int argc, char *argv[])
 
     /* single precision */
 
-    bench_mandelbrot<float>(xmin, xmax, nx, ymin, ymax, ny,
+    bench_mandelbrot<float>(harness, xmin, xmax, nx, ymin, ymax, ny,
                             max_iter, image, "float");
 
-    bench_mandelbrot_v<float>(xmin, xmax, nx, ymin, ymax, ny,
+    bench_mandelbrot_v<float>(harness, xmin, xmax, nx, ymin, ymax, ny,
                               max_iter, image, "float_v");
 
 #ifdef VECCORE_ENABLE_VC
-    bench_mandelbrot_v<backend::VcVector::Float_v>(xmin, xmax, nx, ymin, ymax, ny,
+    bench_mandelbrot_v<backend::VcVector::Float_v>(harness, xmin, xmax, nx, ymin, ymax, ny,
                                                    max_iter, image, "float_vc");
 #endif
 
 #ifdef VECCORE_ENABLE_UMESIMD
-    bench_mandelbrot_v<backend::UMESimd::Float_v>(xmin, xmax, nx, ymin, ymax, ny,
+    bench_mandelbrot_v<backend::UMESimd::Float_v>(harness, xmin, xmax, nx, ymin, ymax, ny,
                                                   max_iter, image, "float_umesimd");
 #endif
 
 #ifdef VECCORE_ENABLE_AGNER
     bench_mandelbrot_v<backend::AgnerAVX::Float_v>(
-        xmin, xmax, nx, ymin, ymax, ny, max_iter, image, "float_agnerAVX");
+        harness, xmin, xmax, nx, ymin, ymax, ny, max_iter, image, "float_agnerAVX");
     bench_mandelbrot_v<backend::AgnerAVX512::Float_v>(
-        xmin, xmax, nx, ymin, ymax, ny, max_iter, image, "float_agnerAVX512");
+        harness, xmin, xmax, nx, ymin, ymax, ny, max_iter, image, "float_agnerAVX512");
 #endif
 
     /* double precision */
 
-    bench_mandelbrot<double>(xmin, xmax, nx, ymin, ymax, ny,
+    bench_mandelbrot<double>(harness, xmin, xmax, nx, ymin, ymax, ny,
                              max_iter, image, "double");
 
-    bench_mandelbrot_v<backend::Scalar::Double_v>(xmin, xmax, nx, ymin, ymax, ny,
+    bench_mandelbrot_v<backend::Scalar::Double_v>(harness, xmin, xmax, nx, ymin, ymax, ny,
                                                   max_iter, image, "double_v");
 
 #ifdef VECCORE_ENABLE_VC
-    bench_mandelbrot_v<backend::VcVector::Double_v>(xmin, xmax, nx, ymin, ymax, ny,
+    bench_mandelbrot_v<backend::VcVector::Double_v>(harness, xmin, xmax, nx, ymin, ymax, ny,
                                                     max_iter, image, "double_vc");
 #endif
 
 #ifdef VECCORE_ENABLE_UMESIMD
-    bench_mandelbrot_v<backend::UMESimd::Double_v>(xmin, xmax, nx, ymin, ymax, ny,
+    bench_mandelbrot_v<backend::UMESimd::Double_v>(harness, xmin, xmax, nx, ymin, ymax, ny,
                                                    max_iter, image, "double_umesimd");
 #endif
 
 #ifdef VECCORE_ENABLE_AGNER
     bench_mandelbrot_v<backend::AgnerAVX::Double_v>(
-        xmin, xmax, nx, ymin, ymax, ny, max_iter, image, "double_agnerAVX");
+        harness, xmin, xmax, nx, ymin, ymax, ny, max_iter, image, "double_agnerAVX");
     bench_mandelbrot_v<backend::AgnerAVX512::Double_v>(
-        xmin, xmax, nx, ymin, ymax, ny, max_iter, image, "double_agnerAVX512");
+        harness, xmin, xmax, nx, ymin, ymax, ny, max_iter, image, "double_agnerAVX512");
 #endif
     return 0;
 }
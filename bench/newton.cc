@@ -4,13 +4,13 @@
 #include <cstdlib>
 #include <string>
 
-#include "timer.h"
-#include <VecCore/VecCore>
+#include "harness.h"
 
 using namespace vecCore;
 
 /*
-    calculates Newton fractal for f(z) = z^4 - 1
+    calculates Newton fractal for f(z) = z^4 - 1, iterating
+    z -> z - f(z) / f'(z) = z - (z^4 - 1) / (4 z^3)
     https://en.wikipedia.org/wiki/Newton_fractal
 */
 
@@ -23,33 +23,33 @@ Color COLORS[] = {
 };
 
 template <typename T>
-bool is_equal(T re1, T im1, T re2, T im2)
+bool is_equal(Complex<T> z, T re, T im)
 {
     const T tol2 = 0.0001;
-    return ((re1 - re2) * (re1 - re2) + (im1 - im2) * (im1 - im2)) < tol2;
+    return math::Abs2(z - Complex<T>(re, im)) < tol2;
 }
 
 template <typename T>
-bool converged(T re, T im, int iters, uint8_t& color_index, uint8_t& alpha)
+bool converged(Complex<T> z, int iters, uint8_t& color_index, uint8_t& alpha)
 {
     alpha = std::min(iters * 10, 100);
 
-    if (is_equal(re, im, T(1), T(0))) {
+    if (is_equal(z, T(1), T(0))) {
         color_index = 1;
         return true;
     }
 
-    if (is_equal(re, im, T(-1), T(0))) {
+    if (is_equal(z, T(-1), T(0))) {
         color_index = 2;
         return true;
     }
 
-    if (is_equal(re, im, T(0), T(1))) {
+    if (is_equal(z, T(0), T(1))) {
         color_index = 3;
         return true;
     }
 
-    if (is_equal(re, im, T(0), T(-1))) {
+    if (is_equal(z, T(0), T(-1))) {
         color_index = 4;
         return true;
     }
@@ -68,21 +68,13 @@ void newton(T xmin, T xmax, size_t nx,
     for (size_t i = 0; i < nx; ++i) {
         for (size_t j = 0; j < ny; ++j) {
             uint8_t color_index = 0, alpha = 0;
-            T re = xmin + T(i) * dx, x = re;
-            T im = ymin + T(j) * dy, y = im;
+            Complex<T> z(xmin + T(i) * dx, ymin + T(j) * dy);
             bool has_converged = false;
 
             for (size_t k = 0; !has_converged && (k < max_iter); ) {
-                T re2 = re * re, re3 = re2 * re, re4 = re3 * re, re5 = re4 * re, re6 = re5 * re, re7 = re6 * re;
-                T im2 = im * im, im3 = im2 * im, im4 = im3 * im, im5 = im4 * im, im6 = im5 * im, im7 = im6 * im;
-                T coeff = T(0.25) / ((re2 + im2) * (re2 + im2) * (re2 + im2));
-
-                x = T(3) * re * im2 + re * im6 + re7 + T(3) * re5 * im2 - re3 + T(3) * re3 * im4;
-                y = T(3) * re2 * im + im7 + T(3) * re2 * im5 - im3 + re6 * im + T(3) * re4 * im3;
-
-                re -= x * coeff;
-                im -= y * coeff;
-                has_converged = converged(re, im, k, color_index, alpha);
+                Complex<T> z3 = math::Pow(z, 3);
+                z -= (z3 * z - T(1)) / (T(4) * z3);
+                has_converged = converged(z, k, color_index, alpha);
                 ++k;
             }
             Color color = COLORS[color_index];
@@ -94,28 +86,28 @@ void newton(T xmin, T xmax, size_t nx,
 
 
 template <typename T>
-Mask<T> is_equal_v(T re1, T im1, T re2, T im2)
+Mask<T> is_equal_v(Complex<T> z, T re, T im)
 {
     const T tol2 = 0.0001;
-    return ((re1 - re2) * (re1 - re2) + (im1 - im2) * (im1 - im2)) < tol2;
+    return math::Abs2(z - Complex<T>(re, im)) < tol2;
 }
 
 template <typename T>
-Mask<T> converged_v(T re, T im, Index<T> iters, Index<T>& color_index, Index<T>& alphas)
+Mask<T> converged_v(Complex<T> z, Index<T> iters, Index<T>& color_index, Index<T>& alphas)
 {
     alphas = iters * 10;
     MaskedAssign<Index<T>>(alphas, alphas > 100, 100);
 
-    Mask<T> m0 = is_equal_v(re, im, T(1), T(0));
+    Mask<T> m0 = is_equal_v(z, T(1), T(0));
     MaskedAssign<Index<T>>(color_index, m0, 1);
 
-    Mask<T> m1 = is_equal_v(re, im, T(-1), T(0));
+    Mask<T> m1 = is_equal_v(z, T(-1), T(0));
     MaskedAssign<Index<T>>(color_index, m1, 2);
 
-    Mask<T> m2 = is_equal_v(re, im, T(0), T(1));
+    Mask<T> m2 = is_equal_v(z, T(0), T(1));
     MaskedAssign<Index<T>>(color_index, m2, 3);
 
-    Mask<T> m3 = is_equal_v(re, im, T(0), T(-1));
+    Mask<T> m3 = is_equal_v(z, T(0), T(-1));
     MaskedAssign<Index<T>>(color_index, m3, 4);
 
     return m0 || m1 || m2 || m3;
@@ -126,7 +118,7 @@ void newton_v(T xmin, T xmax, size_t nx,
               T ymin, T ymax, size_t ny,
               size_t max_iter, Color *image)
 {
-    T iota;
+    T iota(Scalar<T>(0));
     for (size_t i = 0; i < VectorSize<T>(); ++i) {
         Set<T>(iota, i, i);
     }
@@ -136,8 +128,7 @@ void newton_v(T xmin, T xmax, size_t nx,
     
     for (size_t i = 0; i < nx; ++i) {
         for (size_t j = 0; j < ny; j += VectorSize<T>()) {
-            T re = xmin + T(i) * dx,       x = re;
-            T im = ymin + T(j) * dy + dyv, y = im;
+            Complex<T> z(xmin + T(i) * dx, ymin + T(j) * dy + dyv);
 
             Index<T> kv{0};
             Index<T> color_index{0};
@@ -145,16 +136,9 @@ void newton_v(T xmin, T xmax, size_t nx,
             Mask<T> m{false};
 
             for (size_t k = 0; !MaskFull(m) && (k < max_iter); ) {
-                T re2 = re * re, re3 = re2 * re, re4 = re3 * re, re5 = re4 * re, re6 = re5 * re, re7 = re6 * re;
-                T im2 = im * im, im3 = im2 * im, im4 = im3 * im, im5 = im4 * im, im6 = im5 * im, im7 = im6 * im;
-                T coeff = T(0.25) / ((re2 + im2) * (re2 + im2) * (re2 + im2));
-
-                x = T(3) * re * im2 + re * im6 + re7 + T(3) * re5 * im2 - re3 + T(3) * re3 * im4;
-                y = T(3) * re2 * im + im7 + T(3) * re2 * im5 - im3 + re6 * im + T(3) * re4 * im3;
-
-                re -= x * coeff;
-                im -= y * coeff;
-                m = converged_v(re, im, kv, color_index, alphas);
+                Complex<T> z3 = math::Pow(z, 3);
+                z -= (z3 * z - T(1)) / (T(4) * z3);
+                m = converged_v(z, kv, color_index, alphas);
                 MaskedAssign<Index<T>>(kv, !m, ++k);
             }
 
@@ -170,31 +154,29 @@ void newton_v(T xmin, T xmax, size_t nx,
 }
 
 template<typename T>
-void bench_newton(T xmin, T xmax, size_t nx, 
+void bench_newton(bench::Harness &harness, T xmin, T xmax, size_t nx, 
                   T ymin, T ymax, size_t ny,
                   int max_iter, Color *image, const char *backend)
 {
     std::string filename = "newton_" + std::string(backend) + ".png";
-    Timer<milliseconds> timer;
-    newton<T>(xmin, xmax, nx, ymin, ymax, ny, max_iter, image);
-    printf("%15s: %7.2lf ms\n", backend, timer.Elapsed());
+    harness.Run({backend}, nx * ny, [&] { newton<T>(xmin, xmax, nx, ymin, ymax, ny, max_iter, image); });
     write_png(filename.c_str(), image, nx, ny);
 }
 
 template<typename T>
-void bench_newton_v(Scalar<T> xmin, Scalar<T> xmax, size_t nx,
+void bench_newton_v(bench::Harness &harness, Scalar<T> xmin, Scalar<T> xmax, size_t nx,
                     Scalar<T> ymin, Scalar<T> ymax, size_t ny,
                     int max_iter, Color *image, const char *backend)
 {
     std::string filename = "newton_" + std::string(backend) + ".png";
-    Timer<milliseconds> timer;
-    newton_v<T>(xmin, xmax, nx, ymin, ymax, ny, max_iter, image);
-    printf("%15s: %7.2lf ms\n", backend, timer.Elapsed());
+    harness.Run({backend}, nx * ny, [&] { newton_v<T>(xmin, xmax, nx, ymin, ymax, ny, max_iter, image); });
     write_png(filename.c_str(), image, nx, ny);
 }
 
 int main(int argc, char *argv[])
 {
+    bench::Harness harness(argc, argv, "newton", {"Backend"}, "pixel");
+
     double xmin = -2, xmax = 2;
     double ymin = -2, ymax = 2;
 
@@ -203,53 +185,53 @@ int main(int argc, char *argv[])
 
     /* single precision */
 
-    bench_newton<float>(xmin, xmax, nx, ymin, ymax, ny, 
+    bench_newton<float>(harness, xmin, xmax, nx, ymin, ymax, ny, 
                         max_iter, image, "float");
 
-    bench_newton_v<float>(xmin, xmax, nx, ymin, ymax, ny,
+    bench_newton_v<float>(harness, xmin, xmax, nx, ymin, ymax, ny,
                           max_iter, image, "float_v");
 
 
 #ifdef VECCORE_ENABLE_VC
-    bench_newton_v<backend::VcVector::Float_v>(xmin, xmax, nx, ymin, ymax, ny,
+    bench_newton_v<backend::VcVector::Float_v>(harness, xmin, xmax, nx, ymin, ymax, ny,
                                                max_iter, image, "float_vc");
 #endif
 
 #ifdef VECCORE_ENABLE_UMESIMD
-    bench_newton_v<backend::UMESimd::Float_v>(xmin, xmax, nx, ymin, ymax, ny,
+    bench_newton_v<backend::UMESimd::Float_v>(harness, xmin, xmax, nx, ymin, ymax, ny,
                                               max_iter, image, "float_umesimd");
 #endif
 
 #ifdef VECCORE_ENABLE_AGNER
     bench_newton_v<backend::AgnerAVX::Float_v>(
-        xmin, xmax, nx, ymin, ymax, ny, max_iter, image, "float_agnerAVX");
+        harness, xmin, xmax, nx, ymin, ymax, ny, max_iter, image, "float_agnerAVX");
     bench_newton_v<backend::AgnerAVX512::Float_v>(
-        xmin, xmax, nx, ymin, ymax, ny, max_iter, image, "float_agnerAVX512");
+        harness, xmin, xmax, nx, ymin, ymax, ny, max_iter, image, "float_agnerAVX512");
 #endif
 
     /* double precision */
 
-    bench_newton<double>(xmin, xmax, nx, ymin, ymax, ny,
+    bench_newton<double>(harness, xmin, xmax, nx, ymin, ymax, ny,
                          max_iter, image, "double");
 
-    bench_newton_v<backend::Scalar::Double_v>(xmin, xmax, nx, ymin, ymax, ny,
+    bench_newton_v<backend::Scalar::Double_v>(harness, xmin, xmax, nx, ymin, ymax, ny,
                                               max_iter, image, "double_v");
 
 #ifdef VECCORE_ENABLE_VC
-    bench_newton_v<backend::VcVector::Double_v>(xmin, xmax, nx, ymin, ymax, ny,
+    bench_newton_v<backend::VcVector::Double_v>(harness, xmin, xmax, nx, ymin, ymax, ny,
                                                 max_iter, image, "double_vc");
 #endif
 
 #ifdef VECCORE_ENABLE_UMESIMD
-    bench_newton_v<backend::UMESimd::Double_v>(xmin, xmax, nx, ymin, ymax, ny,
+    bench_newton_v<backend::UMESimd::Double_v>(harness, xmin, xmax, nx, ymin, ymax, ny,
                                                max_iter, image, "double_umesimd");
 #endif
 
 #ifdef VECCORE_ENABLE_AGNER
     bench_newton_v<backend::AgnerAVX::Double_v>(
-        xmin, xmax, nx, ymin, ymax, ny, max_iter, image, "double_agnerAVX");
+        harness, xmin, xmax, nx, ymin, ymax, ny, max_iter, image, "double_agnerAVX");
     bench_newton_v<backend::AgnerAVX512::Double_v>(
-        xmin, xmax, nx, ymin, ymax, ny, max_iter, image, "double_agnerAVX512");
+        harness, xmin, xmax, nx, ymin, ymax, ny, max_iter, image, "double_agnerAVX512");
 #endif
 
     return 0;
@@ -0,0 +1,410 @@
+#include <cstdio>
+#include <cstdlib>
+#include <numeric>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "harness.h"
+
+using namespace vecCore;
+
+// Latency and throughput of the primitive operations of the backend
+// interface: Gather, Scatter, Blend, MaskedAssign, MaskFull, MaskEmpty,
+// Get/Set, the horizontal reductions and Convert. Integer vectors are
+// measured as well, except for Gather and Scatter, whose integer tables are
+// already those of the "Gather index" rows.
+//
+// Each primitive is written as a step, which takes a state, e.g. a vector,
+// and returns the next one. Latency is the time per step of a single chain of
+// dependent steps, throughput the time per step of kChains independent chains
+// interleaved with each other, as in instruction tables. Primitives without a
+// result to chain, i.e. Scatter and the mask tests, are only run for
+// throughput. When the result of a step cannot be used directly as the next
+// state, the step includes the least work to convert it, as noted below.
+//
+// Gather is measured by chasing indices through a table, so that the indices
+// of each gather are the result of the previous one. The indices of a gather
+// are consecutive (sequential), kStride elements apart, i.e. one cache line
+// apart for float (strided), or a random permutation of the table (random).
+// The table is small enough to stay in the L1 cache. The Gather rows load
+// floating point values, which are converted to the next indices, and the
+// "Gather index" rows load the indices themselves from an integer table.
+
+static constexpr size_t kN      = 4096;
+static constexpr size_t kOps    = 8192;
+static constexpr size_t kChains = 8;
+static constexpr size_t kStride = 16;
+static constexpr size_t kInputs = 64;
+
+template <typename X>
+using Array = std::vector<X, AlignedAllocator<X, alignof(X)>>;
+
+enum class Pattern { Sequential, Strided, Random };
+
+static const char *PatternName(Pattern p)
+{
+  return p == Pattern::Sequential ? "sequential" : p == Pattern::Strided ? "strided" : "random";
+}
+
+// Random values in [0, 1) for floating point types, and in [0, 1024) for
+// integers
+template <typename S>
+S Random(std::true_type)
+{
+  return S(drand48());
+}
+
+template <typename S>
+S Random(std::false_type)
+{
+  return S(lrand48() % 1024);
+}
+
+// Random vectors and masks, shared by all primitives of one backend and type
+template <typename T>
+struct Inputs {
+  using S = Scalar<T>;
+
+  Array<T> x, y;
+  Mask<T> mask[kInputs]; // not a vector, which would be std::vector<bool> for Scalar
+
+  Inputs() : x(kInputs, T(0)), y(kInputs, T(0))
+  {
+    for (size_t j = 0; j < kInputs; ++j) {
+      for (size_t i = 0; i < VectorSize<T>(); ++i) {
+        Set(x[j], i, Random<S>(std::is_floating_point<S>()));
+        Set(y[j], i, Random<S>(std::is_floating_point<S>()));
+      }
+      mask[j] = x[j] > y[j];
+    }
+  }
+};
+
+// idx = Gather(next, idx), with next[j] the index following j
+template <typename T>
+struct GatherStep {
+  using I     = Index<T>;
+  using State = I;
+
+  static constexpr bool kChained = true;
+
+  Array<Scalar<I>> next;
+  Array<I> start;
+
+  GatherStep(Pattern p) : next(kN), start(kChains, I(0))
+  {
+    constexpr size_t kVS = VectorSize<I>();
+
+    std::vector<size_t> order(kN);
+    std::iota(order.begin(), order.end(), size_t(0));
+
+    // the table is a single cycle visiting the elements in this order
+    if (p == Pattern::Random)
+      for (size_t i = kN - 1; i > 0; --i)
+        std::swap(order[i], order[size_t(drand48() * (i + 1))]);
+
+    const size_t step = p == Pattern::Sequential ? kVS : 1;
+    for (size_t i = 0; i < kN; ++i)
+      next[order[i]] = Scalar<I>(order[(i + step) % kN]);
+
+    // lanes of the same gather, and chains, start at different places
+    const size_t lane = p == Pattern::Sequential ? 1 : p == Pattern::Strided ? kStride : kN / kVS;
+    for (size_t k = 0; k < kChains; ++k)
+      for (size_t i = 0; i < kVS; ++i)
+        Set(start[k], i, Scalar<I>(order[(k * (kN / kChains) + i * lane) % kN]));
+  }
+
+  State Init(size_t k) const { return start[k]; }
+
+  VECCORE_FORCE_INLINE
+  State operator()(const State &idx, size_t) const { return Gather<I>(next.data(), idx); }
+};
+
+// x = Gather(next, Convert<Index<T>>(x)), the same chase through a table of
+// floating point values; includes a conversion
+template <typename T>
+struct FloatGatherStep {
+  using State = T;
+
+  static constexpr bool kChained = true;
+
+  Array<Scalar<T>> next;
+  Array<T> start;
+
+  FloatGatherStep(Pattern p) : next(kN), start(kChains, T(0))
+  {
+    const GatherStep<T> g(p);
+    for (size_t i = 0; i < kN; ++i)
+      next[i] = Scalar<T>(g.next[i]);
+    for (size_t k = 0; k < kChains; ++k)
+      for (size_t i = 0; i < VectorSize<T>(); ++i)
+        Set(start[k], i, Scalar<T>(Get(g.start[k], i)));
+  }
+
+  State Init(size_t k) const { return start[k]; }
+
+  VECCORE_FORCE_INLINE
+  State operator()(const State &x, size_t) const { return Gather<T>(next.data(), Convert<Index<T>>(x)); }
+};
+
+// Scatter(x, out, idx) with the indices of a gather chase
+template <typename T>
+struct ScatterStep {
+  using State = T;
+
+  static constexpr bool kChained = false;
+
+  Array<Index<T>> idx;
+  Array<Scalar<T>> &out;
+
+  ScatterStep(Pattern p, Array<Scalar<T>> &o) : idx(kInputs), out(o)
+  {
+    GatherStep<T> g(p);
+    Index<T> i = g.Init(0);
+    for (size_t j = 0; j < kInputs; ++j)
+      idx[j] = i = g(i, j);
+  }
+
+  State Init(size_t k) const { return State(Scalar<T>(k)); }
+
+  VECCORE_FORCE_INLINE
+  State operator()(const State &x, size_t j) const
+  {
+    Scatter(x, out.data(), idx[j % kInputs]);
+    return x;
+  }
+};
+
+// x = Blend(mask, y, x)
+template <typename T>
+struct BlendStep {
+  using State = T;
+
+  static constexpr bool kChained = true;
+
+  const Inputs<T> &in;
+
+  State Init(size_t k) const { return in.x[k]; }
+
+  VECCORE_FORCE_INLINE
+  State operator()(const State &x, size_t j) const
+  {
+    return Blend(in.mask[j % kInputs], in.y[j % kInputs], x);
+  }
+};
+
+// MaskedAssign(x, mask, y)
+template <typename T>
+struct MaskedAssignStep {
+  using State = T;
+
+  static constexpr bool kChained = true;
+
+  const Inputs<T> &in;
+
+  State Init(size_t k) const { return in.x[k]; }
+
+  VECCORE_FORCE_INLINE
+  State operator()(State x, size_t j) const
+  {
+    MaskedAssign(x, in.mask[j % kInputs], in.y[j % kInputs]);
+    return x;
+  }
+};
+
+// count += MaskFull(mask) or MaskEmpty(mask)
+template <typename T, bool Full>
+struct MaskTestStep {
+  using State = size_t;
+
+  static constexpr bool kChained = false;
+
+  const Inputs<T> &in;
+
+  State Init(size_t) const { return 0; }
+
+  VECCORE_FORCE_INLINE
+  State operator()(State count, size_t j) const
+  {
+    return count + (Full ? MaskFull(in.mask[j % kInputs]) : MaskEmpty(in.mask[j % kInputs]));
+  }
+};
+
+// Set(x, j + 1, Get(x, j)), with lanes taken modulo the vector size
+template <typename T>
+struct GetSetStep {
+  using State = T;
+
+  static constexpr bool kChained = true;
+
+  const Inputs<T> &in;
+
+  State Init(size_t k) const { return in.x[k]; }
+
+  VECCORE_FORCE_INLINE
+  State operator()(State x, size_t j) const
+  {
+    Set(x, (j + 1) % VectorSize<T>(), Get(x, j % VectorSize<T>()));
+    return x;
+  }
+};
+
+// x = w * Reduce(x), where w is 1/VectorSize for ReduceAdd and 1 otherwise,
+// so that values stay the same; includes a broadcast, and a product for Add.
+// For integers, the sum is instead kept below 1024 with a bitwise and.
+enum class Reduction { Add, Min, Max };
+
+template <typename T>
+VECCORE_FORCE_INLINE
+T Normalize(const T &sum, std::true_type)
+{
+  return T(Scalar<T>(1) / Scalar<T>(VectorSize<T>())) * sum;
+}
+
+template <typename T>
+VECCORE_FORCE_INLINE
+T Normalize(const T &sum, std::false_type)
+{
+  return sum & T(Scalar<T>(1023));
+}
+
+template <typename T, Reduction R>
+struct ReduceStep {
+  using State = T;
+
+  static constexpr bool kChained = true;
+
+  const Inputs<T> &in;
+
+  State Init(size_t k) const { return in.x[k]; }
+
+  VECCORE_FORCE_INLINE
+  State operator()(const State &x, size_t) const
+  {
+    if (R == Reduction::Add) return Normalize(T(ReduceAdd(x)), std::is_floating_point<Scalar<T>>());
+    return T(R == Reduction::Min ? ReduceMin(x) : ReduceMax(x));
+  }
+};
+
+// x = Convert<T>(Convert<U>(x)), i.e. two conversions per step, with U
+// Index<T> for floating point types and the floating point type of the same
+// width for integers
+template <typename T, typename U>
+struct ConvertStep {
+  using State = T;
+
+  static constexpr bool kChained = true;
+
+  const Inputs<T> &in;
+
+  State Init(size_t k) const { return in.x[k]; }
+
+  VECCORE_FORCE_INLINE
+  State operator()(const State &x, size_t) const { return Convert<T>(Convert<U>(x)); }
+};
+
+template <class Step>
+void Measure(bench::Harness &harness, const char *primitive, const char *pattern, const char *backend,
+             const Step &step)
+{
+  using State = typename Step::State;
+
+  if (Step::kChained) {
+    harness.Run({primitive, pattern, "latency", backend}, kOps, [&] {
+      State s = step.Init(0);
+      for (size_t j = 0; j < kOps; ++j)
+        s = step(s, j);
+      bench::DoNotOptimize(s);
+    });
+  }
+
+  harness.Run({primitive, pattern, "throughput", backend}, kOps, [&] {
+    State s[kChains];
+    for (size_t k = 0; k < kChains; ++k)
+      s[k] = step.Init(k);
+    for (size_t j = 0; j < kOps / kChains; ++j)
+      for (size_t k = 0; k < kChains; ++k)
+        s[k] = step(s[k], j);
+    bench::DoNotOptimize(s);
+  });
+}
+
+// Primitives measured for all types
+template <typename T>
+void MeasureCommon(bench::Harness &harness, const char *name, const Inputs<T> &in)
+{
+  Measure(harness, "Blend", "", name, BlendStep<T>{in});
+  Measure(harness, "MaskedAssign", "", name, MaskedAssignStep<T>{in});
+  Measure(harness, "MaskFull", "", name, MaskTestStep<T, true>{in});
+  Measure(harness, "MaskEmpty", "", name, MaskTestStep<T, false>{in});
+  Measure(harness, "Get/Set", "", name, GetSetStep<T>{in});
+  Measure(harness, "ReduceAdd", "", name, ReduceStep<T, Reduction::Add>{in});
+  Measure(harness, "ReduceMin", "", name, ReduceStep<T, Reduction::Min>{in});
+  Measure(harness, "ReduceMax", "", name, ReduceStep<T, Reduction::Max>{in});
+}
+
+template <typename S>
+struct TestBackends {
+  bench::Harness &harness;
+
+  template <class B>
+  void operator()(bench::BackendTag<B>, const char *name) const
+  {
+    using T = bench::FloatVector<B, S>;
+
+    const Inputs<T> in;
+    Array<Scalar<T>> out(kN);
+
+    for (Pattern p : {Pattern::Sequential, Pattern::Strided, Pattern::Random})
+      Measure(harness, "Gather", PatternName(p), name, FloatGatherStep<T>(p));
+
+    for (Pattern p : {Pattern::Sequential, Pattern::Strided, Pattern::Random})
+      Measure(harness, "Gather index", PatternName(p), name, GatherStep<T>(p));
+
+    for (Pattern p : {Pattern::Sequential, Pattern::Strided, Pattern::Random})
+      Measure(harness, "Scatter", PatternName(p), name, ScatterStep<T>(p, out));
+
+    MeasureCommon(harness, name, in);
+    Measure(harness, "Convert", "to Index", name, ConvertStep<T, Index<T>>{in});
+  }
+};
+
+template <typename S>
+struct TestIntegerBackends {
+  bench::Harness &harness;
+
+  template <class B>
+  void operator()(bench::BackendTag<B>, const char *name) const
+  {
+    using T = bench::IntVector<B, S>;
+    using F = bench::FloatVector<B, typename std::conditional<sizeof(S) == 4, float, double>::type>;
+
+    const Inputs<T> in;
+
+    MeasureCommon(harness, name, in);
+    Measure(harness, "Convert", sizeof(S) == 4 ? "to Float_v" : "to Double_v", name, ConvertStep<T, F>{in});
+  }
+};
+
+int main(int argc, char *argv[])
+{
+  bench::Harness harness(argc, argv, "primitives", {"Primitive", "Pattern", "Mode", "Backend"}, "op");
+
+  // fixed seed, so that the random patterns are the same from run to run
+  srand48(42);
+
+  harness.Section("Single Precision");
+  bench::ForEachBackend(TestBackends<Float_s>{harness});
+
+  harness.Section("Double Precision");
+  bench::ForEachBackend(TestBackends<Double_s>{harness});
+
+  harness.Section("32-bit Integers");
+  bench::ForEachBackend(TestIntegerBackends<int32_t>{harness});
+
+  harness.Section("64-bit Integers");
+  bench::ForEachBackend(TestIntegerBackends<int64_t>{harness});
+
+  return 0;
+}
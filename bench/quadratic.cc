@@ -3,12 +3,10 @@
 #include <cstdlib>
 #include <limits>
 
-#include "timer.h"
-#include <VecCore/VecCore>
+#include "harness.h"
 
 using namespace vecCore;
 
-static constexpr size_t kNruns = 10;
 static constexpr size_t kN = (32 * 1024 * 1024);
 
 // solve ax2 + bx + c = 0
@@ -147,28 +145,14 @@ void QuadSolveSIMD(typename Backend::Float_v const &a, typename Backend::Float_v
   MaskedAssign(x2, mask1, root1);
 }
 
-VECCORE_FORCE_NOINLINE
-void TestQuadSolve(const float *__restrict__ a, const float *__restrict__ b, const float *__restrict__ c,
-                   float *__restrict__ x1, float *__restrict__ x2, int *__restrict__ roots, size_t kN)
+void TestQuadSolve(bench::Harness &harness, const float *__restrict__ a, const float *__restrict__ b,
+                   const float *__restrict__ c, float *__restrict__ x1, float *__restrict__ x2,
+                   int *__restrict__ roots, size_t kN)
 {
-  Timer<milliseconds> timer;
-  double t[kNruns], mean = 0.0, sigma = 0.0;
-  for (size_t n = 0; n < kNruns; n++) {
-    timer.Start();
+  harness.Run({"Scalar"}, kN, [&] {
     for (size_t i = 0; i < kN; i ++)
       roots[i] = QuadSolve(a[i], b[i], c[i], x1[i], x2[i]);
-    t[n] = timer.Elapsed();
-  }
-
-  for (size_t n = 0; n < kNruns; n++)
-    mean += t[n];
-
-  mean = mean / kNruns;
-
-  for (size_t n = 0; n < kNruns; n++)
-    sigma += std::pow(t[n] - mean, 2.0);
-
-  sigma = std::sqrt(sigma);
+  });
 
 #ifdef VERBOSE
   size_t index = (size_t)((kN - 100) * drand48());
@@ -176,31 +160,16 @@ void TestQuadSolve(const float *__restrict__ a, const float *__restrict__ b, con
     printf("%d: a = % 8.3f, b = % 8.3f, c = % 8.3f, roots = %d, x1 = % 8.3f, x2 = % 8.3f\n", i, a[i], b[i], c[i],
            roots[i], roots[i] > 0 ? x1[i] : 0, roots[i] > 1 ? x2[i] : 0);
 #endif
-  printf("%20s %8.1lf %7.1lf\n", "Scalar", mean, sigma);
 }
 
-VECCORE_FORCE_NOINLINE
-void TestQuadSolveOptimized(const float *__restrict__ a, const float *__restrict__ b, const float *__restrict__ c,
-                            float *__restrict__ x1, float *__restrict__ x2, int *__restrict__ roots, size_t kN)
+void TestQuadSolveOptimized(bench::Harness &harness, const float *__restrict__ a, const float *__restrict__ b,
+                            const float *__restrict__ c, float *__restrict__ x1, float *__restrict__ x2,
+                            int *__restrict__ roots, size_t kN)
 {
-  Timer<milliseconds> timer;
-  double t[kNruns], mean = 0.0, sigma = 0.0;
-  for (size_t n = 0; n < kNruns; n++) {
-    timer.Start();
+  harness.Run({"Optimized Scalar"}, kN, [&] {
     for (size_t i = 0; i < kN; i ++)
       QuadSolveOptimized(a[i], b[i], c[i], x1[i], x2[i], roots[i]);
-    t[n] = timer.Elapsed();
-  }
-
-  for (size_t n = 0; n < kNruns; n++)
-    mean += t[n];
-
-  mean = mean / kNruns;
-
-  for (size_t n = 0; n < kNruns; n++)
-    sigma += std::pow(t[n] - mean, 2.0);
-
-  sigma = std::sqrt(sigma);
+  });
 
 #ifdef VERBOSE
   size_t index = (size_t)((kN - 100) * drand48());
@@ -208,32 +177,17 @@ void TestQuadSolveOptimized(const float *__restrict__ a, const float *__restrict
     printf("%d: a = % 8.3f, b = % 8.3f, c = % 8.3f, roots = %d, x1 = % 8.3f, x2 = % 8.3f\n", i, a[i], b[i], c[i],
            roots[i], roots[i] > 0 ? x1[i] : 0, roots[i] > 1 ? x2[i] : 0);
 #endif
-  printf("%20s %8.1lf %7.1lf\n", "Optimized Scalar", mean, sigma);
 }
 
 #ifdef __AVX2__
-VECCORE_FORCE_NOINLINE
-void TestQuadSolveAVX2(const float *__restrict__ a, const float *__restrict__ b, const float *__restrict__ c,
-                       float *__restrict__ x1, float *__restrict__ x2, int *__restrict__ roots, size_t kN)
+void TestQuadSolveAVX2(bench::Harness &harness, const float *__restrict__ a, const float *__restrict__ b,
+                       const float *__restrict__ c, float *__restrict__ x1, float *__restrict__ x2,
+                       int *__restrict__ roots, size_t kN)
 {
-  Timer<milliseconds> timer;
-  double t[kNruns], mean = 0.0, sigma = 0.0;
-  for (size_t n = 0; n < kNruns; n++) {
-    timer.Start();
+  harness.Run({"AVX2 Intrinsics"}, kN, [&] {
     for (size_t i = 0; i < kN; i += 8)
       QuadSolveAVX(&a[i], &b[i], &c[i], &x1[i], &x2[i], &roots[i]);
-    t[n] = timer.Elapsed();
-  }
-
-  for (size_t n = 0; n < kNruns; n++)
-    mean += t[n];
-
-  mean = mean / kNruns;
-
-  for (size_t n = 0; n < kNruns; n++)
-    sigma += std::pow(t[n] - mean, 2.0);
-
-  sigma = std::sqrt(sigma);
+  });
 
 #ifdef VERBOSE
   size_t index = (size_t)((kN - 100) * drand48());
@@ -241,37 +195,57 @@ void TestQuadSolveAVX2(const float *__restrict__ a, const float *__restrict__ b,
     printf("%d: a = % 8.3f, b = % 8.3f, c = % 8.3f, roots = %d, x1 = % 8.3f, x2 = % 8.3f\n", i, a[i], b[i], c[i],
            roots[i], roots[i] > 0 ? x1[i] : 0, roots[i] > 1 ? x2[i] : 0);
 #endif
-  printf("%20s %8.1lf %7.1lf\n", "AVX2 Intrinsics", mean, sigma);
 }
 #endif
 
-template <class Backend>
-VECCORE_FORCE_NOINLINE
-void TestQuadSolve(const float *__restrict__ a, const float *__restrict__ b, const float *__restrict__ c,
-                   float *__restrict__ x1, float *__restrict__ x2, int *__restrict__ roots, size_t kN, const char *name)
+// Inputs are read with aligned loads. Unless Streaming is set, the results
+// are written with aligned stores, which first read each cache line of the
+// outputs into the cache. Otherwise, they are written with non-temporal
+// stores, which write whole lines directly to memory, and the inputs are
+// prefetched a few cache lines ahead. Prefetching with PrefetchHint::NTA was
+// measured to be slower here, as the hardware prefetcher already brings
+// sequential streams into L2.
+
+template <class Backend, bool Streaming = false>
+void TestQuadSolve(bench::Harness &harness, const float *__restrict__ a, const float *__restrict__ b,
+                   const float *__restrict__ c, float *__restrict__ x1, float *__restrict__ x2,
+                   int *__restrict__ roots, size_t kN, const char *name)
 {
   using Float_v = typename Backend::Float_v;
   using Int32_v = typename Backend::Int32_v;
 
-  Timer<milliseconds> timer;
-  double t[kNruns], mean = 0.0, sigma = 0.0;
-  for (size_t n = 0; n < kNruns; n++) {
-    timer.Start();
-    for (size_t i = 0; i < kN; i += VectorSize<Float_v>())
-      QuadSolveSIMD<Backend>((Float_v &)(a[i]), (Float_v &)(b[i]), (Float_v &)(c[i]), (Float_v &)(x1[i]),
-          (Float_v &)(x2[i]), (Int32_v &)(roots[i]));
-    t[n] = timer.Elapsed();
-  }
-
-  for (size_t n = 0; n < kNruns; n++)
-    mean += t[n];
-
-  mean = mean / kNruns;
-
-  for (size_t n = 0; n < kNruns; n++)
-    sigma += std::pow(t[n] - mean, 2.0);
-
-  sigma = std::sqrt(sigma);
+  // in elements, a few cache lines ahead
+  constexpr size_t kPrefetchDistance = 1024 / sizeof(float);
+
+  harness.Run({name}, kN, [&] {
+    for (size_t i = 0; i < kN; i += VectorSize<Float_v>()) {
+      Float_v va, vb, vc, vx1(0.0f), vx2(0.0f);
+      Int32_v vroots;
+
+      if (Streaming) {
+        Prefetch<PrefetchHint::T0>(&a[i + kPrefetchDistance]);
+        Prefetch<PrefetchHint::T0>(&b[i + kPrefetchDistance]);
+        Prefetch<PrefetchHint::T0>(&c[i + kPrefetchDistance]);
+      }
+
+      LoadAligned(va, &a[i]);
+      LoadAligned(vb, &b[i]);
+      LoadAligned(vc, &c[i]);
+
+      QuadSolveSIMD<Backend>(va, vb, vc, vx1, vx2, vroots);
+
+      if (Streaming) {
+        StoreStreaming(vx1, &x1[i]);
+        StoreStreaming(vx2, &x2[i]);
+        StoreStreaming(vroots, &roots[i]);
+      } else {
+        StoreAligned(vx1, &x1[i]);
+        StoreAligned(vx2, &x2[i]);
+        StoreAligned(vroots, &roots[i]);
+      }
+    }
+    if (Streaming) StoreFence();
+  });
 
 #ifdef VERBOSE
   size_t index = (size_t)((kN - 100) * drand48());
@@ -279,11 +253,12 @@ void TestQuadSolve(const float *__restrict__ a, const float *__restrict__ b, con
     printf("%d: a = % 8.3f, b = % 8.3f, c = % 8.3f, roots = %d, x1 = % 8.3f, x2 = % 8.3f\n", i, a[i], b[i], c[i],
            roots[i], roots[i] > 0 ? x1[i] : 0, roots[i] > 1 ? x2[i] : 0);
 #endif
-  printf("%20s %8.1lf %7.1lf\n", name, mean, sigma);
 }
 
 int main(int argc, char *argv[])
 {
+  bench::Harness harness(argc, argv, "quadratic", {"Backend"}, "equation");
+
   float *a, *b, *c, *x1, *x2;
   int *roots;
 
@@ -305,39 +280,38 @@ int main(int argc, char *argv[])
     roots[i] = 0;
   }
 
-  printf("             Backend     Mean / Sigma (ms)\n");
-  printf("------------------------------------------\n");
-
-  TestQuadSolve(a, b, c, x1, x2, roots, kN);
-  TestQuadSolveOptimized(a, b, c, x1, x2, roots, kN);
+  TestQuadSolve(harness, a, b, c, x1, x2, roots, kN);
+  TestQuadSolveOptimized(harness, a, b, c, x1, x2, roots, kN);
 
 #ifdef __AVX2__
-  TestQuadSolveAVX2(a, b, c, x1, x2, roots, kN);
+  TestQuadSolveAVX2(harness, a, b, c, x1, x2, roots, kN);
 #endif
 
-  TestQuadSolve<backend::Scalar>(a, b, c, x1, x2, roots, kN, "Scalar Backend");
-  TestQuadSolve<backend::ScalarWrapper>(a, b, c, x1, x2, roots, kN, "ScalarWrapper");
+  TestQuadSolve<backend::Scalar>(harness, a, b, c, x1, x2, roots, kN, "Scalar Backend");
+  TestQuadSolve<backend::ScalarWrapper>(harness, a, b, c, x1, x2, roots, kN, "ScalarWrapper");
 
 #ifdef VECCORE_ENABLE_VC
-  TestQuadSolve<backend::VcScalar>(a, b, c, x1, x2, roots, kN, "VcScalar");
-  TestQuadSolve<backend::VcVector>(a, b, c, x1, x2, roots, kN, "VcVector");
-  TestQuadSolve<backend::VcSimdArray<8>>(a, b, c, x1, x2, roots, kN, "VcSimdArray<8>");
-  TestQuadSolve<backend::VcSimdArray<16>>(a, b, c, x1, x2, roots, kN, "VcSimdArray<16>");
-  TestQuadSolve<backend::VcSimdArray<32>>(a, b, c, x1, x2, roots, kN, "VcSimdArray<32>");
+  TestQuadSolve<backend::VcScalar>(harness, a, b, c, x1, x2, roots, kN, "VcScalar");
+  TestQuadSolve<backend::VcVector>(harness, a, b, c, x1, x2, roots, kN, "VcVector");
+  TestQuadSolve<backend::VcVector, true>(harness, a, b, c, x1, x2, roots, kN, "VcVector (NT)");
+  TestQuadSolve<backend::VcSimdArray<8>>(harness, a, b, c, x1, x2, roots, kN, "VcSimdArray<8>");
+  TestQuadSolve<backend::VcSimdArray<16>>(harness, a, b, c, x1, x2, roots, kN, "VcSimdArray<16>");
+  TestQuadSolve<backend::VcSimdArray<32>>(harness, a, b, c, x1, x2, roots, kN, "VcSimdArray<32>");
 #endif
 
 #ifdef VECCORE_ENABLE_UMESIMD
-  TestQuadSolve<backend::UMESimd>(a, b, c, x1, x2, roots, kN, "UME::SIMD");
-  TestQuadSolve<backend::UMESimdArray<8>>(a, b, c, x1, x2, roots, kN, "UME::SIMD<8>");
-  TestQuadSolve<backend::UMESimdArray<16>>(a, b, c, x1, x2, roots, kN, "UME::SIMD<16>");
-  TestQuadSolve<backend::UMESimdArray<32>>(a, b, c, x1, x2, roots, kN, "UME::SIMD<32>");
+  TestQuadSolve<backend::UMESimd>(harness, a, b, c, x1, x2, roots, kN, "UME::SIMD");
+  TestQuadSolve<backend::UMESimdArray<8>>(harness, a, b, c, x1, x2, roots, kN, "UME::SIMD<8>");
+  TestQuadSolve<backend::UMESimdArray<16>>(harness, a, b, c, x1, x2, roots, kN, "UME::SIMD<16>");
+  TestQuadSolve<backend::UMESimdArray<32>>(harness, a, b, c, x1, x2, roots, kN, "UME::SIMD<32>");
 #endif
 
 #ifdef VECCORE_ENABLE_AGNER
-  TestQuadSolve<backend::AgnerAVX>(a, b, c, x1, x2, roots, kN, "AgnerAVX");
-  TestQuadSolve<backend::AgnerAVX512>(a, b, c, x1, x2, roots, kN, "AgnerAVX512");
+  TestQuadSolve<backend::AgnerAVX>(harness, a, b, c, x1, x2, roots, kN, "AgnerAVX");
+  TestQuadSolve<backend::AgnerAVX512>(harness, a, b, c, x1, x2, roots, kN, "AgnerAVX512");
+  TestQuadSolve<backend::AgnerAVX, true>(harness, a, b, c, x1, x2, roots, kN, "AgnerAVX (NT)");
+  TestQuadSolve<backend::AgnerAVX512, true>(harness, a, b, c, x1, x2, roots, kN, "AgnerAVX512 (NT)");
 #endif
-  printf("------------------------------------------\n");
 
   AlignedFree(a);
   AlignedFree(b);
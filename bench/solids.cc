@@ -0,0 +1,144 @@
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+
+#include "harness.h"
+
+using namespace vecCore;
+using namespace vecCore::geometry;
+
+static constexpr size_t kN = (1024 * 1024);
+
+// rays in structure of arrays layout, with origins uniformly distributed in
+// [-2, 2]^3 around solids of size ~1, and isotropic directions
+
+template <typename S>
+struct Rays {
+  S *x, *y, *z;
+  S *dx, *dy, *dz;
+  S *dist;
+};
+
+// function objects for each of the kernels being timed
+
+struct DistanceToInKernel {
+  static const char *Name() { return "DistanceToIn"; }
+
+  template <typename T, class Shape>
+  T operator()(const Shape &shape, const Vector3D<T> &p, const Vector3D<T> &d) const
+  {
+    return shape.DistanceToIn(p, d);
+  }
+};
+
+struct DistanceToOutKernel {
+  static const char *Name() { return "DistanceToOut"; }
+
+  template <typename T, class Shape>
+  T operator()(const Shape &shape, const Vector3D<T> &p, const Vector3D<T> &d) const
+  {
+    return shape.DistanceToOut(p, d);
+  }
+};
+
+struct SafetyToInKernel {
+  static const char *Name() { return "SafetyToIn"; }
+
+  template <typename T, class Shape>
+  T operator()(const Shape &shape, const Vector3D<T> &p, const Vector3D<T> &) const
+  {
+    return shape.SafetyToIn(p);
+  }
+};
+
+template <class T, class Kernel, class Shape>
+void TestKernel(bench::Harness &harness, const Shape &shape, const char *shapename, Rays<Scalar<T>> &rays,
+                const char *name)
+{
+  Kernel kernel;
+  harness.Run({shapename, Kernel::Name(), name}, kN, [&] {
+    for (size_t i = 0; i < kN; i += VectorSize<T>()) {
+      Vector3D<T> p, d;
+      Load(p.X(), &rays.x[i]);
+      Load(p.Y(), &rays.y[i]);
+      Load(p.Z(), &rays.z[i]);
+      Load(d.X(), &rays.dx[i]);
+      Load(d.Y(), &rays.dy[i]);
+      Load(d.Z(), &rays.dz[i]);
+      Store(kernel(shape, p, d), &rays.dist[i]);
+    }
+  });
+}
+
+template <typename S, class Kernel, class Shape>
+struct TestBackends {
+  bench::Harness &harness;
+  const Shape &shape;
+  const char *shapename;
+  Rays<S> &rays;
+
+  template <class B>
+  void operator()(bench::BackendTag<B>, const char *name) const
+  {
+    TestKernel<bench::FloatVector<B, S>, Kernel>(harness, shape, shapename, rays, name);
+  }
+};
+
+template <typename S, class Shape>
+void TestShape(bench::Harness &harness, const Shape &shape, const char *shapename, Rays<S> &rays)
+{
+  bench::ForEachBackend(TestBackends<S, DistanceToInKernel, Shape>{harness, shape, shapename, rays});
+  bench::ForEachBackend(TestBackends<S, DistanceToOutKernel, Shape>{harness, shape, shapename, rays});
+  bench::ForEachBackend(TestBackends<S, SafetyToInKernel, Shape>{harness, shape, shapename, rays});
+}
+
+template <typename S>
+void Benchmark(bench::Harness &harness, const char *type)
+{
+  Rays<S> rays;
+  S **arrays[] = {&rays.x, &rays.y, &rays.z, &rays.dx, &rays.dy, &rays.dz, &rays.dist};
+
+  for (S **a : arrays)
+    *a = (S *)AlignedAlloc(VECCORE_SIMD_ALIGN, kN * sizeof(S));
+
+  for (size_t i = 0; i < kN; i++) {
+    rays.x[i] = 4.0 * drand48() - 2.0;
+    rays.y[i] = 4.0 * drand48() - 2.0;
+    rays.z[i] = 4.0 * drand48() - 2.0;
+
+    double dx, dy, dz, r2;
+    do {
+      dx = 2.0 * drand48() - 1.0;
+      dy = 2.0 * drand48() - 1.0;
+      dz = 2.0 * drand48() - 1.0;
+      r2 = dx * dx + dy * dy + dz * dz;
+    } while (r2 > 1.0 || r2 < 1.0e-4);
+
+    double r   = std::sqrt(r2);
+    rays.dx[i] = dx / r;
+    rays.dy[i] = dy / r;
+    rays.dz[i] = dz / r;
+  }
+
+  harness.Section(type);
+
+  TestShape(harness, Box(1.0, 0.5, 0.75), "Box", rays);
+  TestShape(harness, Sphere(1.25), "Sphere", rays);
+  TestShape(harness, Tube(0.5, 1.25, 1.0), "Tube", rays);
+  TestShape(harness, Cone(0.5, 1.25, 1.0), "Cone", rays);
+
+  for (S **a : arrays)
+    AlignedFree(*a);
+}
+
+int main(int argc, char *argv[])
+{
+  bench::Harness harness(argc, argv, "solids", {"Shape", "Kernel", "Backend"}, "ray");
+
+  srand48(time(NULL));
+
+  Benchmark<Float_s>(harness, "Single Precision");
+  Benchmark<Double_s>(harness, "Double Precision");
+
+  return 0;
+}
@@ -0,0 +1,118 @@
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+
+#include "harness.h"
+
+using namespace vecCore;
+
+static constexpr size_t kN = (1024 * 1024);
+
+// function objects with the range of arguments used for each function
+
+#define SPECIAL_FUNCTION(F, a, b)                                \
+  struct F##Function {                                           \
+    static const char *Name() { return #F; }                     \
+    static double Lower() { return a; }                          \
+    static double Upper() { return b; }                          \
+                                                                 \
+    template <typename T>                                        \
+    T operator()(const T &x) const                               \
+    {                                                            \
+      return math::F(x);                                         \
+    }                                                            \
+  };
+
+SPECIAL_FUNCTION(Erf, -6.0, 6.0)
+SPECIAL_FUNCTION(Erfc, -3.0, 9.0)
+SPECIAL_FUNCTION(LGamma, -10.0, 100.0)
+SPECIAL_FUNCTION(TGamma, -10.0, 30.0)
+SPECIAL_FUNCTION(BesselI0, -50.0, 50.0)
+SPECIAL_FUNCTION(BesselI1, -50.0, 50.0)
+
+#undef SPECIAL_FUNCTION
+
+// reference timings for the scalar functions from the standard library
+
+template <typename S>
+void TestLibm(bench::Harness &harness, const S *__restrict__ x, S *__restrict__ y, const char *func, S (*f)(S))
+{
+  harness.Run({func, "libm"}, kN, [&] {
+    for (size_t i = 0; i < kN; i++)
+      y[i] = f(x[i]);
+  });
+}
+
+template <typename S, class Function>
+struct TestFunction {
+  bench::Harness &harness;
+  const S *x;
+  S *y;
+
+  template <class B>
+  void operator()(bench::BackendTag<B>, const char *name) const
+  {
+    using T = bench::FloatVector<B, S>;
+
+    Function f;
+    const S *__restrict__ in = x;
+    S *__restrict__ out      = y;
+
+    harness.Run({Function::Name(), name}, kN, [&] {
+      for (size_t i = 0; i < kN; i += VectorSize<T>()) {
+        T v;
+        Load(v, &in[i]);
+        Store(f(v), &out[i]);
+      }
+    });
+  }
+};
+
+template <typename S, class Function>
+void TestBackends(bench::Harness &harness, S *x, S *y)
+{
+  for (size_t i = 0; i < kN; i++)
+    x[i] = Function::Lower() + (Function::Upper() - Function::Lower()) * drand48();
+
+  bench::ForEachBackend(TestFunction<S, Function>{harness, x, y});
+}
+
+template <typename S>
+void Benchmark(bench::Harness &harness, const char *type)
+{
+  S *x = (S *)AlignedAlloc(VECCORE_SIMD_ALIGN, kN * sizeof(S));
+  S *y = (S *)AlignedAlloc(VECCORE_SIMD_ALIGN, kN * sizeof(S));
+
+  harness.Section(type);
+
+  TestBackends<S, ErfFunction>(harness, x, y);
+  TestLibm<S>(harness, x, y, "Erf", std::erf);
+
+  TestBackends<S, ErfcFunction>(harness, x, y);
+  TestLibm<S>(harness, x, y, "Erfc", std::erfc);
+
+  TestBackends<S, LGammaFunction>(harness, x, y);
+  TestLibm<S>(harness, x, y, "LGamma", std::lgamma);
+
+  TestBackends<S, TGammaFunction>(harness, x, y);
+  TestLibm<S>(harness, x, y, "TGamma", std::tgamma);
+
+  // no modified Bessel functions in the C++11 standard library
+  TestBackends<S, BesselI0Function>(harness, x, y);
+  TestBackends<S, BesselI1Function>(harness, x, y);
+
+  AlignedFree(x);
+  AlignedFree(y);
+}
+
+int main(int argc, char *argv[])
+{
+  bench::Harness harness(argc, argv, "specfunc", {"Function", "Backend"}, "element");
+
+  srand48(time(NULL));
+
+  Benchmark<Float_s>(harness, "Single Precision");
+  Benchmark<Double_s>(harness, "Double Precision");
+
+  return 0;
+}
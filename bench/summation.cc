@@ -0,0 +1,117 @@
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <type_traits>
+
+#include "harness.h"
+
+using namespace vecCore;
+
+static constexpr size_t kN = (1024 * 1024);
+
+// plain vectorized sum, whose result depends on the vector size
+
+template <class T>
+VECCORE_FORCE_NOINLINE
+double Naive(const Scalar<T> *x, size_t n)
+{
+  T sum(Scalar<T>(0)), v(Scalar<T>(0));
+  size_t i = 0, m = n - n % VectorSize<T>();
+  for (; i < m; i += VectorSize<T>()) {
+    Load(v, &x[i]);
+    sum += v;
+  }
+
+  Scalar<T> result = ReduceAdd(sum);
+  for (; i < n; ++i)
+    result += x[i];
+  return result;
+}
+
+template <class T>
+VECCORE_FORCE_NOINLINE
+double Reproducible(const Scalar<T> *x, size_t n)
+{
+  return ReproducibleSum<T>(x, n);
+}
+
+template <class T>
+VECCORE_FORCE_NOINLINE
+double Kahan(const Scalar<T> *x, size_t n)
+{
+  KahanAccumulator<T> sum;
+  sum.Add(x, n);
+  return sum.Result();
+}
+
+template <class T, class W>
+VECCORE_FORCE_NOINLINE
+double Widening(const Scalar<T> *x, size_t n)
+{
+  WideningAccumulator<T, W> sum;
+  sum.Add(x, n);
+  return sum.Result();
+}
+
+// the relative error of each method is computed once and shown as a label
+
+template <class T, double (*Sum)(const Scalar<T> *, size_t)>
+void TestSum(bench::Harness &harness, const Scalar<T> *x, long double exact, const char *method, const char *name)
+{
+  char error[32];
+  snprintf(error, sizeof(error), "%.2e", double(std::abs((Sum(x, kN) - exact) / exact)));
+
+  volatile double sum(0);
+  harness.Run({method, name, error}, kN, [&] { sum = Sum(x, kN); });
+}
+
+template <typename S>
+struct TestBackends {
+  bench::Harness &harness;
+  const S *x;
+  long double exact;
+
+  template <class B>
+  void operator()(bench::BackendTag<B>, const char *name) const
+  {
+    using T = bench::FloatVector<B, S>;
+    using W = typename B::Double_v;
+
+    TestSum<T, Naive<T>>(harness, x, exact, "Naive", name);
+    TestSum<T, Kahan<T>>(harness, x, exact, "Kahan", name);
+    if (!std::is_same<T, W>::value) TestSum<T, Widening<T, W>>(harness, x, exact, "Widening", name);
+    TestSum<T, Reproducible<T>>(harness, x, exact, "Reproducible", name);
+  }
+};
+
+template <typename S>
+void Benchmark(bench::Harness &harness, const char *type)
+{
+  S *x = (S *)AlignedAlloc(VECCORE_SIMD_ALIGN, kN * sizeof(S));
+
+  // values of both signs over many orders of magnitude, so that the naive
+  // sum differs between backends
+  long double exact = 0;
+  for (size_t i = 0; i < kN; i++) {
+    x[i] = std::ldexp(S(2.0 * drand48() - 1.0), int(40 * drand48()) - 20);
+    exact += x[i];
+  }
+
+  harness.Section(type);
+
+  bench::ForEachBackend(TestBackends<S>{harness, x, exact});
+
+  AlignedFree(x);
+}
+
+int main(int argc, char *argv[])
+{
+  bench::Harness harness(argc, argv, "summation", {"Method", "Backend", "Rel. Error"}, "element");
+
+  srand48(time(NULL));
+
+  Benchmark<Float_s>(harness, "Single Precision");
+  Benchmark<Double_s>(harness, "Double Precision");
+
+  return 0;
+}
@@ -50,7 +50,9 @@ private:
     unsigned int hi, lo;
     asm volatile("cpuid\n\t"
                  "rdtsc"
-                 : "=a"(lo), "=d"(hi));
+                 : "=a"(lo), "=d"(hi)
+                 : "a"(0)
+                 : "%ebx", "%ecx");
     return ((unsigned long long)lo) | (((unsigned long long)hi) << 32);
   }
 };
@@ -0,0 +1,383 @@
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <limits>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "harness.h"
+
+using namespace vecCore;
+
+static constexpr size_t kN = (256 * 1024);
+
+// Speed and accuracy of the functions of VecMath.h on each backend.
+//
+// Each function is evaluated on kN random arguments in a representative
+// range. The error of the results is measured in units in the last place
+// (ULP) of the scalar type against a reference computed in long double, and
+// shown as maximum and mean over all arguments. Results which are NaN or
+// infinite when the reference is not, or the other way around, count as
+// infinite errors. Special values (zeros, infinities, NaN, denormals and the
+// largest finite values) are then checked against the reference, which
+// follows the C99 rules for them. A special case passes if the result is NaN,
+// an infinity or a zero of the same sign as the reference, or is otherwise
+// within kSpecialULP of it.
+//
+// Functions with integer arguments or results, such as Ldexp or Frexp, are
+// exact and not included. Neither are those that only have the generic
+// implementation calling the standard library, such as Sinh or Log2, and
+// therefore cannot be used with vectors of the SIMD backends.
+
+static constexpr double kSpecialULP = 16.0;
+
+// references for functions without one in the C++ standard library
+
+long double RSqrtReference(long double x)
+{
+  return 1.0L / std::sqrt(x);
+}
+
+long double SignReference(long double x)
+{
+  return std::copysign(1.0L, x);
+}
+
+// I_n(x) = sum (x/2)^(2k+n) / (k! (k+n)!), whose terms are all positive
+template <int n>
+long double BesselIReference(long double x)
+{
+  if (std::isnan(x) || std::isinf(x)) return n == 0 ? std::fabs(x) : x;
+
+  const long double q = 0.25L * x * x;
+  long double term = n == 0 ? 1.0L : 0.5L * x, sum = term;
+  for (int k = 1; std::fabs(term) > std::numeric_limits<long double>::epsilon() * std::fabs(sum); ++k) {
+    term *= q / (k * (k + n));
+    sum += term;
+  }
+  return sum;
+}
+
+// Calls f with the first N arguments
+template <class F, typename T>
+T Apply(const F &f, const T &x, const T &, const T &, std::integral_constant<int, 1>)
+{
+  return f(x);
+}
+
+template <class F, typename T>
+T Apply(const F &f, const T &x, const T &y, const T &, std::integral_constant<int, 2>)
+{
+  return f(x, y);
+}
+
+template <class F, typename T>
+T Apply(const F &f, const T &x, const T &y, const T &z, std::integral_constant<int, 3>)
+{
+  return f(x, y, z);
+}
+
+// function objects with the name of each function, its number of arguments,
+// the range of each argument, and the reference
+
+#define MATH_FUNCTION(F, REF, N, a, b, c, d)                                         \
+  struct F##Function {                                                               \
+    using Arity = std::integral_constant<int, N>;                                    \
+                                                                                     \
+    static const char *Name() { return #F; }                                         \
+    static double Lower(int i) { return i == 0 ? a : c; }                            \
+    static double Upper(int i) { return i == 0 ? b : d; }                            \
+                                                                                     \
+    static long double Reference(long double x, long double y, long double z)        \
+    {                                                                                \
+      return Apply(REF, x, y, z, Arity());                                           \
+    }                                                                                \
+                                                                                     \
+    template <typename T>                                                            \
+    T operator()(const T &x) const                                                   \
+    {                                                                                \
+      return math::F(x);                                                             \
+    }                                                                                \
+                                                                                     \
+    template <typename T>                                                            \
+    T operator()(const T &x, const T &y) const                                       \
+    {                                                                                \
+      return math::F(x, y);                                                          \
+    }                                                                                \
+                                                                                     \
+    template <typename T>                                                            \
+    T operator()(const T &x, const T &y, const T &z) const                           \
+    {                                                                                \
+      return math::F(x, y, z);                                                       \
+    }                                                                                \
+  };
+
+using LD = long double;
+
+#define UNARY(F, REF, a, b) MATH_FUNCTION(F, static_cast<LD (*)(LD)>(REF), 1, a, b, 0.0, 0.0)
+#define BINARY(F, REF, a, b, c, d) MATH_FUNCTION(F, static_cast<LD (*)(LD, LD)>(REF), 2, a, b, c, d)
+#define TERNARY(F, REF, a, b) MATH_FUNCTION(F, static_cast<LD (*)(LD, LD, LD)>(REF), 3, a, b, a, b)
+
+UNARY(Abs, std::fabs, -100.0, 100.0)
+UNARY(Sign, SignReference, -100.0, 100.0)
+BINARY(Min, std::fmin, -100.0, 100.0, -100.0, 100.0)
+BINARY(Max, std::fmax, -100.0, 100.0, -100.0, 100.0)
+BINARY(CopySign, std::copysign, -100.0, 100.0, -100.0, 100.0)
+TERNARY(FMA, std::fma, -10.0, 10.0)
+
+UNARY(Sin, std::sin, -100.0, 100.0)
+UNARY(Cos, std::cos, -100.0, 100.0)
+UNARY(Tan, std::tan, -100.0, 100.0)
+UNARY(ASin, std::asin, -1.0, 1.0)
+UNARY(ACos, std::acos, -1.0, 1.0)
+UNARY(ATan, std::atan, -100.0, 100.0)
+BINARY(ATan2, std::atan2, -10.0, 10.0, -10.0, 10.0)
+
+UNARY(Exp, std::exp, -80.0, 80.0)
+UNARY(Log, std::log, 1.0e-3, 1.0e3)
+
+UNARY(Sqrt, std::sqrt, 0.0, 1.0e6)
+UNARY(RSqrt, RSqrtReference, 1.0e-3, 1.0e6)
+UNARY(Cbrt, std::cbrt, -1.0e6, 1.0e6)
+BINARY(Pow, std::pow, 0.0, 10.0, -20.0, 20.0)
+
+UNARY(Ceil, std::ceil, -1.0e4, 1.0e4)
+UNARY(Floor, std::floor, -1.0e4, 1.0e4)
+UNARY(Trunc, std::trunc, -1.0e4, 1.0e4)
+BINARY(Fmod, std::fmod, -100.0, 100.0, 1.0, 10.0)
+
+UNARY(Erf, std::erf, -6.0, 6.0)
+UNARY(Erfc, std::erfc, -3.0, 9.0)
+UNARY(LGamma, std::lgamma, -10.0, 100.0)
+UNARY(TGamma, std::tgamma, -10.0, 30.0)
+UNARY(BesselI0, BesselIReference<0>, -50.0, 50.0)
+UNARY(BesselI1, BesselIReference<1>, -50.0, 50.0)
+
+#undef UNARY
+#undef BINARY
+#undef TERNARY
+#undef MATH_FUNCTION
+
+// Error of y in units in the last place of the type of y
+template <typename S>
+double ULPError(S y, long double ref)
+{
+  const double inf = std::numeric_limits<double>::infinity();
+  const S r        = S(ref);
+
+  if (std::isnan(ref) || std::isnan(y)) return std::isnan(ref) && std::isnan(y) ? 0.0 : inf;
+  if (std::isinf(r) || std::isinf(y)) return y == r ? 0.0 : inf;
+
+  int e = ref == 0 ? std::numeric_limits<S>::min_exponent - 1 : std::ilogb(ref);
+  e     = std::max(e, std::numeric_limits<S>::min_exponent - 1);
+
+  return double(std::fabs(y - ref) / std::ldexp(1.0L, e - (std::numeric_limits<S>::digits - 1)));
+}
+
+template <typename S>
+bool SpecialPass(S y, long double ref)
+{
+  const S r = S(ref);
+
+  if (std::isnan(ref)) return std::isnan(y);
+  if (std::isinf(r) || r == S(0)) return y == r && std::signbit(y) == std::signbit(r);
+  return ULPError(y, ref) <= kSpecialULP;
+}
+
+// Evaluates f on n arguments, n a multiple of the vector size
+template <typename T, class Function>
+VECCORE_FORCE_INLINE
+void Evaluate(const Scalar<T> *x, const Scalar<T> *y, const Scalar<T> *z, Scalar<T> *out, size_t n)
+{
+  Function f;
+  for (size_t i = 0; i < n; i += VectorSize<T>()) {
+    T vx(Scalar<T>(0)), vy(Scalar<T>(0)), vz(Scalar<T>(0));
+    Load(vx, &x[i]);
+    if (Function::Arity::value > 1) Load(vy, &y[i]);
+    if (Function::Arity::value > 2) Load(vz, &z[i]);
+    Store(Apply(f, vx, vy, vz, typename Function::Arity()), &out[i]);
+  }
+}
+
+template <typename S>
+using Array = std::vector<S, AlignedAllocator<S>>;
+
+// arguments and reference results of one function
+template <typename S>
+struct Inputs {
+  Array<S> x, y, z;
+  std::vector<long double> ref;
+
+  // special cases, padded with ones to a multiple of any vector size
+  Array<S> sx, sy, sz;
+  std::vector<long double> sref;
+  size_t nspecial;
+};
+
+template <typename S, class Function>
+void MakeInputs(Inputs<S> &in)
+{
+  Array<S> *args[] = {&in.x, &in.y, &in.z};
+
+  for (int k = 0; k < 3; ++k) {
+    args[k]->resize(kN);
+    for (size_t i = 0; i < kN; i++)
+      (*args[k])[i] = S(Function::Lower(k) + (Function::Upper(k) - Function::Lower(k)) * drand48());
+  }
+
+  in.ref.resize(kN);
+  for (size_t i = 0; i < kN; i++)
+    in.ref[i] = Function::Reference(in.x[i], in.y[i], in.z[i]);
+
+  using L = std::numeric_limits<S>;
+  const S special[] = {S(0),     S(-0.0),     L::infinity(), -L::infinity(), L::quiet_NaN(), L::denorm_min(),
+                       -L::denorm_min(), S(1), S(-1),        L::max(),       L::lowest()};
+
+  in.sx.clear();
+  in.sy.clear();
+  in.sz.clear();
+
+  // every special value in each argument, and all pairs of them for
+  // functions of two arguments, with the other arguments set to 1.5
+  for (S a : special) {
+    for (int k = 0; k < Function::Arity::value; ++k) {
+      in.sx.push_back(k == 0 ? a : S(1.5));
+      in.sy.push_back(k == 1 ? a : S(1.5));
+      in.sz.push_back(k == 2 ? a : S(1.5));
+    }
+    if (Function::Arity::value == 2) {
+      for (S b : special) {
+        in.sx.push_back(a);
+        in.sy.push_back(b);
+        in.sz.push_back(S(1.5));
+      }
+    }
+  }
+
+  in.nspecial = in.sx.size();
+  in.sref.resize(in.nspecial);
+  for (size_t i = 0; i < in.nspecial; i++)
+    in.sref[i] = Function::Reference(in.sx[i], in.sy[i], in.sz[i]);
+
+  while (in.sx.size() % 64) {
+    in.sx.push_back(S(1));
+    in.sy.push_back(S(1));
+    in.sz.push_back(S(1));
+  }
+}
+
+template <typename S, class Function>
+struct TestFunction {
+  bench::Harness &harness;
+  const Inputs<S> &in;
+  Array<S> &out;
+
+  template <class B>
+  void operator()(bench::BackendTag<B>, const char *name) const
+  {
+    using T = bench::FloatVector<B, S>;
+
+    // accuracy over the random arguments
+    Evaluate<T, Function>(in.x.data(), in.y.data(), in.z.data(), out.data(), kN);
+
+    double max = 0.0, mean = 0.0;
+    size_t finite = 0;
+    for (size_t i = 0; i < kN; i++) {
+      double e = ULPError(out[i], in.ref[i]);
+      max      = std::max(max, e);
+      if (std::isfinite(e)) {
+        mean += e;
+        ++finite;
+      }
+    }
+    mean = finite ? mean / finite : 0.0;
+
+    // special values
+    Array<S> sout(in.sx.size());
+    Evaluate<T, Function>(in.sx.data(), in.sy.data(), in.sz.data(), sout.data(), in.sx.size());
+
+    size_t passed = 0;
+    for (size_t i = 0; i < in.nspecial; i++)
+      passed += SpecialPass(sout[i], in.sref[i]);
+
+    char smax[32], smean[32], sspecial[32];
+    snprintf(smax, sizeof(smax), "%.3g", max);
+    snprintf(smean, sizeof(smean), "%.3g", mean);
+    snprintf(sspecial, sizeof(sspecial), "%zu/%zu", passed, in.nspecial);
+
+    const S *__restrict__ x = in.x.data();
+    const S *__restrict__ y = in.y.data();
+    const S *__restrict__ z = in.z.data();
+    S *__restrict__ result  = out.data();
+
+    harness.Run({Function::Name(), name, smax, smean, sspecial}, kN,
+                [&] { Evaluate<T, Function>(x, y, z, result, kN); });
+  }
+};
+
+template <typename S, class Function>
+void TestBackends(bench::Harness &harness)
+{
+  Inputs<S> in;
+  Array<S> out(kN);
+
+  MakeInputs<S, Function>(in);
+
+  bench::ForEachBackend(TestFunction<S, Function>{harness, in, out});
+}
+
+template <typename S>
+void Benchmark(bench::Harness &harness, const char *type)
+{
+  harness.Section(type);
+
+  TestBackends<S, AbsFunction>(harness);
+  TestBackends<S, SignFunction>(harness);
+  TestBackends<S, MinFunction>(harness);
+  TestBackends<S, MaxFunction>(harness);
+  TestBackends<S, CopySignFunction>(harness);
+  TestBackends<S, FMAFunction>(harness);
+
+  TestBackends<S, SinFunction>(harness);
+  TestBackends<S, CosFunction>(harness);
+  TestBackends<S, TanFunction>(harness);
+  TestBackends<S, ASinFunction>(harness);
+  TestBackends<S, ACosFunction>(harness);
+  TestBackends<S, ATanFunction>(harness);
+  TestBackends<S, ATan2Function>(harness);
+
+  TestBackends<S, ExpFunction>(harness);
+  TestBackends<S, LogFunction>(harness);
+
+  TestBackends<S, SqrtFunction>(harness);
+  TestBackends<S, RSqrtFunction>(harness);
+  TestBackends<S, CbrtFunction>(harness);
+  TestBackends<S, PowFunction>(harness);
+
+  TestBackends<S, CeilFunction>(harness);
+  TestBackends<S, FloorFunction>(harness);
+  TestBackends<S, TruncFunction>(harness);
+  TestBackends<S, FmodFunction>(harness);
+
+  TestBackends<S, ErfFunction>(harness);
+  TestBackends<S, ErfcFunction>(harness);
+  TestBackends<S, LGammaFunction>(harness);
+  TestBackends<S, TGammaFunction>(harness);
+  TestBackends<S, BesselI0Function>(harness);
+  TestBackends<S, BesselI1Function>(harness);
+}
+
+int main(int argc, char *argv[])
+{
+  bench::Harness harness(argc, argv, "vecmath", {"Function", "Backend", "Max ULP", "Mean ULP", "Special"},
+                         "element");
+
+  // fixed seed, so that the errors are the same from run to run
+  srand48(42);
+
+  Benchmark<Float_s>(harness, "Single Precision");
+  Benchmark<Double_s>(harness, "Double Precision");
+
+  return 0;
+}
@@ -0,0 +1,294 @@
+#ifndef VECCORE_AOSOA_H
+#define VECCORE_AOSOA_H
+
+#include "Backend/Interface.h"
+#include "Backend/Implementation.h"
+#include "Utilities.h"
+
+#include <tuple>
+#include <type_traits>
+#include <vector>
+
+namespace vecCore {
+
+namespace detail {
+template <typename... T>
+struct SameVectorSize;
+
+template <typename T>
+struct SameVectorSize<T> : std::true_type {
+};
+
+template <typename T, typename U, typename... Rest>
+struct SameVectorSize<T, U, Rest...>
+    : std::integral_constant<bool, VectorSize<T>() == VectorSize<U>() && SameVectorSize<U, Rest...>::value> {
+};
+
+template <typename... T>
+struct MaxVectorSize;
+
+template <typename T>
+struct MaxVectorSize<T> : std::integral_constant<size_t, VectorSize<T>()> {
+};
+
+template <typename T, typename U, typename... Rest>
+struct MaxVectorSize<T, U, Rest...>
+    : std::integral_constant<size_t, (VectorSize<T>() > MaxVectorSize<U, Rest...>::value
+                                          ? VectorSize<T>()
+                                          : MaxVectorSize<U, Rest...>::value)> {
+};
+
+// Whether blocks of N scalars of each field can be accessed as whole vectors
+template <size_t N, typename... T>
+struct FitsBlock;
+
+template <size_t N>
+struct FitsBlock<N> : std::true_type {
+};
+
+template <size_t N, typename T, typename... Rest>
+struct FitsBlock<N, T, Rest...>
+    : std::integral_constant<bool, N % VectorSize<T>() == 0 && sizeof(T) == VectorSize<T>() * sizeof(Scalar<T>) &&
+                                       FitsBlock<N, Rest...>::value> {
+};
+
+// Storage of a block of an AoSoA, with an array of N scalars per field, in
+// the order of the fields, each aligned as a vector of its field
+template <size_t N, typename... T>
+struct AoSoAArrays;
+
+template <size_t N, typename T>
+struct AoSoAArrays<N, T> {
+  alignas(T) Scalar<T> fData[N];
+};
+
+template <size_t N, typename T, typename U, typename... Rest>
+struct AoSoAArrays<N, T, U, Rest...> {
+  alignas(T) Scalar<T> fData[N];
+  AoSoAArrays<N, U, Rest...> fRest;
+};
+
+// Array of field I of a block
+template <size_t I>
+struct AoSoAData {
+  template <class A>
+  static auto Get(A &a) -> decltype(AoSoAData<I - 1>::Get(a.fRest))
+  {
+    return AoSoAData<I - 1>::Get(a.fRest);
+  }
+};
+
+template <>
+struct AoSoAData<0> {
+  template <class A>
+  static auto Get(A &a) -> decltype(&a.fData[0])
+  {
+    return a.fData;
+  }
+};
+}
+
+// Array of structures of arrays.
+//
+// Elements with one field of each of the vector types Fields... are stored in
+// blocks of BlockSize() elements, the largest number of lanes of the fields.
+// A block holds an aligned array of BlockSize() scalars per field, which is
+// one vector of the widest fields and several vectors of the narrower ones,
+// e.g. two Double_v per Float_v with AVX. A kernel can then load a whole block
+// of a field with aligned vector accesses, as in a structure of arrays, while
+// all fields of an element are close together in memory, as in an array of
+// structures:
+//
+//   AoSoA<Float_v, Float_v, Double_v> tracks(n); // x, y, time
+//
+//   for (auto &block : tracks) {
+//     block.Field<0>() += dx;
+//     for (size_t j = 0; j < tracks.GetNvectors<2>(); ++j)
+//       block.Field<2>(j) += dt;
+//   }
+//
+// The last block is padded with zeros when the size is not a multiple of
+// BlockSize(), so kernels may process whole blocks and only the valid
+// elements are accessed by index.
+
+template <typename... Fields>
+class AoSoA {
+  static_assert(sizeof...(Fields) > 0, "AoSoA needs at least one field");
+  static_assert(detail::FitsBlock<detail::MaxVectorSize<Fields...>::value, Fields...>::value,
+                "vector sizes of the fields of an AoSoA must divide the block size");
+
+public:
+  template <size_t I>
+  using Field_t = typename std::tuple_element<I, std::tuple<Fields...>>::type;
+
+  template <size_t I>
+  using FieldScalar_t = Scalar<Field_t<I>>;
+
+  static constexpr size_t kFields = sizeof...(Fields);
+
+  static constexpr size_t BlockSize() { return detail::MaxVectorSize<Fields...>::value; }
+
+  // Number of vectors of field I in a block
+  template <size_t I>
+  static constexpr size_t GetNvectors()
+  {
+    return BlockSize() / VectorSize<Field_t<I>>();
+  }
+
+  class Block_t {
+  public:
+    // Array of field I, aligned to the vector size
+    template <size_t I>
+    FieldScalar_t<I> *Data()
+    {
+      return detail::AoSoAData<I>::Get(fArrays);
+    }
+
+    template <size_t I>
+    const FieldScalar_t<I> *Data() const
+    {
+      return detail::AoSoAData<I>::Get(fArrays);
+    }
+
+    // Vector j of field I
+    template <size_t I>
+    Field_t<I> &Field(size_t j = 0)
+    {
+      return reinterpret_cast<Field_t<I> *>(Data<I>())[j];
+    }
+
+    template <size_t I>
+    const Field_t<I> &Field(size_t j = 0) const
+    {
+      return reinterpret_cast<const Field_t<I> *>(Data<I>())[j];
+    }
+
+  private:
+    detail::AoSoAArrays<detail::MaxVectorSize<Fields...>::value, Fields...> fArrays;
+  };
+
+  // Scalar view of the element with index i
+  template <class Container>
+  class Element {
+  public:
+    Element(Container &c, size_t i) : fContainer(c), fIndex(i) {}
+
+    template <size_t I>
+    FieldScalar_t<I> Get() const
+    {
+      return fContainer.GetBlock(fIndex / BlockSize()).template Data<I>()[fIndex % BlockSize()];
+    }
+
+    template <size_t I>
+    void Set(FieldScalar_t<I> x) const
+    {
+      fContainer.GetBlock(fIndex / BlockSize()).template Data<I>()[fIndex % BlockSize()] = x;
+    }
+
+  private:
+    Container &fContainer;
+    size_t fIndex;
+  };
+
+  AoSoA() : fSize(0) {}
+
+  explicit AoSoA(size_t n) : fSize(0) { Resize(n); }
+
+  size_t Size() const { return fSize; }
+
+  size_t GetNblocks() const { return fBlocks.size(); }
+
+  void Resize(size_t n)
+  {
+    fBlocks.resize((n + BlockSize() - 1) / BlockSize(), Block_t());
+
+    // clear lanes past the end, so that they are zero after growing again
+    for (size_t i = n; i < fBlocks.size() * BlockSize(); ++i)
+      Clear(i, std::integral_constant<size_t, 0>());
+
+    fSize = n;
+  }
+
+  void Clear()
+  {
+    fBlocks.clear();
+    fSize = 0;
+  }
+
+  Block_t &GetBlock(size_t b) { return fBlocks[b]; }
+  const Block_t &GetBlock(size_t b) const { return fBlocks[b]; }
+
+  // Vector j of field I in block b
+  template <size_t I>
+  Field_t<I> &Field(size_t b, size_t j = 0)
+  {
+    return fBlocks[b].template Field<I>(j);
+  }
+
+  template <size_t I>
+  const Field_t<I> &Field(size_t b, size_t j = 0) const
+  {
+    return fBlocks[b].template Field<I>(j);
+  }
+
+  Element<AoSoA> operator[](size_t i) { return Element<AoSoA>(*this, i); }
+  Element<const AoSoA> operator[](size_t i) const { return Element<const AoSoA>(*this, i); }
+
+  // Number of valid elements in block b
+  size_t GetBlockCount(size_t b) const
+  {
+    return b + 1 < fBlocks.size() ? BlockSize() : fSize - b * BlockSize();
+  }
+
+  // Iteration over blocks
+  Block_t *begin() { return fBlocks.data(); }
+  Block_t *end() { return fBlocks.data() + fBlocks.size(); }
+  const Block_t *begin() const { return fBlocks.data(); }
+  const Block_t *end() const { return fBlocks.data() + fBlocks.size(); }
+
+  // Calls f(block, count) for each block, with the number of valid elements
+  template <class F>
+  void ForEachBlock(F f)
+  {
+    for (size_t b = 0; b < fBlocks.size(); ++b)
+      f(fBlocks[b], GetBlockCount(b));
+  }
+
+  template <class F>
+  void ForEachBlock(F f) const
+  {
+    for (size_t b = 0; b < fBlocks.size(); ++b)
+      f(fBlocks[b], GetBlockCount(b));
+  }
+
+  // Calls f(element) for each valid element
+  template <class F>
+  void ForEach(F f)
+  {
+    for (size_t i = 0; i < fSize; ++i)
+      f((*this)[i]);
+  }
+
+  template <class F>
+  void ForEach(F f) const
+  {
+    for (size_t i = 0; i < fSize; ++i)
+      f((*this)[i]);
+  }
+
+private:
+  template <size_t I>
+  void Clear(size_t i, std::integral_constant<size_t, I>)
+  {
+    (*this)[i].template Set<I>(FieldScalar_t<I>(0));
+    Clear(i, std::integral_constant<size_t, I + 1>());
+  }
+
+  void Clear(size_t, std::integral_constant<size_t, kFields>) {}
+
+  std::vector<Block_t, AlignedAllocator<Block_t, alignof(Block_t)>> fBlocks;
+  size_t fSize;
+};
+}
+
+#endif
@@ -0,0 +1,297 @@
+#ifndef VECCORE_ARENA_H
+#define VECCORE_ARENA_H
+
+#include "Utilities.h"
+
+#include <atomic>
+#include <limits>
+#include <mutex>
+#include <new>
+
+#if defined(__linux__)
+#include <sys/mman.h>
+#endif
+
+namespace vecCore {
+
+namespace detail {
+constexpr size_t ArenaLog2(size_t n)
+{
+  return n > 1 ? 1 + ArenaLog2(n / 2) : 0;
+}
+}
+
+// Pool of aligned memory blocks for short lived buffers, such as scratch
+// space which is allocated and released again for every event.
+//
+// Requests are rounded up to a power of two between kMinBlock and kMaxBlock,
+// and blocks of each size are kept in free lists, one per thread, so that most
+// calls touch neither a lock nor the system allocator. Blocks move between the
+// per-thread lists and a shared one in batches, so memory released by one
+// thread can be reused by the others. The shared list is refilled from chunks
+// of the size of a huge page, which the kernel is asked to back by huge pages
+// after SetHugePages(true), to reduce TLB misses. Memory is kept by the arena
+// for reuse and never returned to the system. Larger requests go directly to
+// AlignedAlloc().
+//
+// Blocks are released with the size they were allocated with, as with
+// standard allocators, and may be released by any thread.
+
+class Arena {
+public:
+  static constexpr size_t kAlign     = VECCORE_SIMD_ALIGN > 64 ? VECCORE_SIMD_ALIGN : 64;
+  static constexpr size_t kChunkSize = size_t(2) << 20;
+  static constexpr size_t kMinBlock  = kAlign;
+  static constexpr size_t kMaxBlock  = kChunkSize / 8;
+  static constexpr size_t kClasses   = detail::ArenaLog2(kMaxBlock / kMinBlock) + 1;
+
+  // The arena is never destroyed, as the caches of threads still running at
+  // exit release their blocks to it.
+  static Arena &Instance()
+  {
+    static Arena *arena = new Arena();
+    return *arena;
+  }
+
+  Arena(const Arena &) = delete;
+  Arena &operator=(const Arena &) = delete;
+
+  void *Allocate(size_t size)
+  {
+    if (size > kMaxBlock) return AllocateLarge(size);
+
+    const size_t c = SizeClass(size);
+    FreeList &list = Cache().fLists[c];
+
+    if (!list.fHead) Refill(c, list);
+
+    Block *block = list.fHead;
+    list.fHead   = block->fNext;
+    --list.fCount;
+    return block;
+  }
+
+  void Deallocate(void *ptr, size_t size)
+  {
+    if (!ptr) return;
+
+    if (size > kMaxBlock) {
+      AlignedFree(ptr);
+      return;
+    }
+
+    const size_t c = SizeClass(size);
+    FreeList &list = Cache().fLists[c];
+
+    Block *block  = static_cast<Block *>(ptr);
+    block->fNext  = list.fHead;
+    list.fHead    = block;
+
+    if (++list.fCount > 2 * BatchSize(c)) Release(c, list, BatchSize(c));
+  }
+
+  // Applies to chunks reserved after the call
+  void SetHugePages(bool enable) { fHugePages = enable; }
+
+  bool GetHugePages() const { return fHugePages; }
+
+  // Memory reserved for blocks up to kMaxBlock, in bytes
+  size_t GetReserved() const { return fReserved; }
+
+private:
+  struct Block {
+    Block *fNext;
+  };
+
+  struct FreeList {
+    Block *fHead  = nullptr;
+    size_t fCount = 0;
+  };
+
+  struct ThreadCache {
+    FreeList fLists[kClasses];
+
+    ~ThreadCache()
+    {
+      for (size_t c = 0; c < kClasses; ++c)
+        Instance().Release(c, fLists[c], fLists[c].fCount);
+    }
+  };
+
+  Arena() : fCurrent(nullptr), fEnd(nullptr), fHugePages(false), fReserved(0) {}
+
+  static ThreadCache &Cache()
+  {
+    static thread_local ThreadCache cache;
+    return cache;
+  }
+
+  static size_t SizeClass(size_t size)
+  {
+    size_t c = 0;
+    while ((kMinBlock << c) < size)
+      ++c;
+    return c;
+  }
+
+  static size_t BlockSize(size_t c) { return kMinBlock << c; }
+
+  // number of blocks moved between a thread cache and the shared lists at once
+  static size_t BatchSize(size_t c)
+  {
+    const size_t n = (size_t(64) << 10) / BlockSize(c);
+    return n < 1 ? 1 : (n > 64 ? 64 : n);
+  }
+
+  static void Push(FreeList &list, void *ptr)
+  {
+    Block *block = static_cast<Block *>(ptr);
+    block->fNext = list.fHead;
+    list.fHead   = block;
+    ++list.fCount;
+  }
+
+  void Advise(void *ptr, size_t size) const
+  {
+#if defined(__linux__) && defined(MADV_HUGEPAGE)
+    if (fHugePages) madvise(ptr, size, MADV_HUGEPAGE);
+#else
+    (void)ptr;
+    (void)size;
+#endif
+  }
+
+  void *AllocateLarge(size_t size)
+  {
+    const bool huge = size >= kChunkSize;
+    void *ptr       = AlignedAlloc(huge ? size_t(kChunkSize) : size_t(kAlign), size);
+    if (!ptr) throw std::bad_alloc();
+    if (huge) Advise(ptr, size);
+    return ptr;
+  }
+
+  // Moves the first n blocks of a thread's list to the shared list
+  void Release(size_t c, FreeList &list, size_t n)
+  {
+    if (n == 0) return;
+
+    Block *first = list.fHead, *last = first;
+    for (size_t i = 1; i < n; ++i)
+      last = last->fNext;
+
+    list.fHead = last->fNext;
+    list.fCount -= n;
+
+    std::lock_guard<std::mutex> lock(fMutex);
+    last->fNext = fShared[c].fHead;
+    fShared[c].fHead = first;
+    fShared[c].fCount += n;
+  }
+
+  // Moves up to a batch of blocks to an empty thread's list, carving new
+  // blocks from the current chunk when the shared list is empty
+  void Refill(size_t c, FreeList &list)
+  {
+    const size_t n = BatchSize(c);
+
+    std::lock_guard<std::mutex> lock(fMutex);
+
+    FreeList &shared = fShared[c];
+    for (size_t i = 0; i < n && shared.fHead; ++i) {
+      Block *block = shared.fHead;
+      shared.fHead = block->fNext;
+      --shared.fCount;
+      Push(list, block);
+    }
+
+    const size_t size = BlockSize(c);
+    for (size_t i = list.fCount; i < n; ++i) {
+      if (size_t(fEnd - fCurrent) < size) {
+        if (list.fHead) break;
+        NewChunk();
+      }
+      Push(list, fCurrent);
+      fCurrent += size;
+    }
+  }
+
+  // Called with the lock held
+  void NewChunk()
+  {
+    // the rest of the current chunk is kept as smaller blocks
+    while (size_t(fEnd - fCurrent) >= kMinBlock) {
+      size_t c = detail::ArenaLog2(size_t(fEnd - fCurrent) / kMinBlock);
+      if (c >= kClasses) c = kClasses - 1;
+      Push(fShared[c], fCurrent);
+      fCurrent += BlockSize(c);
+    }
+
+    char *chunk = static_cast<char *>(AlignedAlloc(kChunkSize, kChunkSize));
+    if (!chunk) throw std::bad_alloc();
+    Advise(chunk, kChunkSize);
+
+    fCurrent = chunk;
+    fEnd     = chunk + kChunkSize;
+    fReserved += kChunkSize;
+  }
+
+  std::mutex fMutex;
+  FreeList fShared[kClasses];
+  char *fCurrent;
+  char *fEnd;
+  std::atomic<bool> fHugePages;
+  std::atomic<size_t> fReserved;
+};
+
+// Allocator for standard containers using blocks of the arena
+//
+//   std::vector<Float_v, ArenaAllocator<Float_v>> scratch(n);
+
+template <typename T>
+class ArenaAllocator {
+  static_assert(alignof(T) <= Arena::kAlign, "arena blocks are not aligned enough for the value type");
+
+public:
+  using value_type      = T;
+  using pointer         = T *;
+  using const_pointer   = const T *;
+  using reference       = T &;
+  using const_reference = const T &;
+  using size_type       = size_t;
+  using difference_type = ptrdiff_t;
+
+  template <typename U>
+  struct rebind {
+    using other = ArenaAllocator<U>;
+  };
+
+  ArenaAllocator() = default;
+
+  template <typename U>
+  ArenaAllocator(const ArenaAllocator<U> &) {}
+
+  T *allocate(size_t n)
+  {
+    if (n > max_size()) throw std::bad_alloc();
+    return static_cast<T *>(Arena::Instance().Allocate(n * sizeof(T)));
+  }
+
+  void deallocate(T *ptr, size_t n) { Arena::Instance().Deallocate(ptr, n * sizeof(T)); }
+
+  size_t max_size() const { return std::numeric_limits<size_t>::max() / sizeof(T); }
+};
+
+template <typename T, typename U>
+bool operator==(const ArenaAllocator<T> &, const ArenaAllocator<U> &)
+{
+  return true;
+}
+
+template <typename T, typename U>
+bool operator!=(const ArenaAllocator<T> &, const ArenaAllocator<U> &)
+{
+  return false;
+}
+}
+
+#endif
@@ -0,0 +1,611 @@
+#ifndef VECCORE_ARRAY_EXPRESSION_H
+#define VECCORE_ARRAY_EXPRESSION_H
+
+#include "VecMath.h"
+
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+namespace vecCore {
+
+// Lazy expressions over arrays.
+//
+// ArrayView<T> refers to an array of Scalar<T> which is processed with the
+// backend type T. Arithmetic, comparisons, Blend() and math:: functions of
+// views do not compute anything, but build an ArrayExpression<E>, a tree of
+// nodes E holding the operands. Assigning an expression to a view evaluates
+// the whole tree in one loop over vectors of type T, so that
+//
+//   ArrayView<Double_v> a(pa, n), b(pb, n), c(pc, n), d(pd, n);
+//   d = math::Sqrt(a * b + c);
+//
+// reads each input and writes the result exactly once, without any temporary
+// arrays. When the size is not a multiple of the vector size, the remaining
+// elements are computed with a last vector padded by repeating the last
+// element, and only the valid lanes are stored.
+//
+// Copying a view gives another view of the same data, whereas assigning a
+// view to another copies the elements, as for any other expression. Views in
+// the same expression must either refer to the same data or not overlap, and
+// must have the size of the view assigned to, or std::length_error is thrown.
+
+template <typename T>
+class ArrayView;
+
+template <class E>
+class ArrayExpression;
+
+namespace detail {
+
+// Expression nodes, with the following interface:
+//
+//   Vector_t                  backend type used for evaluation
+//   Value_t                   Vector_t or Mask<Vector_t>
+//   Conforms(n)               whether all arrays in the subtree have size n
+//   Eval(i)                   value for elements i, ..., i + VectorSize - 1
+//   EvalTail(i, n)            same, with only the first n lanes valid
+
+// Values of nodes are either masks or vectors. Operations on wrapped scalars
+// may return plain scalars or booleans, which are converted back.
+
+template <typename T, typename R>
+struct NodeValue {
+  using Type = typename std::conditional<std::is_same<R, Mask<T>>::value || std::is_same<R, bool>::value, Mask<T>,
+                                         T>::type;
+};
+
+template <typename T>
+struct ArrayNode {
+  using Vector_t = T;
+  using Value_t  = T;
+
+  Scalar<T> const *fData;
+  size_t fSize;
+
+  bool Conforms(size_t n) const { return fSize == n; }
+
+  VECCORE_FORCE_INLINE
+  T Eval(size_t i) const
+  {
+    T v;
+    Load(v, fData + i);
+    return v;
+  }
+
+  VECCORE_FORCE_INLINE
+  T EvalTail(size_t i, size_t n) const
+  {
+    // padding with a valid element keeps the inactive lanes in the domain
+    // of any function applied to them
+    T v = T(fData[i + n - 1]);
+    for (size_t k = 0; k + 1 < n; ++k)
+      Set(v, k, fData[i + k]);
+    return v;
+  }
+};
+
+template <typename T>
+struct ConstantNode {
+  using Vector_t = T;
+  using Value_t  = T;
+
+  T fValue;
+
+  bool Conforms(size_t) const { return true; }
+
+  VECCORE_FORCE_INLINE
+  T Eval(size_t) const { return fValue; }
+
+  VECCORE_FORCE_INLINE
+  T EvalTail(size_t, size_t) const { return fValue; }
+};
+
+template <class Op, class A>
+struct UnaryNode {
+  using Vector_t = typename A::Vector_t;
+  using Value_t  = typename NodeValue<Vector_t, decltype(Op::Apply(std::declval<typename A::Value_t>()))>::Type;
+
+  A fA;
+
+  bool Conforms(size_t n) const { return fA.Conforms(n); }
+
+  VECCORE_FORCE_INLINE
+  Value_t Eval(size_t i) const { return Value_t(Op::Apply(fA.Eval(i))); }
+
+  VECCORE_FORCE_INLINE
+  Value_t EvalTail(size_t i, size_t n) const { return Value_t(Op::Apply(fA.EvalTail(i, n))); }
+};
+
+template <class Op, class A, class B>
+struct BinaryNode {
+  using Vector_t = typename A::Vector_t;
+  using Value_t  = typename NodeValue<
+      Vector_t, decltype(Op::Apply(std::declval<typename A::Value_t>(), std::declval<typename B::Value_t>()))>::Type;
+
+  A fA;
+  B fB;
+
+  bool Conforms(size_t n) const { return fA.Conforms(n) && fB.Conforms(n); }
+
+  VECCORE_FORCE_INLINE
+  Value_t Eval(size_t i) const { return Value_t(Op::Apply(fA.Eval(i), fB.Eval(i))); }
+
+  VECCORE_FORCE_INLINE
+  Value_t EvalTail(size_t i, size_t n) const
+  {
+    return Value_t(Op::Apply(fA.EvalTail(i, n), fB.EvalTail(i, n)));
+  }
+};
+
+template <class Op, class A, class B, class C>
+struct TernaryNode {
+  using Vector_t = typename A::Vector_t;
+  using Value_t  = typename NodeValue<Vector_t, decltype(Op::Apply(std::declval<typename A::Value_t>(),
+                                                                   std::declval<typename B::Value_t>(),
+                                                                   std::declval<typename C::Value_t>()))>::Type;
+
+  A fA;
+  B fB;
+  C fC;
+
+  bool Conforms(size_t n) const { return fA.Conforms(n) && fB.Conforms(n) && fC.Conforms(n); }
+
+  VECCORE_FORCE_INLINE
+  Value_t Eval(size_t i) const { return Value_t(Op::Apply(fA.Eval(i), fB.Eval(i), fC.Eval(i))); }
+
+  VECCORE_FORCE_INLINE
+  Value_t EvalTail(size_t i, size_t n) const
+  {
+    return Value_t(Op::Apply(fA.EvalTail(i, n), fB.EvalTail(i, n), fC.EvalTail(i, n)));
+  }
+};
+
+// Backend type of an operand, void for anything but views and expressions
+
+template <class X>
+struct ArrayVectorType {
+  using Type = void;
+};
+
+template <typename T>
+struct ArrayVectorType<ArrayView<T>> {
+  using Type = T;
+};
+
+template <class E>
+struct ArrayVectorType<ArrayExpression<E>> {
+  using Type = typename E::Vector_t;
+};
+
+template <class X>
+struct IsArray : std::integral_constant<bool, !std::is_void<typename ArrayVectorType<X>::Type>::value> {
+};
+
+template <class X>
+struct IsArrayOperand : std::integral_constant<bool, IsArray<X>::value || std::is_arithmetic<X>::value> {
+};
+
+// Arguments of operators and functions: at least one view or expression, the
+// others views, expressions, or arithmetic constants. A float stands in for
+// missing arguments, as it does not change the result.
+
+template <class A, class B, class C = float>
+struct ArrayArguments {
+  static constexpr bool value = (IsArray<A>::value || IsArray<B>::value || IsArray<C>::value) &&
+                                IsArrayOperand<A>::value && IsArrayOperand<B>::value && IsArrayOperand<C>::value;
+
+  using Vector_t = typename std::conditional<
+      IsArray<A>::value, typename ArrayVectorType<A>::Type,
+      typename std::conditional<IsArray<B>::value, typename ArrayVectorType<B>::Type,
+                                typename ArrayVectorType<C>::Type>::type>::type;
+};
+
+// Conversion of an operand to a node
+
+template <class X, typename T>
+struct ArrayOperand {
+  using Node = ConstantNode<T>;
+
+  static Node Make(const X &x) { return Node{T(Scalar<T>(x))}; }
+};
+
+template <typename U, typename T>
+struct ArrayOperand<ArrayView<U>, T> {
+  static_assert(std::is_same<U, T>::value, "array operands must use the same backend type");
+
+  using Node = ArrayNode<U>;
+
+  static Node Make(const ArrayView<U> &v) { return Node{v.Data(), v.Size()}; }
+};
+
+template <class E, typename T>
+struct ArrayOperand<ArrayExpression<E>, T> {
+  static_assert(std::is_same<typename E::Vector_t, T>::value, "array operands must use the same backend type");
+
+  using Node = E;
+
+  static const E &Make(const ArrayExpression<E> &e) { return e.Node(); }
+};
+
+// Result types, only defined for valid arguments so that operators and
+// functions below do not take part in overload resolution otherwise
+
+template <bool Valid, class Op, class A>
+struct UnaryResultImpl {
+};
+
+template <class Op, class A>
+struct UnaryResultImpl<true, Op, A> {
+  using V    = typename ArrayVectorType<A>::Type;
+  using Node = UnaryNode<Op, typename ArrayOperand<A, V>::Node>;
+  using Type = ArrayExpression<Node>;
+
+  static Type Make(const A &a) { return Type(Node{ArrayOperand<A, V>::Make(a)}); }
+};
+
+template <class Op, class A>
+struct UnaryResult : UnaryResultImpl<IsArray<A>::value, Op, A> {
+};
+
+template <bool Valid, class Op, class A, class B>
+struct BinaryResultImpl {
+};
+
+template <class Op, class A, class B>
+struct BinaryResultImpl<true, Op, A, B> {
+  using V    = typename ArrayArguments<A, B>::Vector_t;
+  using Node = BinaryNode<Op, typename ArrayOperand<A, V>::Node, typename ArrayOperand<B, V>::Node>;
+  using Type = ArrayExpression<Node>;
+
+  static Type Make(const A &a, const B &b) { return Type(Node{ArrayOperand<A, V>::Make(a), ArrayOperand<B, V>::Make(b)}); }
+};
+
+template <class Op, class A, class B>
+struct BinaryResult : BinaryResultImpl<ArrayArguments<A, B>::value, Op, A, B> {
+};
+
+template <bool Valid, class Op, class A, class B, class C>
+struct TernaryResultImpl {
+};
+
+template <class Op, class A, class B, class C>
+struct TernaryResultImpl<true, Op, A, B, C> {
+  using V    = typename ArrayArguments<A, B, C>::Vector_t;
+  using Node = TernaryNode<Op, typename ArrayOperand<A, V>::Node, typename ArrayOperand<B, V>::Node,
+                           typename ArrayOperand<C, V>::Node>;
+  using Type = ArrayExpression<Node>;
+
+  static Type Make(const A &a, const B &b, const C &c)
+  {
+    return Type(Node{ArrayOperand<A, V>::Make(a), ArrayOperand<B, V>::Make(b), ArrayOperand<C, V>::Make(c)});
+  }
+};
+
+template <class Op, class A, class B, class C>
+struct TernaryResult : TernaryResultImpl<ArrayArguments<A, B, C>::value, Op, A, B, C> {
+};
+
+} // namespace detail
+
+template <class E>
+class ArrayExpression {
+public:
+  using Node_t   = E;
+  using Vector_t = typename E::Vector_t;
+  using Scalar_t = Scalar<Vector_t>;
+
+  explicit ArrayExpression(const E &node) : fNode(node) {}
+
+  const E &Node() const { return fNode; }
+
+private:
+  E fNode;
+};
+
+template <typename T>
+class ArrayView {
+public:
+  using Scalar_t = Scalar<T>;
+  using Vector_t = T;
+
+  ArrayView(Scalar_t *data, size_t size) : fData(data), fSize(size) {}
+
+  ArrayView(const ArrayView &) = default;
+
+  size_t Size() const { return fSize; }
+
+  Scalar_t *Data() const { return fData; }
+
+  Scalar_t &operator[](size_t i) const { return fData[i]; }
+
+  ArrayView &operator=(const ArrayView &v) { return Assign(detail::ArrayNode<T>{v.fData, v.fSize}); }
+
+  ArrayView &operator=(Scalar_t x) { return Assign(detail::ConstantNode<T>{T(x)}); }
+
+  template <class E>
+  ArrayView &operator=(const ArrayExpression<E> &e)
+  {
+    return Assign(e.Node());
+  }
+
+  template <class X>
+  ArrayView &operator+=(const X &x)
+  {
+    return *this = *this + x;
+  }
+
+  template <class X>
+  ArrayView &operator-=(const X &x)
+  {
+    return *this = *this - x;
+  }
+
+  template <class X>
+  ArrayView &operator*=(const X &x)
+  {
+    return *this = *this * x;
+  }
+
+  template <class X>
+  ArrayView &operator/=(const X &x)
+  {
+    return *this = *this / x;
+  }
+
+private:
+  // The single fused loop evaluating an expression
+  template <class Node>
+  ArrayView &Assign(const Node &e)
+  {
+    static_assert(std::is_same<typename Node::Vector_t, T>::value, "array operands must use the same backend type");
+    static_assert(std::is_same<typename Node::Value_t, T>::value, "cannot assign a mask to an array");
+    if (!e.Conforms(fSize)) throw std::length_error("vecCore::ArrayView: operands of different sizes");
+
+    const size_t n = fSize - fSize % VectorSize<T>();
+
+    for (size_t i = 0; i < n; i += VectorSize<T>())
+      Store(e.Eval(i), fData + i);
+
+    if (n < fSize) {
+      T v = e.EvalTail(n, fSize - n);
+      for (size_t k = 0; n + k < fSize; ++k)
+        fData[n + k] = Get(v, k);
+    }
+
+    return *this;
+  }
+
+  Scalar_t *fData;
+  size_t fSize;
+};
+
+// Operators
+
+#define VECCORE_ARRAY_UNARY_OPERATOR(OP, NAME)                                       \
+  namespace detail {                                                                 \
+  struct NAME {                                                                      \
+    template <typename T>                                                            \
+    VECCORE_FORCE_INLINE                                                             \
+    static auto Apply(const T &a) -> decltype(OP a)                                  \
+    {                                                                                \
+      return OP a;                                                                   \
+    }                                                                                \
+  };                                                                                 \
+  }                                                                                  \
+                                                                                     \
+  template <class A>                                                                 \
+  typename detail::UnaryResult<detail::NAME, A>::Type operator OP(const A &a)        \
+  {                                                                                  \
+    return detail::UnaryResult<detail::NAME, A>::Make(a);                            \
+  }
+
+#define VECCORE_ARRAY_BINARY_OPERATOR(OP, NAME)                                                \
+  namespace detail {                                                                           \
+  struct NAME {                                                                                \
+    template <typename T, typename U>                                                          \
+    VECCORE_FORCE_INLINE                                                                       \
+    static auto Apply(const T &a, const U &b) -> decltype(a OP b)                              \
+    {                                                                                          \
+      return a OP b;                                                                           \
+    }                                                                                          \
+  };                                                                                           \
+  }                                                                                            \
+                                                                                               \
+  template <class A, class B>                                                                  \
+  typename detail::BinaryResult<detail::NAME, A, B>::Type operator OP(const A &a, const B &b)  \
+  {                                                                                            \
+    return detail::BinaryResult<detail::NAME, A, B>::Make(a, b);                               \
+  }
+
+VECCORE_ARRAY_UNARY_OPERATOR(-, ArrayNegate)
+VECCORE_ARRAY_UNARY_OPERATOR(!, ArrayNot)
+
+VECCORE_ARRAY_BINARY_OPERATOR(+, ArrayAdd)
+VECCORE_ARRAY_BINARY_OPERATOR(-, ArraySubtract)
+VECCORE_ARRAY_BINARY_OPERATOR(*, ArrayMultiply)
+VECCORE_ARRAY_BINARY_OPERATOR(/, ArrayDivide)
+
+VECCORE_ARRAY_BINARY_OPERATOR(<, ArrayLess)
+VECCORE_ARRAY_BINARY_OPERATOR(<=, ArrayLessEqual)
+VECCORE_ARRAY_BINARY_OPERATOR(>, ArrayGreater)
+VECCORE_ARRAY_BINARY_OPERATOR(>=, ArrayGreaterEqual)
+VECCORE_ARRAY_BINARY_OPERATOR(==, ArrayEqual)
+VECCORE_ARRAY_BINARY_OPERATOR(!=, ArrayNotEqual)
+
+VECCORE_ARRAY_BINARY_OPERATOR(&&, ArrayAnd)
+VECCORE_ARRAY_BINARY_OPERATOR(||, ArrayOr)
+
+#undef VECCORE_ARRAY_UNARY_OPERATOR
+#undef VECCORE_ARRAY_BINARY_OPERATOR
+
+// Blend, with a mask expression and values which may also be constants
+
+namespace detail {
+struct ArrayBlend {
+  template <typename M, typename T>
+  VECCORE_FORCE_INLINE
+  static T Apply(const M &mask, const T &a, const T &b)
+  {
+    return Blend(mask, a, b);
+  }
+};
+}
+
+template <class M, class A, class B>
+typename detail::TernaryResult<detail::ArrayBlend, M, A, B>::Type Blend(const M &mask, const A &a, const B &b)
+{
+  return detail::TernaryResult<detail::ArrayBlend, M, A, B>::Make(mask, a, b);
+}
+
+// Math functions
+//
+// Overloads taking exactly an ArrayView<T> or ArrayExpression<E> are more
+// specialized than the generic math functions, and are therefore preferred
+// over them. For functions of several arguments, further overloads accept any
+// mix of views, expressions, and constants.
+
+#define VECCORE_ARRAY_MATH_UNARY(F)                                                                \
+  namespace detail {                                                                               \
+  struct Array##F {                                                                                \
+    template <typename T>                                                                          \
+    VECCORE_FORCE_INLINE                                                                           \
+    static T Apply(const T &x)                                                                     \
+    {                                                                                              \
+      return math::F(x);                                                                           \
+    }                                                                                              \
+  };                                                                                               \
+  }                                                                                                \
+                                                                                                   \
+  namespace math {                                                                                 \
+  template <typename T>                                                                            \
+  typename vecCore::detail::UnaryResult<vecCore::detail::Array##F, ArrayView<T>>::Type F(const ArrayView<T> &x) \
+  {                                                                                                \
+    return vecCore::detail::UnaryResult<vecCore::detail::Array##F, ArrayView<T>>::Make(x);         \
+  }                                                                                                \
+                                                                                                   \
+  template <class E>                                                                               \
+  typename vecCore::detail::UnaryResult<vecCore::detail::Array##F, ArrayExpression<E>>::Type F(    \
+      const ArrayExpression<E> &x)                                                                 \
+  {                                                                                                \
+    return vecCore::detail::UnaryResult<vecCore::detail::Array##F, ArrayExpression<E>>::Make(x);   \
+  }                                                                                                \
+  }
+
+#define VECCORE_ARRAY_MATH_BINARY(F)                                                               \
+  namespace detail {                                                                               \
+  struct Array##F {                                                                                \
+    template <typename T>                                                                          \
+    VECCORE_FORCE_INLINE                                                                           \
+    static T Apply(const T &x, const T &y)                                                         \
+    {                                                                                              \
+      return math::F(x, y);                                                                        \
+    }                                                                                              \
+  };                                                                                               \
+  }                                                                                                \
+                                                                                                   \
+  namespace math {                                                                                 \
+  template <class A, class B>                                                                      \
+  typename vecCore::detail::BinaryResult<vecCore::detail::Array##F, A, B>::Type F(const A &x,      \
+                                                                                  const B &y)      \
+  {                                                                                                \
+    return vecCore::detail::BinaryResult<vecCore::detail::Array##F, A, B>::Make(x, y);             \
+  }                                                                                                \
+                                                                                                   \
+  template <typename T>                                                                            \
+  typename vecCore::detail::BinaryResult<vecCore::detail::Array##F, ArrayView<T>, ArrayView<T>>::Type F( \
+      const ArrayView<T> &x, const ArrayView<T> &y)                                                \
+  {                                                                                                \
+    return vecCore::detail::BinaryResult<vecCore::detail::Array##F, ArrayView<T>, ArrayView<T>>::Make(x, y); \
+  }                                                                                                \
+                                                                                                   \
+  template <class E>                                                                               \
+  typename vecCore::detail::BinaryResult<vecCore::detail::Array##F, ArrayExpression<E>,            \
+                                         ArrayExpression<E>>::Type                                 \
+  F(const ArrayExpression<E> &x, const ArrayExpression<E> &y)                                      \
+  {                                                                                                \
+    return vecCore::detail::BinaryResult<vecCore::detail::Array##F, ArrayExpression<E>,            \
+                                         ArrayExpression<E>>::Make(x, y);                          \
+  }                                                                                                \
+  }
+
+VECCORE_ARRAY_MATH_UNARY(Abs)
+VECCORE_ARRAY_MATH_UNARY(Floor)
+VECCORE_ARRAY_MATH_UNARY(Ceil)
+VECCORE_ARRAY_MATH_UNARY(Trunc)
+VECCORE_ARRAY_MATH_UNARY(Round)
+VECCORE_ARRAY_MATH_UNARY(Sqrt)
+VECCORE_ARRAY_MATH_UNARY(RSqrt)
+VECCORE_ARRAY_MATH_UNARY(Cbrt)
+VECCORE_ARRAY_MATH_UNARY(Exp)
+VECCORE_ARRAY_MATH_UNARY(Exp2)
+VECCORE_ARRAY_MATH_UNARY(Expm1)
+VECCORE_ARRAY_MATH_UNARY(Log)
+VECCORE_ARRAY_MATH_UNARY(Log2)
+VECCORE_ARRAY_MATH_UNARY(Log10)
+VECCORE_ARRAY_MATH_UNARY(Log1p)
+VECCORE_ARRAY_MATH_UNARY(Sin)
+VECCORE_ARRAY_MATH_UNARY(Cos)
+VECCORE_ARRAY_MATH_UNARY(Tan)
+VECCORE_ARRAY_MATH_UNARY(ASin)
+VECCORE_ARRAY_MATH_UNARY(ACos)
+VECCORE_ARRAY_MATH_UNARY(ATan)
+VECCORE_ARRAY_MATH_UNARY(Sinh)
+VECCORE_ARRAY_MATH_UNARY(Cosh)
+VECCORE_ARRAY_MATH_UNARY(Tanh)
+VECCORE_ARRAY_MATH_UNARY(Erf)
+VECCORE_ARRAY_MATH_UNARY(Erfc)
+VECCORE_ARRAY_MATH_UNARY(LGamma)
+VECCORE_ARRAY_MATH_UNARY(TGamma)
+
+VECCORE_ARRAY_MATH_BINARY(Min)
+VECCORE_ARRAY_MATH_BINARY(Max)
+VECCORE_ARRAY_MATH_BINARY(CopySign)
+VECCORE_ARRAY_MATH_BINARY(ATan2)
+VECCORE_ARRAY_MATH_BINARY(Pow)
+VECCORE_ARRAY_MATH_BINARY(Fmod)
+
+#undef VECCORE_ARRAY_MATH_UNARY
+#undef VECCORE_ARRAY_MATH_BINARY
+
+namespace detail {
+struct ArrayFMA {
+  template <typename T>
+  VECCORE_FORCE_INLINE
+  static T Apply(const T &a, const T &b, const T &c)
+  {
+    return math::FMA(a, b, c);
+  }
+};
+}
+
+namespace math {
+
+template <class A, class B, class C>
+typename vecCore::detail::TernaryResult<vecCore::detail::ArrayFMA, A, B, C>::Type FMA(const A &a, const B &b,
+                                                                                      const C &c)
+{
+  return vecCore::detail::TernaryResult<vecCore::detail::ArrayFMA, A, B, C>::Make(a, b, c);
+}
+
+template <typename T>
+typename vecCore::detail::TernaryResult<vecCore::detail::ArrayFMA, ArrayView<T>, ArrayView<T>, ArrayView<T>>::Type
+FMA(const ArrayView<T> &a, const ArrayView<T> &b, const ArrayView<T> &c)
+{
+  return vecCore::detail::TernaryResult<vecCore::detail::ArrayFMA, ArrayView<T>, ArrayView<T>, ArrayView<T>>::Make(a, b,
+                                                                                                                   c);
+}
+
+template <class E>
+typename vecCore::detail::TernaryResult<vecCore::detail::ArrayFMA, ArrayExpression<E>, ArrayExpression<E>,
+                                        ArrayExpression<E>>::Type
+FMA(const ArrayExpression<E> &a, const ArrayExpression<E> &b, const ArrayExpression<E> &c)
+{
+  return vecCore::detail::TernaryResult<vecCore::detail::ArrayFMA, ArrayExpression<E>, ArrayExpression<E>,
+                                        ArrayExpression<E>>::Make(a, b, c);
+}
+
+} // namespace math
+} // namespace vecCore
+
+#endif
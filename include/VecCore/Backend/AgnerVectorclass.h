@@ -3,28 +3,46 @@
 
 #define VECCORE_ENABLE_AGNER 1
 
+// The 512 bit vectors of vectorclass, and the AgnerAVX512 backend built on
+// them, double the code to parse, so they are only included when
+// VECCORE_ENABLE_AGNER_AVX512 is defined first, as VecCore/VecCore does
+
 #define VCL_NAMESPACE vcl
+#ifdef VECCORE_ENABLE_AGNER_AVX512
 #define MAX_VECTOR_SIZE 512
+#else
+#define MAX_VECTOR_SIZE 256
+#endif
 #include "vectorclass/vectorclass.h"
 #include "vectorclass/vectormath_exp.h"
 #include "vectorclass/vectormath_trig.h"
 
+#include <climits>
+#include <cmath>
 #include <cstdint>
+#include <limits>
+#include <type_traits>
 
 namespace vecCore {
 
-#define AGNER_IMPL_TRAIT_BOOL(TYPE)                                            \
+// Masks are stored as full vectors, or as bit masks with AVX-512, so their
+// number of lanes does not follow from their size as for other types
+
+#define AGNER_IMPL_TRAIT_BOOL(TYPE, SIZE)                                      \
   template <> struct TypeTraits<TYPE> {                                        \
     using IndexType = size_t;                                                  \
     using ScalarType = Bool_s;                                                 \
-  };
+  };                                                                           \
+                                                                               \
+  template <>                                                                  \
+  struct VectorSizeTraits<TYPE> : std::integral_constant<Size_s, SIZE> {};
 
 // AVX or AVX2
-AGNER_IMPL_TRAIT_BOOL(vcl::Vec4db);
-AGNER_IMPL_TRAIT_BOOL(vcl::Vec8fb);
-AGNER_IMPL_TRAIT_BOOL(vcl::Vec4qb);
-AGNER_IMPL_TRAIT_BOOL(vcl::Vec8ib);
-AGNER_IMPL_TRAIT_BOOL(vcl::Vec16sb);
+AGNER_IMPL_TRAIT_BOOL(vcl::Vec4db, 4)
+AGNER_IMPL_TRAIT_BOOL(vcl::Vec8fb, 8)
+AGNER_IMPL_TRAIT_BOOL(vcl::Vec4qb, 4)
+AGNER_IMPL_TRAIT_BOOL(vcl::Vec8ib, 8)
+AGNER_IMPL_TRAIT_BOOL(vcl::Vec16sb, 16)
 
 template <> struct TypeTraits<vcl::Vec4d> {
   using ScalarType = double;
@@ -74,11 +92,12 @@ template <> struct TypeTraits<vcl::Vec4uq> {
   using IndexType = vcl::Vec4q;
 };
 
+#ifdef VECCORE_ENABLE_AGNER_AVX512
 // AVX512
-AGNER_IMPL_TRAIT_BOOL(vcl::Vec8db);
-AGNER_IMPL_TRAIT_BOOL(vcl::Vec16fb);
-AGNER_IMPL_TRAIT_BOOL(vcl::Vec8qb);
-AGNER_IMPL_TRAIT_BOOL(vcl::Vec16ib);
+AGNER_IMPL_TRAIT_BOOL(vcl::Vec8db, 8)
+AGNER_IMPL_TRAIT_BOOL(vcl::Vec16fb, 16)
+AGNER_IMPL_TRAIT_BOOL(vcl::Vec8qb, 8)
+AGNER_IMPL_TRAIT_BOOL(vcl::Vec16ib, 16)
 
 template <> struct TypeTraits<vcl::Vec8d> {
   using ScalarType = double;
@@ -115,6 +134,14 @@ template <> struct TypeTraits<vcl::Vec8uq> {
   using MaskType = vcl::Vec8qb;
   using IndexType = vcl::Vec8q;
 };
+#endif
+
+template <> struct ExponentTraits<vcl::Vec4d> { using Type = vcl::Vec4q; };
+template <> struct ExponentTraits<vcl::Vec8f> { using Type = vcl::Vec8i; };
+#ifdef VECCORE_ENABLE_AGNER_AVX512
+template <> struct ExponentTraits<vcl::Vec8d> { using Type = vcl::Vec8q; };
+template <> struct ExponentTraits<vcl::Vec16f> { using Type = vcl::Vec16i; };
+#endif
 
 namespace backend {
 
@@ -135,6 +162,7 @@ public:
   using UInt64_v = vcl::Vec4uq;
 };
 
+#ifdef VECCORE_ENABLE_AGNER_AVX512
 class AgnerAVX512 {
 public:
   using Real_v = vcl::Vec8d;
@@ -149,6 +177,7 @@ public:
   using UInt32_v = vcl::Vec16ui;
   using UInt64_v = vcl::Vec8uq;
 };
+#endif
 
 } // namespace backend
 
@@ -176,10 +205,99 @@ INDEX_IMPL_AGNER_BOOL(vcl::Vec4qb)
 INDEX_IMPL_AGNER_BOOL(vcl::Vec8ib)
 INDEX_IMPL_AGNER_BOOL(vcl::Vec16sb)
 
+#ifdef VECCORE_ENABLE_AGNER_AVX512
 INDEX_IMPL_AGNER_BOOL(vcl::Vec8db)
 INDEX_IMPL_AGNER_BOOL(vcl::Vec16fb)
 INDEX_IMPL_AGNER_BOOL(vcl::Vec8qb)
 INDEX_IMPL_AGNER_BOOL(vcl::Vec16ib)
+#endif
+
+// Writing through Begin() breaks strict aliasing for the intrinsic types
+// and is silently dropped by the optimizer, so use insert() as for masks,
+// which blends the value in registers.
+
+#define INDEX_IMPL_AGNER(TYPE)                                                 \
+  template <> struct IndexingImplementation<TYPE> {                            \
+    using V = TYPE;                                                            \
+    static inline Scalar<V> Get(const V &v, size_t i) {                        \
+      return v.extract(i);                                                     \
+    }                                                                          \
+    static inline void Set(V &v, size_t i, Scalar<V> const val) {              \
+      v.insert(i, val);                                                        \
+    }                                                                          \
+  };
+
+INDEX_IMPL_AGNER(vcl::Vec4d)
+INDEX_IMPL_AGNER(vcl::Vec8f)
+INDEX_IMPL_AGNER(vcl::Vec4q)
+INDEX_IMPL_AGNER(vcl::Vec4uq)
+INDEX_IMPL_AGNER(vcl::Vec8i)
+INDEX_IMPL_AGNER(vcl::Vec8ui)
+INDEX_IMPL_AGNER(vcl::Vec16s)
+INDEX_IMPL_AGNER(vcl::Vec16us)
+
+#ifdef VECCORE_ENABLE_AGNER_AVX512
+INDEX_IMPL_AGNER(vcl::Vec8d)
+INDEX_IMPL_AGNER(vcl::Vec16f)
+INDEX_IMPL_AGNER(vcl::Vec8q)
+INDEX_IMPL_AGNER(vcl::Vec8uq)
+INDEX_IMPL_AGNER(vcl::Vec16i)
+INDEX_IMPL_AGNER(vcl::Vec16ui)
+#endif
+
+// Non-temporal stores of native registers. Vectors wider than the registers
+// of the instruction set are emulated with two halves, which are stored
+// separately.
+
+namespace detail {
+inline void AgnerStream(__m128 v, void *ptr) { _mm_stream_ps((float *)ptr, v); }
+inline void AgnerStream(__m128d v, void *ptr) { _mm_stream_pd((double *)ptr, v); }
+inline void AgnerStream(__m128i v, void *ptr) { _mm_stream_si128((__m128i *)ptr, v); }
+
+#if INSTRSET >= 7
+inline void AgnerStream(__m256 v, void *ptr) { _mm256_stream_ps((float *)ptr, v); }
+inline void AgnerStream(__m256d v, void *ptr) { _mm256_stream_pd((double *)ptr, v); }
+#endif
+
+#if INSTRSET >= 8
+inline void AgnerStream(__m256i v, void *ptr) { _mm256_stream_si256((__m256i *)ptr, v); }
+#endif
+
+#if INSTRSET >= 9
+inline void AgnerStream(__m512 v, void *ptr) { _mm512_stream_ps((float *)ptr, v); }
+inline void AgnerStream(__m512d v, void *ptr) { _mm512_stream_pd((double *)ptr, v); }
+inline void AgnerStream(__m512i v, void *ptr) { _mm512_stream_si512((__m512i *)ptr, v); }
+#endif
+
+// whether V converts to a native register, and can be streamed in one store
+std::true_type AgnerIsNative(__m128);
+std::true_type AgnerIsNative(__m128d);
+std::true_type AgnerIsNative(__m128i);
+#if INSTRSET >= 7
+std::true_type AgnerIsNative(__m256);
+std::true_type AgnerIsNative(__m256d);
+#endif
+#if INSTRSET >= 8
+std::true_type AgnerIsNative(__m256i);
+#endif
+#if INSTRSET >= 9
+std::true_type AgnerIsNative(__m512);
+std::true_type AgnerIsNative(__m512d);
+std::true_type AgnerIsNative(__m512i);
+#endif
+std::false_type AgnerIsNative(...);
+
+template <class V>
+struct AgnerNativeRegister : decltype(AgnerIsNative(std::declval<V>())) {
+};
+
+template <class V>
+inline typename std::enable_if<!AgnerNativeRegister<V>::value>::type AgnerStream(V const &v, void *ptr)
+{
+  AgnerStream(v.get_low(), ptr);
+  AgnerStream(v.get_high(), (char *)ptr + sizeof(V) / 2);
+}
+}
 
 #define LOADSTORE_IMPL_AGNER(TYPE)                                             \
   template <> struct LoadStoreImplementation<TYPE> {                           \
@@ -193,6 +311,24 @@ INDEX_IMPL_AGNER_BOOL(vcl::Vec16ib)
     static inline void Store(V const &v, S *ptr) {                             \
       v.store(ptr);                                                            \
     }                                                                          \
+  };                                                                           \
+                                                                               \
+  template <> struct AlignedLoadStoreImplementation<TYPE> {                    \
+    using V = TYPE;                                                            \
+    template <typename S = Scalar<V>>                                          \
+    static inline void LoadAligned(V &v, S const *ptr) {                       \
+      v.load_a(ptr);                                                           \
+    }                                                                          \
+                                                                               \
+    template <typename S = Scalar<V>>                                          \
+    static inline void StoreAligned(V const &v, S *ptr) {                      \
+      v.store_a(ptr);                                                          \
+    }                                                                          \
+                                                                               \
+    template <typename S = Scalar<V>>                                          \
+    static inline void StoreStreaming(V const &v, S *ptr) {                    \
+      detail::AgnerStream(v, ptr);                                             \
+    }                                                                          \
   };
 
 LOADSTORE_IMPL_AGNER(vcl::Vec4d);
@@ -204,12 +340,14 @@ LOADSTORE_IMPL_AGNER(vcl::Vec8ui);
 LOADSTORE_IMPL_AGNER(vcl::Vec16s);
 LOADSTORE_IMPL_AGNER(vcl::Vec16us);
 
+#ifdef VECCORE_ENABLE_AGNER_AVX512
 LOADSTORE_IMPL_AGNER(vcl::Vec8d);
 LOADSTORE_IMPL_AGNER(vcl::Vec16f);
 LOADSTORE_IMPL_AGNER(vcl::Vec8q);
 LOADSTORE_IMPL_AGNER(vcl::Vec8uq);
 LOADSTORE_IMPL_AGNER(vcl::Vec16i);
 LOADSTORE_IMPL_AGNER(vcl::Vec16ui);
+#endif
 
 // template <typename T>
 // struct LoadStoreImplementation<Vc::Mask<T>> {
@@ -228,6 +366,236 @@ LOADSTORE_IMPL_AGNER(vcl::Vec16ui);
 //}
 //};
 
+// Hardware gathers with AVX2 and AVX-512 of floating point vectors, from
+// arrays of their scalar type. Vectors wider than the registers of the
+// instruction set are gathered in two halves. Gathers from arrays of other
+// types, and scatters, which need AVX-512, use the generic version.
+
+#if INSTRSET >= 8
+namespace detail {
+inline vcl::Vec8f AgnerGather(float const *ptr, vcl::Vec8i const &idx) { return _mm256_i32gather_ps(ptr, idx, 4); }
+inline vcl::Vec4d AgnerGather(double const *ptr, vcl::Vec4q const &idx) { return _mm256_i64gather_pd(ptr, idx, 8); }
+
+#if defined(VECCORE_ENABLE_AGNER_AVX512) && INSTRSET >= 9
+inline vcl::Vec16f AgnerGather(float const *ptr, vcl::Vec16i const &idx) { return _mm512_i32gather_ps(idx, ptr, 4); }
+inline vcl::Vec8d AgnerGather(double const *ptr, vcl::Vec8q const &idx) { return _mm512_i64gather_pd(idx, ptr, 8); }
+#elif defined(VECCORE_ENABLE_AGNER_AVX512)
+inline vcl::Vec16f AgnerGather(float const *ptr, vcl::Vec16i const &idx)
+{
+  return vcl::Vec16f(AgnerGather(ptr, idx.get_low()), AgnerGather(ptr, idx.get_high()));
+}
+
+inline vcl::Vec8d AgnerGather(double const *ptr, vcl::Vec8q const &idx)
+{
+  return vcl::Vec8d(AgnerGather(ptr, idx.get_low()), AgnerGather(ptr, idx.get_high()));
+}
+#endif
+}
+
+#define GATHER_IMPL_AGNER(TYPE)                                                \
+  template <> struct GatherScatterImplementation<TYPE> {                       \
+    using V = TYPE;                                                            \
+    template <typename S = Scalar<V>>                                          \
+    static inline void Gather(V &v, S const *ptr, Index<V> const &idx) {       \
+      Gather(v, ptr, idx, std::is_same<S, Scalar<V>>());                       \
+    }                                                                          \
+                                                                               \
+    template <typename S = Scalar<V>>                                          \
+    static inline void Scatter(V const &v, S *ptr, Index<V> const &idx) {      \
+      using W = typename FallbackType<V, S>::type;                             \
+      VECCORE_FALLBACK(W, "Scatter")                                           \
+      for (size_t i = 0; i < VectorSize<V>(); ++i)                             \
+        ptr[Get(idx, i)] = Get(v, i);                                          \
+    }                                                                          \
+                                                                               \
+  private:                                                                     \
+    static inline void Gather(V &v, Scalar<V> const *ptr,                      \
+                              Index<V> const &idx, std::true_type) {           \
+      v = detail::AgnerGather(ptr, idx);                                       \
+    }                                                                          \
+                                                                               \
+    template <typename S>                                                      \
+    static inline void Gather(V &v, S const *ptr, Index<V> const &idx,         \
+                              std::false_type) {                               \
+      using W = typename FallbackType<V, S>::type;                             \
+      VECCORE_FALLBACK(W, "Gather")                                            \
+      for (size_t i = 0; i < VectorSize<V>(); ++i)                             \
+        Set(v, i, ptr[Get(idx, i)]);                                           \
+    }                                                                          \
+  };
+
+GATHER_IMPL_AGNER(vcl::Vec4d)
+GATHER_IMPL_AGNER(vcl::Vec8f)
+
+#ifdef VECCORE_ENABLE_AGNER_AVX512
+GATHER_IMPL_AGNER(vcl::Vec8d)
+GATHER_IMPL_AGNER(vcl::Vec16f)
+#endif
+
+// see Interface.h
+template <> struct HasNativeGather<vcl::Vec4d> : std::true_type {};
+template <> struct HasNativeGather<vcl::Vec8f> : std::true_type {};
+#ifdef VECCORE_ENABLE_AGNER_AVX512
+template <> struct HasNativeGather<vcl::Vec8d> : std::true_type {};
+template <> struct HasNativeGather<vcl::Vec16f> : std::true_type {};
+#endif
+#endif
+
+// FMA() is vcl::mul_add(), which is fused when FMA instructions are enabled,
+// as for scalars
+template <> struct HasFMA<vcl::Vec4d> : HasFMA<double> {};
+template <> struct HasFMA<vcl::Vec8f> : HasFMA<float> {};
+#ifdef VECCORE_ENABLE_AGNER_AVX512
+template <> struct HasFMA<vcl::Vec8d> : HasFMA<double> {};
+template <> struct HasFMA<vcl::Vec16f> : HasFMA<float> {};
+#endif
+
+// The masks of 512 bit vectors are held in mask registers with AVX-512
+#if INSTRSET >= 9 && defined(VECCORE_ENABLE_AGNER_AVX512)
+template <> struct IsHardwareMask<vcl::Vec8db> : std::true_type {};
+template <> struct IsHardwareMask<vcl::Vec16fb> : std::true_type {};
+template <> struct IsHardwareMask<vcl::Vec8qb> : std::true_type {};
+template <> struct IsHardwareMask<vcl::Vec16ib> : std::true_type {};
+#endif
+
+// Lists of the even or odd indices 0 <= i < 2N, used to pick the even or odd
+// lanes of two vectors with the blend templates of vectorclass
+
+namespace detail {
+template <int... I>
+struct AgnerIndexList {
+};
+
+template <int N, int First, int... I>
+struct AgnerStridedIndices : AgnerStridedIndices<N - 1, First, First + 2 * (N - 1), I...> {
+};
+
+template <int First, int... I>
+struct AgnerStridedIndices<0, First, I...> {
+  using Type = AgnerIndexList<I...>;
+};
+}
+
+// ReduceAddN adds the even and odd lanes of pairs of vectors, which halves
+// the number of vectors and leaves the partial sums of each in consecutive
+// lanes, until a single vector is left. The 16 bit types use the generic
+// version, as blend8s of this vectorclass version does not compile as C++11.
+
+#define TRANSPOSED_REDUCTION_IMPL_AGNER(TYPE, BLEND)                           \
+  template <> struct TransposedReductionImplementation<TYPE> {                 \
+    using V = TYPE;                                                            \
+    static constexpr int kVS = int(VectorSize<V>());                           \
+                                                                               \
+    template <int... I>                                                        \
+    static inline V Pick(V const &a, V const &b,                               \
+                         detail::AgnerIndexList<I...>) {                       \
+      return vcl::BLEND<I...>(a, b);                                           \
+    }                                                                          \
+                                                                               \
+    static inline V PairAdd(V const &a, V const &b) {                          \
+      return Pick(a, b, typename detail::AgnerStridedIndices<kVS, 0>::Type()) \
+           + Pick(a, b, typename detail::AgnerStridedIndices<kVS, 1>::Type());\
+    }                                                                          \
+                                                                               \
+    template <size_t N>                                                        \
+    static inline V AddN(const V (&v)[N]) {                                    \
+      V u[kVS];                                                                \
+      for (size_t i = 0; i < size_t(kVS); ++i)                                 \
+        u[i] = i < N ? v[i] : V(Scalar<V>(0));                                 \
+      for (size_t n = size_t(kVS) / 2; n > 0; n /= 2)                          \
+        for (size_t i = 0; i < n; ++i)                                         \
+          u[i] = PairAdd(u[2 * i], u[2 * i + 1]);                              \
+      return u[0];                                                             \
+    }                                                                          \
+  };
+
+TRANSPOSED_REDUCTION_IMPL_AGNER(vcl::Vec4d, blend4d);
+TRANSPOSED_REDUCTION_IMPL_AGNER(vcl::Vec8f, blend8f);
+TRANSPOSED_REDUCTION_IMPL_AGNER(vcl::Vec4q, blend4q);
+TRANSPOSED_REDUCTION_IMPL_AGNER(vcl::Vec4uq, blend4uq);
+TRANSPOSED_REDUCTION_IMPL_AGNER(vcl::Vec8i, blend8i);
+TRANSPOSED_REDUCTION_IMPL_AGNER(vcl::Vec8ui, blend8ui);
+
+#ifdef VECCORE_ENABLE_AGNER_AVX512
+TRANSPOSED_REDUCTION_IMPL_AGNER(vcl::Vec8d, blend8d);
+TRANSPOSED_REDUCTION_IMPL_AGNER(vcl::Vec16f, blend16f);
+TRANSPOSED_REDUCTION_IMPL_AGNER(vcl::Vec8q, blend8q);
+TRANSPOSED_REDUCTION_IMPL_AGNER(vcl::Vec8uq, blend8uq);
+TRANSPOSED_REDUCTION_IMPL_AGNER(vcl::Vec16i, blend16i);
+TRANSPOSED_REDUCTION_IMPL_AGNER(vcl::Vec16ui, blend16ui);
+#endif
+
+#define WIDENING_IMPL_AGNER(WTYPE, TYPE)                                       \
+  template <> struct WideningImplementation<WTYPE, TYPE> {                     \
+    static inline WTYPE Widen(TYPE const &v, size_t part) {                    \
+      return part == 0 ? vcl::extend_low(v) : vcl::extend_high(v);             \
+    }                                                                          \
+  };
+
+WIDENING_IMPL_AGNER(vcl::Vec4d, vcl::Vec8f);
+#ifdef VECCORE_ENABLE_AGNER_AVX512
+WIDENING_IMPL_AGNER(vcl::Vec8d, vcl::Vec16f);
+#endif
+
+// The extreme value is broadcast to all lanes by a tree of permutations that
+// swap halves, quarters, and so on, each followed by a min or max, and its
+// first lane is then found from the mask of lanes equal to it. The lanes of
+// floating point vectors must not be NaN.
+
+#define MINMAX_TREE4_AGNER(PERMUTE, F, v)                                      \
+  v = F(v, vcl::PERMUTE<2, 3, 0, 1>(v));                                       \
+  v = F(v, vcl::PERMUTE<1, 0, 3, 2>(v));
+
+#define MINMAX_TREE8_AGNER(PERMUTE, F, v)                                      \
+  v = F(v, vcl::PERMUTE<4, 5, 6, 7, 0, 1, 2, 3>(v));                           \
+  v = F(v, vcl::PERMUTE<2, 3, 0, 1, 6, 7, 4, 5>(v));                           \
+  v = F(v, vcl::PERMUTE<1, 0, 3, 2, 5, 4, 7, 6>(v));
+
+#define MINMAX_TREE16_AGNER(PERMUTE, F, v)                                     \
+  v = F(v, vcl::PERMUTE<8, 9, 10, 11, 12, 13, 14, 15,                          \
+                        0, 1, 2, 3, 4, 5, 6, 7>(v));                           \
+  v = F(v, vcl::PERMUTE<4, 5, 6, 7, 0, 1, 2, 3,                                \
+                        12, 13, 14, 15, 8, 9, 10, 11>(v));                     \
+  v = F(v, vcl::PERMUTE<2, 3, 0, 1, 6, 7, 4, 5,                                \
+                        10, 11, 8, 9, 14, 15, 12, 13>(v));                     \
+  v = F(v, vcl::PERMUTE<1, 0, 3, 2, 5, 4, 7, 6,                                \
+                        9, 8, 11, 10, 13, 12, 15, 14>(v));
+
+#define REDUCTION_IMPL_AGNER(TYPE, N, PERMUTE)                                 \
+  template <> struct ReductionImplementation<TYPE> {                           \
+    using V = TYPE;                                                            \
+                                                                               \
+    static inline size_t MinIndex(V const &v) {                                \
+      V m = v;                                                                 \
+      MINMAX_TREE##N##_AGNER(PERMUTE, vcl::min, m)                             \
+      int i = vcl::horizontal_find_first(v == m);                              \
+      return i < 0 ? 0 : size_t(i);                                            \
+    }                                                                          \
+                                                                               \
+    static inline size_t MaxIndex(V const &v) {                                \
+      V m = v;                                                                 \
+      MINMAX_TREE##N##_AGNER(PERMUTE, vcl::max, m)                             \
+      int i = vcl::horizontal_find_first(v == m);                              \
+      return i < 0 ? 0 : size_t(i);                                            \
+    }                                                                          \
+  };
+
+REDUCTION_IMPL_AGNER(vcl::Vec4d, 4, permute4d);
+REDUCTION_IMPL_AGNER(vcl::Vec8f, 8, permute8f);
+REDUCTION_IMPL_AGNER(vcl::Vec4q, 4, permute4q);
+REDUCTION_IMPL_AGNER(vcl::Vec4uq, 4, permute4uq);
+REDUCTION_IMPL_AGNER(vcl::Vec8i, 8, permute8i);
+REDUCTION_IMPL_AGNER(vcl::Vec8ui, 8, permute8ui);
+
+#ifdef VECCORE_ENABLE_AGNER_AVX512
+REDUCTION_IMPL_AGNER(vcl::Vec8d, 8, permute8d);
+REDUCTION_IMPL_AGNER(vcl::Vec16f, 16, permute16f);
+REDUCTION_IMPL_AGNER(vcl::Vec8q, 8, permute8q);
+REDUCTION_IMPL_AGNER(vcl::Vec8uq, 8, permute8uq);
+REDUCTION_IMPL_AGNER(vcl::Vec16i, 16, permute16i);
+REDUCTION_IMPL_AGNER(vcl::Vec16ui, 16, permute16ui);
+#endif
+
 #define MASKING_IMPL_AGNER(TYPE)                                               \
   template <> struct MaskingImplementation<TYPE> {                             \
     using M = vecCore::TypeTraits<TYPE>::MaskType;                             \
@@ -252,12 +620,49 @@ MASKING_IMPL_AGNER(vcl::Vec8ui);
 MASKING_IMPL_AGNER(vcl::Vec16s);
 MASKING_IMPL_AGNER(vcl::Vec16us);
 
+#ifdef VECCORE_ENABLE_AGNER_AVX512
 MASKING_IMPL_AGNER(vcl::Vec8d);
 MASKING_IMPL_AGNER(vcl::Vec16f);
 MASKING_IMPL_AGNER(vcl::Vec8q);
 MASKING_IMPL_AGNER(vcl::Vec8uq);
 MASKING_IMPL_AGNER(vcl::Vec16i);
 MASKING_IMPL_AGNER(vcl::Vec16ui);
+#endif
+
+#if INSTRSET >= 9 && defined(__AVX512CD__) && defined(VECCORE_ENABLE_AGNER_AVX512)
+
+// With AVX-512CD, vpconflict{d,q} gives for each lane the bitmask of preceding
+// lanes holding the same index. The highest set bit points to the nearest such
+// lane, so the prefix sums along each chain of equal indices can be computed
+// with log2(N) rounds of pointer jumping using vector permutes.
+
+#define CONFLICT_IMPL_AGNER(ITYPE, CONFLICT, LZCNT, LOOKUP, BITS)              \
+  template <> struct ConflictImplementation<ITYPE> {                           \
+    using I = ITYPE;                                                           \
+                                                                               \
+    static inline Bool_s Free(const I &idx) {                                  \
+      return vcl::horizontal_and(I(CONFLICT(idx)) == I(0));                    \
+    }                                                                          \
+                                                                               \
+    template <typename T>                                                      \
+    static inline void PrefixSum(T &sum, const T &v, const I &idx) {           \
+      I p = I(BITS - 1) - I(LZCNT(CONFLICT(idx)));                             \
+      auto m = p >= I(0);                                                      \
+      sum = v;                                                                 \
+      while (vcl::horizontal_or(m)) {                                          \
+        sum = vcl::select(m, sum + T(vcl::LOOKUP(p, sum)), sum);               \
+        p = vcl::select(m, I(vcl::LOOKUP(p, p)), p);                           \
+        m = m && p >= I(0);                                                    \
+      }                                                                        \
+    }                                                                          \
+  };
+
+CONFLICT_IMPL_AGNER(vcl::Vec16i, _mm512_conflict_epi32, _mm512_lzcnt_epi32, lookup16, 32)
+CONFLICT_IMPL_AGNER(vcl::Vec8q, _mm512_conflict_epi64, _mm512_lzcnt_epi64, lookup8, 64)
+
+#undef CONFLICT_IMPL_AGNER
+
+#endif
 
 namespace math {
 
@@ -296,21 +701,121 @@ namespace math {
   TYPE Ceil(const TYPE &x) { return vcl::ceil(x); }                            \
                                                                                \
   VECCORE_FORCE_INLINE                                                         \
-  TYPE Trunc(const TYPE &x) { return vcl::floor(x); }                          \
+  TYPE Trunc(const TYPE &x) {                                                  \
+    /* values above 1/epsilon are integers already, and the emulation of */    \
+    /* truncate() without SSE4.1 overflows for them and loses signed zeros */  \
+    const TYPE big(1 / std::numeric_limits<Scalar<TYPE>>::epsilon());          \
+    TYPE t = vcl::sign_combine(vcl::abs(vcl::truncate(x)), x);                 \
+    return vcl::select(vcl::abs(x) < big, t, x);                               \
+  }                                                                            \
   VECCORE_FORCE_INLINE                                                         \
   TYPE CopySign(const TYPE &x, const TYPE &y) {                                \
-    return vcl::sign_combine(x, y);                                            \
+    return vcl::sign_combine(vcl::abs(x), y);                                  \
   }                                                                            \
   VECCORE_FORCE_INLINE                                                         \
   TYPE Max(const TYPE &x, const TYPE &y) { return vcl::max(x, y); }            \
   VECCORE_FORCE_INLINE                                                         \
-  TYPE Min(const TYPE &x, const TYPE &y) { return vcl::min(x, y); }
+  TYPE Min(const TYPE &x, const TYPE &y) { return vcl::min(x, y); }            \
+  VECCORE_FORCE_INLINE                                                         \
+  TYPE FMA(const TYPE &a, const TYPE &b, const TYPE &c) {                      \
+    return vcl::mul_add(a, b, c);                                              \
+  }
 
 FLOATMATH_IMPL_AGNER(vcl::Vec4d);
 FLOATMATH_IMPL_AGNER(vcl::Vec8f);
 
+#ifdef VECCORE_ENABLE_AGNER_AVX512
 FLOATMATH_IMPL_AGNER(vcl::Vec8d);
 FLOATMATH_IMPL_AGNER(vcl::Vec16f);
+#endif
+
+// Single precision RSqrt() from the 11 bit (AVX) or 14 bit (AVX-512) hardware
+// estimate, refined by one Newton-Raphson step. Zero and infinite inputs,
+// for which the step would produce NaN, return the estimate unchanged.
+
+#define RSQRT_IMPL_AGNER(TYPE)                                                 \
+  VECCORE_FORCE_INLINE                                                         \
+  TYPE RSqrt(const TYPE &x) {                                                  \
+    TYPE y = vcl::approx_rsqrt(x);                                             \
+    TYPE r = y * vcl::mul_add(TYPE(-0.5f) * x * y, y, TYPE(1.5f));             \
+    return vcl::select(vcl::is_finite(r), r, y);                               \
+  }
+
+RSQRT_IMPL_AGNER(vcl::Vec8f)
+#ifdef VECCORE_ENABLE_AGNER_AVX512
+RSQRT_IMPL_AGNER(vcl::Vec16f)
+#endif
+
+#undef RSQRT_IMPL_AGNER
+
+// Frexp, Ldexp and Ilogb by direct manipulation of the exponent bits. Inputs
+// that are subnormal are scaled up first, and Ldexp multiplies in steps such
+// that only the last multiplication can round, as in musl's scalbn().
+
+#define EXPONENT_IMPL_AGNER(TYPE, ITYPE, TOFLOAT, MANT, BIAS, EMASK, SCALE)    \
+  namespace detail {                                                           \
+  VECCORE_FORCE_INLINE                                                         \
+  TYPE Pow2(const ITYPE &n) {                                                  \
+    return vcl::TOFLOAT((n + ITYPE(BIAS + 1)) << MANT);                        \
+  }                                                                            \
+  }                                                                            \
+                                                                               \
+  VECCORE_FORCE_INLINE                                                         \
+  TYPE Frexp(const TYPE &x, ITYPE *exp) {                                      \
+    using I = Scalar<ITYPE>;                                                   \
+    auto sub = vcl::abs(x) < TYPE(std::numeric_limits<Scalar<TYPE>>::min());   \
+    ITYPE bits = ITYPE(vcl::reinterpret_i(x));                                 \
+    ITYPE adj = vcl::select(((bits >> MANT) & ITYPE(EMASK)) == ITYPE(0),       \
+                            ITYPE(SCALE), ITYPE(0));                           \
+    TYPE xs = vcl::select(sub, x * detail::Pow2(ITYPE(SCALE)), x);             \
+    bits = ITYPE(vcl::reinterpret_i(xs));                                      \
+    ITYPE e = (bits >> MANT) & ITYPE(EMASK);                                   \
+    *exp = vcl::select(e == ITYPE(0) || e == ITYPE(EMASK), ITYPE(0),           \
+                       e - ITYPE(BIAS) - adj);                                 \
+    bits = (bits & ITYPE(~(I(EMASK) << MANT))) | ITYPE(I(BIAS) << MANT);       \
+    return vcl::select(x == TYPE(0) || !vcl::is_finite(x), x,                  \
+                       TYPE(vcl::TOFLOAT(bits)));                              \
+  }                                                                            \
+                                                                               \
+  VECCORE_FORCE_INLINE                                                         \
+  TYPE Ldexp(const TYPE &x, const ITYPE &exp) {                                \
+    const ITYPE kMax(BIAS + 1), kMin(-BIAS), kStep(-BIAS + MANT + 1);          \
+    ITYPE n = exp, s;                                                          \
+    TYPE y = x;                                                                \
+    for (int i = 0; i < 2; ++i) {                                              \
+      s = vcl::select(n > kMax, kMax, ITYPE(0));                               \
+      y *= detail::Pow2(s);                                                    \
+      n -= s;                                                                  \
+    }                                                                          \
+    for (int i = 0; i < 2; ++i) {                                              \
+      s = vcl::select(n < kMin, kStep, ITYPE(0));                              \
+      y *= detail::Pow2(s);                                                    \
+      n -= s;                                                                  \
+    }                                                                          \
+    return y * detail::Pow2(vcl::max(vcl::min(n, kMax), kMin));                \
+  }                                                                            \
+                                                                               \
+  VECCORE_FORCE_INLINE                                                         \
+  ITYPE Ilogb(const TYPE &x) {                                                 \
+    using I = Scalar<ITYPE>;                                                   \
+    const ITYPE inf(I(EMASK) << MANT);                                         \
+    ITYPE e, bits = ITYPE(vcl::reinterpret_i(x)) &                             \
+                    ITYPE(std::numeric_limits<I>::max());                      \
+    Frexp(x, &e);                                                              \
+    e = vcl::select(bits == ITYPE(0), ITYPE(FP_ILOGB0), e - ITYPE(1));         \
+    e = vcl::select(bits == inf, ITYPE(INT_MAX), e);                           \
+    return vcl::select(bits > inf, ITYPE(FP_ILOGBNAN), e);                     \
+  }
+
+EXPONENT_IMPL_AGNER(vcl::Vec4d, vcl::Vec4q, reinterpret_d, 52, 1022, 0x7FF, 54)
+EXPONENT_IMPL_AGNER(vcl::Vec8f, vcl::Vec8i, reinterpret_f, 23, 126, 0xFF, 25)
+
+#ifdef VECCORE_ENABLE_AGNER_AVX512
+EXPONENT_IMPL_AGNER(vcl::Vec8d, vcl::Vec8q, reinterpret_d, 52, 1022, 0x7FF, 54)
+EXPONENT_IMPL_AGNER(vcl::Vec16f, vcl::Vec16i, reinterpret_f, 23, 126, 0xFF, 25)
+#endif
+
+#undef EXPONENT_IMPL_AGNER
 
 } // namespace math
 
@@ -0,0 +1,169 @@
+// internal header; Frexp, Ldexp and Ilogb by manipulation of exponent bits
+#ifndef VECCORE_EXPONENTBITS_H
+#define VECCORE_EXPONENTBITS_H
+
+#include <climits>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <type_traits>
+
+namespace vecCore {
+namespace math {
+namespace detail {
+
+// Layout of IEEE 754 single and double precision numbers, with the signed
+// integer type of the same width holding their bits
+template <typename S>
+struct ExponentField;
+
+template <>
+struct ExponentField<float> {
+  using Bits = int32_t;
+  static constexpr int kMant  = 23;   // bits of the mantissa
+  static constexpr int kBias  = 126;  // bias of frexp() exponents
+  static constexpr int kMask  = 0xFF; // exponent field
+  static constexpr int kScale = 25;   // scaling of subnormal numbers
+};
+
+template <>
+struct ExponentField<double> {
+  using Bits = int64_t;
+  static constexpr int kMant  = 52;
+  static constexpr int kBias  = 1022;
+  static constexpr int kMask  = 0x7FF;
+  static constexpr int kScale = 54;
+};
+
+// The implementations below are written with the generic operations of any
+// backend, for a vector type T of floating point numbers and a vector type B
+// of integers of the same width and number of lanes. The bits are moved
+// between the two through memory, which compilers turn into register moves.
+
+template <typename To, typename From>
+VECCORE_FORCE_INLINE
+To BitCast(const From &x)
+{
+  static_assert(sizeof(Scalar<To>) == sizeof(Scalar<From>) && VectorSize<To>() == VectorSize<From>(),
+                "bits can only be cast between vectors of the same size");
+
+  Scalar<From> in[VectorSize<From>()];
+  Scalar<To> out[VectorSize<To>()];
+  Store(x, in);
+  std::memcpy(out, in, sizeof(in));
+
+  To y;
+  Load(y, out);
+  return y;
+}
+
+template <typename To, typename From>
+VECCORE_FORCE_INLINE
+To ConvertBits(const From &x, std::true_type)
+{
+  return x;
+}
+
+template <typename To, typename From>
+VECCORE_FORCE_INLINE
+To ConvertBits(const From &x, std::false_type)
+{
+  return Convert<To>(x);
+}
+
+// Conversion between exponents and integers of the width of the bits
+template <typename To, typename From>
+VECCORE_FORCE_INLINE
+To ConvertBits(const From &x)
+{
+  return ConvertBits<To>(x, std::is_same<To, From>());
+}
+
+// 2^n for kMin <= n <= kMax
+template <typename T, typename B>
+VECCORE_FORCE_INLINE
+T Pow2Bits(const B &n)
+{
+  using F = ExponentField<Scalar<T>>;
+  using I = Scalar<B>;
+  return BitCast<T>(B((n + B(I(F::kBias + 1))) << F::kMant));
+}
+
+// As in the Agner backend, subnormal inputs are scaled up first
+template <typename B, typename T>
+VECCORE_FORCE_INLINE
+T FrexpBits(const T &x, Exponent<T> *exp)
+{
+  using F = ExponentField<Scalar<T>>;
+  using I = Scalar<B>;
+
+  const B zero(I(0)), emask(I(F::kMask));
+
+  B bits = BitCast<B>(x);
+  B e    = (bits >> F::kMant) & emask;
+
+  Mask<B> sub = e == zero;
+  B adj       = Blend(sub, B(I(F::kScale)), zero);
+  bits        = Blend(sub, BitCast<B>(T(x * Pow2Bits<T>(B(I(F::kScale))))), bits);
+
+  B es            = (bits >> F::kMant) & emask;
+  Mask<B> special = es == zero || e == emask;
+  *exp            = ConvertBits<Exponent<T>>(B(Blend(special, zero, B(es - B(I(F::kBias)) - adj))));
+
+  B m = (bits & B(I(~(I(F::kMask) << F::kMant)))) | B(I(I(F::kBias) << F::kMant));
+  return BitCast<T>(B(Blend(special, BitCast<B>(x), m)));
+}
+
+// Multiplication in steps such that only the last one can round, as in
+// musl's scalbn()
+template <typename B, typename T>
+VECCORE_FORCE_INLINE
+T LdexpBits(const T &x, const Exponent<T> &exp)
+{
+  using F = ExponentField<Scalar<T>>;
+  using I = Scalar<B>;
+
+  const B zero(I(0)), kMax(I(F::kBias + 1)), kMin(I(-F::kBias)), kStep(I(-F::kBias + F::kMant + 1));
+
+  B n = ConvertBits<B>(exp), s;
+  T y = x;
+  for (int i = 0; i < 2; ++i) {
+    s = Blend(n > kMax, kMax, zero);
+    y *= Pow2Bits<T>(s);
+    n -= s;
+  }
+  for (int i = 0; i < 2; ++i) {
+    s = Blend(n < kMin, kStep, zero);
+    y *= Pow2Bits<T>(s);
+    n -= s;
+  }
+  n = Blend(n > kMax, kMax, n);
+  n = Blend(n < kMin, kMin, n);
+  return y * Pow2Bits<T>(n);
+}
+
+template <typename B, typename T>
+VECCORE_FORCE_INLINE
+Exponent<T> IlogbBits(const T &x)
+{
+  using F = ExponentField<Scalar<T>>;
+  using I = Scalar<B>;
+
+  const B inf(I(I(F::kMask) << F::kMant));
+  B bits = BitCast<B>(x) & B(std::numeric_limits<I>::max());
+
+  Exponent<T> exp;
+  FrexpBits<B>(x, &exp);
+
+  B e = ConvertBits<B>(exp);
+  e   = Blend(bits == B(I(0)), B(I(FP_ILOGB0)), B(e - B(I(1))));
+  e   = Blend(bits == inf, B(I(INT_MAX)), e);
+  return ConvertBits<Exponent<T>>(B(Blend(bits > inf, B(I(FP_ILOGBNAN)), e)));
+}
+
+} // namespace detail
+} // namespace math
+} // namespace vecCore
+
+#endif
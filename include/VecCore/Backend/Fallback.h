@@ -0,0 +1,190 @@
+#ifndef VECCORE_BACKEND_FALLBACK_H
+#define VECCORE_BACKEND_FALLBACK_H
+
+// Uses of the generic implementations in Implementation.h, which process
+// vectors one lane at a time, by types with more than one lane. These are
+// the operations a backend does not specialize, e.g. Gather() or Convert().
+//
+// With VECCORE_REPORT_FALLBACKS defined, each use is counted per operation
+// and type at run time, and a report is written to stderr at exit.
+//
+// With VECCORE_STRICT_FALLBACKS defined, a use is a compile error for types
+// with StrictFallback<T>::value true, which is all types with more than one
+// lane unless specialized, e.g. to allow fallbacks for types which are not
+// performance critical:
+//
+//   template <> struct StrictFallback<vcl::Vec16s> : std::false_type {};
+//
+// Without either, the checks are compiled out. Functions of VecMath.h with
+// only the generic implementation call the standard library, and do not
+// compile for vector types at all, so they need no check.
+
+#include <type_traits>
+
+#if defined(VECCORE_REPORT_FALLBACKS) && !defined(VECCORE_CUDA)
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <typeinfo>
+#include <vector>
+
+#if defined(__GNUG__)
+#include <cxxabi.h>
+#endif
+#endif
+
+namespace vecCore {
+
+template <typename T>
+struct StrictFallback : std::integral_constant<bool, (VectorSize<T>() > 1)> {
+};
+
+// The type T, made dependent on U for the checks in member templates of
+// explicit specializations, which would otherwise fail at their definition
+template <typename T, typename U>
+struct FallbackType {
+  using type = T;
+};
+
+#if defined(VECCORE_REPORT_FALLBACKS) && !defined(VECCORE_CUDA)
+
+namespace fallback {
+
+// Readable name of type T, e.g. vcl::Vec8f
+template <typename T>
+std::string TypeName()
+{
+  const char *name = typeid(T).name();
+#if defined(__GNUG__)
+  int status      = 0;
+  char *demangled = abi::__cxa_demangle(name, nullptr, nullptr, &status);
+  if (status == 0 && demangled) {
+    std::string result(demangled);
+    free(demangled);
+    return result;
+  }
+#endif
+  return name;
+}
+
+class Counter {
+public:
+  Counter(const char *operation, std::string type) : fOperation(operation), fType(std::move(type)), fCount(0) {}
+
+  Counter(const Counter &) = delete;
+  Counter &operator=(const Counter &) = delete;
+
+  void Increment() { fCount.fetch_add(1, std::memory_order_relaxed); }
+
+  const char *Operation() const { return fOperation; }
+  const std::string &Type() const { return fType; }
+  uint64_t Count() const { return fCount.load(std::memory_order_relaxed); }
+
+private:
+  const char *fOperation;
+  std::string fType;
+  std::atomic<uint64_t> fCount;
+};
+
+// All fallbacks used so far. The registry is never destroyed, so that uses
+// during the destruction of static objects can still be counted.
+class Registry {
+public:
+  static Registry &Instance()
+  {
+    static Registry *registry = new Registry();
+    return *registry;
+  }
+
+  Registry(const Registry &) = delete;
+  Registry &operator=(const Registry &) = delete;
+
+  Counter &Add(const char *operation, std::string type)
+  {
+    std::lock_guard<std::mutex> lock(fMutex);
+    fCounters.emplace_back(new Counter(operation, std::move(type)));
+    return *fCounters.back();
+  }
+
+  // Number of uses of a fallback by type T, over all places it is used from
+  template <typename T>
+  uint64_t Count(const char *operation) const
+  {
+    const std::string type = TypeName<T>();
+
+    std::lock_guard<std::mutex> lock(fMutex);
+    uint64_t count = 0;
+    for (auto &counter : fCounters)
+      if (strcmp(counter->Operation(), operation) == 0 && counter->Type() == type) count += counter->Count();
+    return count;
+  }
+
+  void Report(FILE *out) const
+  {
+    std::lock_guard<std::mutex> lock(fMutex);
+
+    // sum counters of the same operation and type
+    std::vector<std::pair<std::string, uint64_t>> totals;
+    for (auto &counter : fCounters) {
+      std::string key = std::string(counter->Operation()) + " " + counter->Type();
+      auto it         = std::find_if(totals.begin(), totals.end(),
+                             [&](const std::pair<std::string, uint64_t> &t) { return t.first == key; });
+      if (it == totals.end())
+        totals.emplace_back(key, counter->Count());
+      else
+        it->second += counter->Count();
+    }
+
+    if (totals.empty()) return;
+
+    std::stable_sort(totals.begin(), totals.end(),
+                     [](const std::pair<std::string, uint64_t> &a, const std::pair<std::string, uint64_t> &b) {
+                       return a.second > b.second;
+                     });
+
+    fprintf(out, "\nVecCore generic fallbacks, by number of calls\n\n");
+    for (auto &t : totals)
+      fprintf(out, "%16llu  %s\n", (unsigned long long)t.second, t.first.c_str());
+  }
+
+private:
+  Registry() { std::atexit([] { Instance().Report(stderr); }); }
+
+  mutable std::mutex fMutex;
+  std::vector<std::unique_ptr<Counter>> fCounters;
+};
+
+} // namespace fallback
+
+// One counter per place and type, created on the first use
+#define VECCORE_FALLBACK_COUNT(T, operation)                                                   \
+  if (VectorSize<T>() > 1) {                                                                   \
+    static vecCore::fallback::Counter &counter =                                               \
+        vecCore::fallback::Registry::Instance().Add(operation, vecCore::fallback::TypeName<T>()); \
+    counter.Increment();                                                                       \
+  }
+#else
+#define VECCORE_FALLBACK_COUNT(T, operation)
+#endif
+
+#if defined(VECCORE_STRICT_FALLBACKS)
+#define VECCORE_FALLBACK_CHECK(T, operation) \
+  static_assert(!StrictFallback<T>::value, "generic fallback of " operation " used with VECCORE_STRICT_FALLBACKS");
+#else
+#define VECCORE_FALLBACK_CHECK(T, operation)
+#endif
+
+// Marks the generic implementation of an operation for type T
+#define VECCORE_FALLBACK(T, operation) \
+  VECCORE_FALLBACK_CHECK(T, operation) \
+  VECCORE_FALLBACK_COUNT(T, operation)
+
+} // namespace vecCore
+
+#endif
@@ -2,6 +2,7 @@
 #define VECCORE_BACKEND_IMPLEMENTATION_H
 
 #include "Interface.h"
+#include "Fallback.h"
 #include "../Limits.h"
 
 #include <algorithm>
@@ -9,13 +10,19 @@
 
 namespace vecCore {
 
+// Number of lanes of T, from its size unless a backend specializes it, e.g.
+// for masks held as full vectors or as bits
+
+template <typename T>
+struct VectorSizeTraits : std::integral_constant<Size_s, sizeof(T) / sizeof(Scalar<T>)> {
+};
+
 template <typename T>
 VECCORE_FORCE_INLINE
 VECCORE_ATT_HOST_DEVICE
 constexpr Size_s VectorSize()
 {
-  using V = typename std::decay<T>::type;
-  return sizeof(V) / sizeof(Scalar<V>);
+  return VectorSizeTraits<typename std::decay<T>::type>::value;
 }
 
 // Iterators
@@ -116,6 +123,7 @@ struct LoadStoreImplementation {
   VECCORE_ATT_HOST_DEVICE
   static void Load(T &v, S const *ptr)
   {
+    VECCORE_FALLBACK(T, "Load")
     for (size_t i = 0; i < VectorSize<T>(); ++i)
       Set(v, i, ptr[i]);
   }
@@ -125,6 +133,7 @@ struct LoadStoreImplementation {
   VECCORE_ATT_HOST_DEVICE
   static void Store(T const &v, S *ptr)
   {
+    VECCORE_FALLBACK(T, "Store")
     for (size_t i = 0; i < VectorSize<T>(); ++i)
       ptr[i]      = static_cast<S>(Get(v, i));
   }
@@ -146,6 +155,91 @@ void Store(T const &v, Scalar<T> *ptr)
   LoadStoreImplementation<T>::template Store(v, ptr);
 }
 
+// Aligned and non-temporal Load/Store, which fall back to Load() and Store()
+// for backends without them
+
+template <typename T>
+struct AlignedLoadStoreImplementation {
+  template <typename S = Scalar<T>>
+  VECCORE_FORCE_INLINE
+  VECCORE_ATT_HOST_DEVICE
+  static void LoadAligned(T &v, S const *ptr)
+  {
+    LoadStoreImplementation<T>::template Load<S>(v, ptr);
+  }
+
+  template <typename S = Scalar<T>>
+  VECCORE_FORCE_INLINE
+  VECCORE_ATT_HOST_DEVICE
+  static void StoreAligned(T const &v, S *ptr)
+  {
+    LoadStoreImplementation<T>::template Store<S>(v, ptr);
+  }
+
+  template <typename S = Scalar<T>>
+  VECCORE_FORCE_INLINE
+  VECCORE_ATT_HOST_DEVICE
+  static void StoreStreaming(T const &v, S *ptr)
+  {
+    LoadStoreImplementation<T>::template Store<S>(v, ptr);
+  }
+};
+
+template <typename T>
+VECCORE_FORCE_INLINE
+VECCORE_ATT_HOST_DEVICE
+void LoadAligned(T &v, Scalar<T> const *ptr)
+{
+  AlignedLoadStoreImplementation<T>::template LoadAligned(v, ptr);
+}
+
+template <typename T>
+VECCORE_FORCE_INLINE
+VECCORE_ATT_HOST_DEVICE
+void StoreAligned(T const &v, Scalar<T> *ptr)
+{
+  AlignedLoadStoreImplementation<T>::template StoreAligned(v, ptr);
+}
+
+template <typename T>
+VECCORE_FORCE_INLINE
+VECCORE_ATT_HOST_DEVICE
+void StoreStreaming(T const &v, Scalar<T> *ptr)
+{
+  AlignedLoadStoreImplementation<T>::template StoreStreaming(v, ptr);
+}
+
+VECCORE_FORCE_INLINE
+VECCORE_ATT_HOST_DEVICE
+void StoreFence()
+{
+#if !defined(VECCORE_CUDA_DEVICE_COMPILATION) && defined(__SSE__)
+  _mm_sfence();
+#endif
+}
+
+// Prefetching
+
+namespace detail {
+VECCORE_ATT_HOST_DEVICE
+constexpr int PrefetchLocality(PrefetchHint hint)
+{
+  return hint == PrefetchHint::NTA ? 0 : hint == PrefetchHint::T2 ? 1 : hint == PrefetchHint::T1 ? 2 : 3;
+}
+}
+
+template <PrefetchHint Hint>
+VECCORE_FORCE_INLINE
+VECCORE_ATT_HOST_DEVICE
+void Prefetch(void const *ptr)
+{
+#if !defined(VECCORE_CUDA_DEVICE_COMPILATION) && (defined(__GNUC__) || defined(__clang__))
+  __builtin_prefetch(ptr, Hint == PrefetchHint::Write ? 1 : 0, detail::PrefetchLocality(Hint));
+#else
+  (void)ptr;
+#endif
+}
+
 // Gather/Scatter
 
 template <typename T>
@@ -155,6 +249,7 @@ struct GatherScatterImplementation {
   VECCORE_ATT_HOST_DEVICE
   static void Gather(T &v, S const *ptr, Index<T> const &idx)
   {
+    VECCORE_FALLBACK(T, "Gather")
     for (size_t i = 0; i < VectorSize<T>(); ++i)
       Set(v, i, ptr[Get(idx, i)]);
   }
@@ -164,6 +259,7 @@ struct GatherScatterImplementation {
   VECCORE_ATT_HOST_DEVICE
   static void Scatter(T const &v, S *ptr, Index<T> const &idx)
   {
+    VECCORE_FALLBACK(T, "Scatter")
     for (size_t i = 0; i < VectorSize<T>(); ++i)
       ptr[Get(idx, i)] = Get(v, i);
   }
@@ -187,11 +283,84 @@ void Scatter(T const &v, S *ptr, Index<T> const &idx)
   GatherScatterImplementation<T>::template Scatter<S>(v, ptr, idx);
 }
 
+// Conflict Detection
+
+// The generic implementation sorts the lanes by index (insertion sort, which is
+// stable and cheap for the small number of lanes in a vector), and then walks
+// over runs of equal indices. Backends with hardware conflict detection (e.g.
+// AVX-512CD) specialize this structure.
+
+template <typename I>
+struct ConflictImplementation {
+  VECCORE_FORCE_INLINE
+  VECCORE_ATT_HOST_DEVICE
+  static void SortLanes(size_t *lane, const I &idx)
+  {
+    for (size_t i = 0; i < VectorSize<I>(); ++i) {
+      size_t j = i;
+      for (; j > 0 && Get(idx, i) < Get(idx, lane[j - 1]); --j)
+        lane[j] = lane[j - 1];
+      lane[j] = i;
+    }
+  }
+
+  VECCORE_FORCE_INLINE
+  VECCORE_ATT_HOST_DEVICE
+  static Bool_s Free(const I &idx)
+  {
+    VECCORE_FALLBACK(I, "ConflictFree")
+    size_t lane[VectorSize<I>()];
+    SortLanes(lane, idx);
+
+    for (size_t k = 1; k < VectorSize<I>(); ++k)
+      if (Get(idx, lane[k]) == Get(idx, lane[k - 1])) return false;
+    return true;
+  }
+
+  template <typename T>
+  VECCORE_FORCE_INLINE
+  VECCORE_ATT_HOST_DEVICE
+  static void PrefixSum(T &sum, const T &v, const I &idx)
+  {
+    static_assert(VectorSize<I>() == VectorSize<T>(), "Index and value vectors must have the same size");
+    VECCORE_FALLBACK(I, "ConflictPrefixSum")
+
+    size_t lane[VectorSize<I>()];
+    SortLanes(lane, idx);
+
+    Scalar<T> acc(0);
+    for (size_t k = 0; k < VectorSize<I>(); ++k) {
+      if (k == 0 || Get(idx, lane[k]) != Get(idx, lane[k - 1])) acc = Scalar<T>(0);
+      acc += Get(v, lane[k]);
+      Set(sum, lane[k], acc);
+    }
+  }
+};
+
+template <typename I>
+VECCORE_FORCE_INLINE
+VECCORE_ATT_HOST_DEVICE
+Bool_s ConflictFree(const I &idx)
+{
+  return ConflictImplementation<I>::Free(idx);
+}
+
+template <typename T>
+VECCORE_FORCE_INLINE
+VECCORE_ATT_HOST_DEVICE
+T ConflictPrefixSum(const T &v, const Index<T> &idx)
+{
+  T sum;
+  ConflictImplementation<Index<T>>::template PrefixSum<T>(sum, v, idx);
+  return sum;
+}
+
 // Masking
 
 template <typename M>
 Bool_s MaskFull(const M &mask)
 {
+  VECCORE_FALLBACK(M, "MaskFull")
   for (size_t i = 0; i < VectorSize<M>(); i++)
     if (Get(mask, i) == false) return false;
   return true;
@@ -200,6 +369,7 @@ Bool_s MaskFull(const M &mask)
 template <typename M>
 Bool_s MaskEmpty(const M &mask)
 {
+  VECCORE_FALLBACK(M, "MaskEmpty")
   for (size_t i = 0; i < VectorSize<M>(); i++)
     if (Get(mask, i) == true) return false;
   return true;
@@ -213,6 +383,7 @@ struct GenericMaskingImplementation {
   VECCORE_ATT_HOST_DEVICE
   static void Assign(T &dst, Mask<T> const &mask, T const &src)
   {
+    VECCORE_FALLBACK(T, "MaskedAssign")
     for (size_t i = 0; i < VectorSize<T>(); i++)
       if (Get(mask, i)) Set(dst, i, Get(src, i));
   }
@@ -221,6 +392,7 @@ struct GenericMaskingImplementation {
   VECCORE_ATT_HOST_DEVICE
   static void Blend(T &dst, Mask<T> const &mask, T const &src1, T const &src2)
   {
+    VECCORE_FALLBACK(T, "Blend")
     for (size_t i = 0; i < VectorSize<T>(); i++)
       Set(dst, i, Get(mask, i) ? Get(src1, i) : Get(src2, i));
   }
@@ -300,6 +472,7 @@ VECCORE_FORCE_INLINE
 VECCORE_ATT_HOST_DEVICE
 Scalar<T> ReduceAdd(const T& v)
 {
+   VECCORE_FALLBACK(T, "ReduceAdd")
    Scalar<T> result(0);
    for (size_t i = 0; i < VectorSize<T>(); ++i)
       result += Get(v, i);
@@ -311,6 +484,7 @@ VECCORE_FORCE_INLINE
 VECCORE_ATT_HOST_DEVICE
 Scalar<T> ReduceMin(const T& v)
 {
+   VECCORE_FALLBACK(T, "ReduceMin")
    Scalar<T> result(NumericLimits<Scalar<T>>::Max());
    for (size_t i = 0; i < VectorSize<T>(); ++i)
       result = std::min(result, Get(v, i));
@@ -322,18 +496,138 @@ VECCORE_FORCE_INLINE
 VECCORE_ATT_HOST_DEVICE
 Scalar<T> ReduceMax(const T& v)
 {
+   VECCORE_FALLBACK(T, "ReduceMax")
    Scalar<T> result(NumericLimits<Scalar<T>>::Lowest());
    for (size_t i = 0; i < VectorSize<T>(); ++i)
       result = std::max(result, Get(v, i));
    return result;
 }
 
+template <typename T>
+struct TransposedReductionImplementation {
+  template <size_t N>
+  VECCORE_FORCE_INLINE
+  VECCORE_ATT_HOST_DEVICE
+  static T AddN(const T (&v)[N])
+  {
+    VECCORE_FALLBACK(T, "ReduceAddN")
+    T result(Scalar<T>(0));
+    for (size_t i = 0; i < N; ++i)
+      Set(result, i, ReduceAdd(v[i]));
+    return result;
+  }
+};
+
+template <typename T>
+struct ReductionImplementation {
+  VECCORE_FORCE_INLINE
+  VECCORE_ATT_HOST_DEVICE
+  static size_t MinIndex(const T &v)
+  {
+    VECCORE_FALLBACK(T, "ReduceMinIndex")
+    size_t index  = 0;
+    Scalar<T> min = Get(v, 0);
+    for (size_t i = 1; i < VectorSize<T>(); ++i) {
+      if (Get(v, i) < min) {
+        min   = Get(v, i);
+        index = i;
+      }
+    }
+    return index;
+  }
+
+  VECCORE_FORCE_INLINE
+  VECCORE_ATT_HOST_DEVICE
+  static size_t MaxIndex(const T &v)
+  {
+    VECCORE_FALLBACK(T, "ReduceMaxIndex")
+    size_t index  = 0;
+    Scalar<T> max = Get(v, 0);
+    for (size_t i = 1; i < VectorSize<T>(); ++i) {
+      if (Get(v, i) > max) {
+        max   = Get(v, i);
+        index = i;
+      }
+    }
+    return index;
+  }
+};
+
+template <typename T, size_t N>
+VECCORE_FORCE_INLINE
+VECCORE_ATT_HOST_DEVICE
+T ReduceAddN(const T (&v)[N])
+{
+  static_assert(N <= VectorSize<T>(), "ReduceAddN needs at most one vector per lane");
+  return TransposedReductionImplementation<T>::template AddN<N>(v);
+}
+
+template <typename T>
+VECCORE_FORCE_INLINE
+VECCORE_ATT_HOST_DEVICE
+size_t ReduceMinIndex(const T& v)
+{
+  return ReductionImplementation<T>::MinIndex(v);
+}
+
+template <typename T>
+VECCORE_FORCE_INLINE
+VECCORE_ATT_HOST_DEVICE
+size_t ReduceMaxIndex(const T& v)
+{
+  return ReductionImplementation<T>::MaxIndex(v);
+}
+
+template <typename T, typename I>
+VECCORE_FORCE_INLINE
+VECCORE_ATT_HOST_DEVICE
+void MinIndex(T &a, const T &b, I &ia, const I &ib)
+{
+  Mask<T> mask = b < a;
+  MaskedAssign(a, mask, b);
+  MaskedAssign(ia, Mask<I>(mask), ib);
+}
+
+template <typename T, typename I>
+VECCORE_FORCE_INLINE
+VECCORE_ATT_HOST_DEVICE
+void MaxIndex(T &a, const T &b, I &ia, const I &ib)
+{
+  Mask<T> mask = b > a;
+  MaskedAssign(a, mask, b);
+  MaskedAssign(ia, Mask<I>(mask), ib);
+}
+
+template <typename W, typename T>
+struct WideningImplementation {
+  VECCORE_FORCE_INLINE
+  VECCORE_ATT_HOST_DEVICE
+  static W Widen(const T &v, size_t part)
+  {
+    VECCORE_FALLBACK(T, "Widen")
+    W out(Scalar<W>(0));
+    for (size_t i = 0; i < VectorSize<W>(); ++i)
+      Set(out, i, Scalar<W>(Get(v, part * VectorSize<W>() + i)));
+    return out;
+  }
+};
+
+template <typename W, typename T>
+VECCORE_FORCE_INLINE
+VECCORE_ATT_HOST_DEVICE
+W Widen(const T &v, size_t part)
+{
+  static_assert(VectorSize<T>() % VectorSize<W>() == 0, "Cannot widen to a type with more lanes");
+  return WideningImplementation<W, T>::Widen(v, part);
+}
+
 template<typename Vout, typename Vin>
 Vout Convert(const Vin& v)
 {
    Vout out;
    static_assert(VectorSize<Vin>() == VectorSize<Vout>(),
                  "Cannot convert SIMD vectors of different sizes");
+   VECCORE_FALLBACK(Vin, "Convert")
    for (size_t i = 0; i < VectorSize<Vin>(); ++i)
       Set(out, i, Get(v, i));
    return out;
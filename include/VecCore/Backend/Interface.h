@@ -15,6 +15,38 @@ using Index = typename TypeTraits<T>::IndexType;
 template <typename T>
 using Scalar = typename TypeTraits<T>::ScalarType;
 
+// Signed integer type with one element for each element of T, used to hold
+// binary exponents in Frexp(), Ldexp() and Ilogb()
+
+template <typename T>
+struct ExponentTraits;
+
+template <typename T>
+using Exponent = typename ExponentTraits<T>::Type;
+
+// Capabilities of the operations of VecCore for T, as
+// std::integral_constant<bool, ...>, for selecting algorithms at compile
+// time, e.g. gathering data or recomputing it.
+//
+// HasNativeGather<T>: Gather() from arrays of Scalar<T> uses gather
+//                     instructions, e.g. vgatherdps with AVX2
+// HasFMA<T>:          FMA() uses fused multiply-add instructions
+// IsHardwareMask<M>:  M is held in mask registers, one bit per lane
+//
+// Types of one lane gather natively, since they load a single element, and
+// have FMA when it is enabled. Vector types have a capability only when
+// their backend implements the operation with those instructions, which
+// depends on the instruction set of the build.
+
+template <typename T>
+struct HasNativeGather;
+
+template <typename T>
+struct HasFMA;
+
+template <typename M>
+struct IsHardwareMask;
+
 // Iterators
 
 template <typename T>
@@ -68,6 +100,40 @@ VECCORE_FORCE_INLINE
 VECCORE_ATT_HOST_DEVICE
 void Store(T const &v, Scalar<T> *ptr);
 
+// Aligned and non-temporal Load/Store, for pointers aligned to the size of T.
+// Streaming stores bypass the cache, for results which are not read again
+// soon, and are ordered with other stores only after StoreFence().
+
+template <typename T>
+VECCORE_FORCE_INLINE
+VECCORE_ATT_HOST_DEVICE
+void LoadAligned(T &v, Scalar<T> const *ptr);
+
+template <typename T>
+VECCORE_FORCE_INLINE
+VECCORE_ATT_HOST_DEVICE
+void StoreAligned(T const &v, Scalar<T> *ptr);
+
+template <typename T>
+VECCORE_FORCE_INLINE
+VECCORE_ATT_HOST_DEVICE
+void StoreStreaming(T const &v, Scalar<T> *ptr);
+
+VECCORE_FORCE_INLINE
+VECCORE_ATT_HOST_DEVICE
+void StoreFence();
+
+// Prefetching into all cache levels (T0), into L2 and below (T1), into L3 and
+// below (T2), or close to the processor without polluting the caches (NTA),
+// or for writing (Write)
+
+enum class PrefetchHint { T0, T1, T2, NTA, Write };
+
+template <PrefetchHint Hint = PrefetchHint::T0>
+VECCORE_FORCE_INLINE
+VECCORE_ATT_HOST_DEVICE
+void Prefetch(void const *ptr);
+
 // Gather/Scatter
 
 template <typename T, typename S = Scalar<T>>
@@ -80,6 +146,18 @@ VECCORE_FORCE_INLINE
 VECCORE_ATT_HOST_DEVICE
 void Scatter(T const &v, S *ptr, Index<T> const &idx);
 
+// Conflict Detection
+
+template <typename I>
+VECCORE_FORCE_INLINE
+VECCORE_ATT_HOST_DEVICE
+Bool_s ConflictFree(const I &idx);
+
+template <typename T>
+VECCORE_FORCE_INLINE
+VECCORE_ATT_HOST_DEVICE
+T ConflictPrefixSum(const T &v, const Index<T> &idx);
+
 // Masking/Blending
 
 template <typename M>
@@ -128,6 +206,47 @@ VECCORE_FORCE_INLINE
 VECCORE_ATT_HOST_DEVICE
 Scalar<T> ReduceMax(const T& v);
 
+// Vector with the sum of the lanes of v[i] in lane i, for N <= VectorSize<T>().
+// Lanes from N on are zero.
+
+template <typename T, size_t N>
+VECCORE_FORCE_INLINE
+VECCORE_ATT_HOST_DEVICE
+T ReduceAddN(const T (&v)[N]);
+
+// Lane of the smallest or largest element, the first one for ties
+
+template <typename T>
+VECCORE_FORCE_INLINE
+VECCORE_ATT_HOST_DEVICE
+size_t ReduceMinIndex(const T& v);
+
+template <typename T>
+VECCORE_FORCE_INLINE
+VECCORE_ATT_HOST_DEVICE
+size_t ReduceMaxIndex(const T& v);
+
+// Lane-wise minimum or maximum of a and b, stored in a, with ia updated to ib
+// in the lanes where b wins. Lanes where a and b are equal keep a and ia.
+
+template <typename T, typename I>
+VECCORE_FORCE_INLINE
+VECCORE_ATT_HOST_DEVICE
+void MinIndex(T &a, const T &b, I &ia, const I &ib);
+
+template <typename T, typename I>
+VECCORE_FORCE_INLINE
+VECCORE_ATT_HOST_DEVICE
+void MaxIndex(T &a, const T &b, I &ia, const I &ib);
+
+// Lanes part * VectorSize<W>() to (part + 1) * VectorSize<W>() - 1 of v,
+// converted to the wider type W with fewer lanes, e.g. Double_v for Float_v
+
+template <typename W, typename T>
+VECCORE_FORCE_INLINE
+VECCORE_ATT_HOST_DEVICE
+W Widen(const T &v, size_t part);
+
 } // namespace vecCore
 
 #endif
@@ -13,6 +13,30 @@ struct TypeTraits {
   using IndexType  = Size_s;
 };
 
+template <typename T>
+struct ExponentTraits {
+  using Type = Int_s;
+};
+
+template <typename T>
+struct HasNativeGather : std::integral_constant<bool, VectorSize<T>() == 1> {
+};
+
+// Compilers contract a * b + c in FMA() for scalars, when FMA is enabled
+#if defined(__FMA__) || defined(__FMA4__) || defined(VECCORE_CUDA_DEVICE_COMPILATION)
+template <typename T>
+struct HasFMA : std::integral_constant<bool, VectorSize<T>() == 1 && std::is_floating_point<Scalar<T>>::value> {
+};
+#else
+template <typename T>
+struct HasFMA : std::false_type {
+};
+#endif
+
+template <typename M>
+struct IsHardwareMask : std::false_type {
+};
+
 namespace backend {
 
 template <typename T = Real_s>
@@ -24,6 +24,11 @@ struct TypeTraits<WrappedScalar<T>> {
   using IndexType  = WrappedScalar<Size_s>;
 };
 
+template <typename T>
+struct ExponentTraits<WrappedScalar<T>> {
+  using Type = WrappedScalar<Int_s>;
+};
+
 namespace backend {
 
 template <typename T = Real_s>
@@ -2,6 +2,8 @@
 #ifndef VECCORE_UMESIMDCOMMON_H
 #define VECCORE_UMESIMDCOMMON_H
 
+#include "ExponentBits.h"
+
 namespace vecCore {
 
 // type traits for UME::SIMD
@@ -13,6 +15,11 @@ struct TypeTraits<UME::SIMD::SIMDVecMask<N>> {
   using ScalarType = Bool_s;
 };
 
+// the masks hold one bool or one bit per lane, depending on the target
+template <uint32_t N>
+struct VectorSizeTraits<UME::SIMD::SIMDVecMask<N>> : std::integral_constant<Size_s, N> {
+};
+
 template <typename T, uint32_t N>
 struct TypeTraits<UME::SIMD::SIMDVec_f<T, N>> {
   using ScalarType = T;
@@ -20,6 +27,11 @@ struct TypeTraits<UME::SIMD::SIMDVec_f<T, N>> {
   using IndexType  = typename UME::SIMD::SIMDVec_u<uint32_t, N>;
 };
 
+template <typename T, uint32_t N>
+struct ExponentTraits<UME::SIMD::SIMDVec_f<T, N>> {
+  using Type = typename UME::SIMD::SIMDVec_i<int32_t, N>;
+};
+
 template <typename T, uint32_t N>
 struct TypeTraits<UME::SIMD::SIMDVec_i<T, N>> {
   using ScalarType = T;
@@ -34,6 +46,13 @@ struct TypeTraits<UME::SIMD::SIMDVec_u<T, N>> {
   using IndexType  = typename UME::SIMD::SIMDVec_u<uint32_t, N>;
 };
 
+// FMA() uses fmuladd(), which is fused when FMA instructions are enabled, as
+// for scalars, see Interface.h. Gather() does not use gather instructions.
+
+template <typename T, uint32_t N>
+struct HasFMA<UME::SIMD::SIMDVec_f<T, N>> : HasFMA<T> {
+};
+
 // backend functions for UME::SIMD
 
 template <uint32_t N>
@@ -79,6 +98,30 @@ struct LoadStoreImplementation<UME::SIMD::SIMDVec_f<T, N>> {
   }
 };
 
+template <typename T, uint32_t N>
+struct AlignedLoadStoreImplementation<UME::SIMD::SIMDVec_f<T, N>> {
+  using V = UME::SIMD::SIMDVec_f<T, N>;
+
+  template <typename S = Scalar<V>>
+  static inline void LoadAligned(V &v, S const *ptr)
+  {
+    v.loada(ptr);
+  }
+
+  template <typename S = Scalar<V>>
+  static inline void StoreAligned(V const &v, S *ptr)
+  {
+    v.storea(ptr);
+  }
+
+  // no non-temporal stores in UME::SIMD
+  template <typename S = Scalar<V>>
+  static inline void StoreStreaming(V const &v, S *ptr)
+  {
+    v.storea(ptr);
+  }
+};
+
 template <uint32_t N>
 struct LoadStoreImplementation<UME::SIMD::SIMDVecMask<N>> {
   using M = UME::SIMD::SIMDVecMask<N>;
@@ -150,6 +193,14 @@ UME::SIMD::SIMDVec_f<T, N> Pow(const UME::SIMD::SIMDVec_f<T, N> &x, const UME::S
   return (x.log() * y).exp();
 }
 
+template <typename T, uint32_t N>
+VECCORE_FORCE_INLINE
+UME::SIMD::SIMDVec_f<T, N> FMA(const UME::SIMD::SIMDVec_f<T, N> &a, const UME::SIMD::SIMDVec_f<T, N> &b,
+                               const UME::SIMD::SIMDVec_f<T, N> &c)
+{
+  return a.fmuladd(b, c);
+}
+
 #define UMESIMD_REAL_FUNC(f, name)                                                                \
   template <typename T, uint32_t N>                                                               \
   VECCORE_FORCE_INLINE typename UME::SIMD::SIMDVec_f<T, N> f(const UME::SIMD::SIMDVec_f<T, N> &x) \
@@ -171,6 +222,32 @@ UMESIMD_REAL_FUNC(Ceil, ceil)
 
 #undef UMESIMD_REAL_FUNC
 
+// Frexp, Ldexp and Ilogb by manipulation of the exponent bits, see ExponentBits.h
+
+template <typename T, uint32_t N>
+using UMESimdExponentBits = UME::SIMD::SIMDVec_i<typename detail::ExponentField<T>::Bits, N>;
+
+template <typename T, uint32_t N>
+VECCORE_FORCE_INLINE
+UME::SIMD::SIMDVec_f<T, N> Frexp(const UME::SIMD::SIMDVec_f<T, N> &x, Exponent<UME::SIMD::SIMDVec_f<T, N>> *exp)
+{
+  return detail::FrexpBits<UMESimdExponentBits<T, N>>(x, exp);
+}
+
+template <typename T, uint32_t N>
+VECCORE_FORCE_INLINE
+UME::SIMD::SIMDVec_f<T, N> Ldexp(const UME::SIMD::SIMDVec_f<T, N> &x, const Exponent<UME::SIMD::SIMDVec_f<T, N>> &exp)
+{
+  return detail::LdexpBits<UMESimdExponentBits<T, N>>(x, exp);
+}
+
+template <typename T, uint32_t N>
+VECCORE_FORCE_INLINE
+Exponent<UME::SIMD::SIMDVec_f<T, N>> Ilogb(const UME::SIMD::SIMDVec_f<T, N> &x)
+{
+  return detail::IlogbBits<UMESimdExponentBits<T, N>>(x);
+}
+
 template <typename T, uint32_t N>
 VECCORE_FORCE_INLINE
 UME::SIMD::SIMDVecMask<N> IsInf(const UME::SIMD::SIMDVec_f<T, N> &x)
@@ -9,6 +9,10 @@ struct TypeTraits<Vc::Scalar::Mask<T>> {
   using ScalarType = Bool_s;
 };
 
+template <typename T>
+struct VectorSizeTraits<Vc::Scalar::Mask<T>> : std::integral_constant<Size_s, 1> {
+};
+
 template <typename T>
 struct TypeTraits<Vc::Scalar::Vector<T>> {
   using ScalarType = T;
@@ -16,6 +20,11 @@ struct TypeTraits<Vc::Scalar::Vector<T>> {
   using IndexType  = typename Vc::Scalar::Vector<T>::IndexType;
 };
 
+template <typename T>
+struct ExponentTraits<Vc::Scalar::Vector<T>> {
+  using Type = typename Vc::Scalar::Vector<T>::IndexType;
+};
+
 namespace backend {
 
 template <typename T = Real_s>
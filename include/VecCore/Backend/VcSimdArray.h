@@ -1,6 +1,8 @@
 #ifndef VECCORE_BACKEND_VC_SIMDARRAY_H
 #define VECCORE_BACKEND_VC_SIMDARRAY_H
 
+#include "ExponentBits.h"
+
 namespace vecCore {
 
 template <typename T, size_t N>
@@ -9,6 +11,10 @@ struct TypeTraits<Vc::SimdMaskArray<T, N>> {
   using IndexType  = size_t;
 };
 
+template <typename T, size_t N>
+struct VectorSizeTraits<Vc::SimdMaskArray<T, N>> : std::integral_constant<Size_s, N> {
+};
+
 template <typename T, size_t N>
 struct TypeTraits<Vc::SimdArray<T, N>> {
   using ScalarType = T;
@@ -16,6 +22,11 @@ struct TypeTraits<Vc::SimdArray<T, N>> {
   using IndexType  = typename Vc::SimdArray<T, N>::IndexType;
 };
 
+template <typename T, size_t N>
+struct ExponentTraits<Vc::SimdArray<T, N>> {
+  using Type = typename Vc::SimdArray<T, N>::IndexType;
+};
+
 namespace backend {
 
 template <size_t N = 16>
@@ -77,6 +88,29 @@ struct LoadStoreImplementation<Vc::SimdArray<T, N>> {
   }
 };
 
+template <typename T, size_t N>
+struct AlignedLoadStoreImplementation<Vc::SimdArray<T, N>> {
+  using V = Vc::SimdArray<T, N>;
+
+  template <typename S = Scalar<V>>
+  static inline void LoadAligned(V &v, S const *ptr)
+  {
+    v.load(ptr, Vc::Aligned);
+  }
+
+  template <typename S = Scalar<V>>
+  static inline void StoreAligned(V const &v, S *ptr)
+  {
+    v.store(ptr, Vc::Aligned);
+  }
+
+  template <typename S = Scalar<V>>
+  static inline void StoreStreaming(V const &v, S *ptr)
+  {
+    v.store(ptr, Vc::Aligned | Vc::Streaming);
+  }
+};
+
 template <typename T, size_t N>
 struct LoadStoreImplementation<Vc::SimdMaskArray<T, N>> {
   using M = Vc::SimdMaskArray<T, N>;
@@ -139,6 +173,32 @@ Vc::SimdMaskArray<T, N> IsInf(const Vc::SimdArray<T, N> &x)
 {
   return Vc::isinf(x);
 }
+
+// Frexp, Ldexp and Ilogb by manipulation of the exponent bits, see ExponentBits.h
+
+template <typename T, size_t N>
+using VcExponentBits = Vc::SimdArray<typename detail::ExponentField<T>::Bits, N>;
+
+template <typename T, size_t N>
+VECCORE_FORCE_INLINE
+Vc::SimdArray<T, N> Frexp(const Vc::SimdArray<T, N> &x, Exponent<Vc::SimdArray<T, N>> *exp)
+{
+  return detail::FrexpBits<VcExponentBits<T, N>>(x, exp);
+}
+
+template <typename T, size_t N>
+VECCORE_FORCE_INLINE
+Vc::SimdArray<T, N> Ldexp(const Vc::SimdArray<T, N> &x, const Exponent<Vc::SimdArray<T, N>> &exp)
+{
+  return detail::LdexpBits<VcExponentBits<T, N>>(x, exp);
+}
+
+template <typename T, size_t N>
+VECCORE_FORCE_INLINE
+Exponent<Vc::SimdArray<T, N>> Ilogb(const Vc::SimdArray<T, N> &x)
+{
+  return detail::IlogbBits<VcExponentBits<T, N>>(x);
+}
 }
 
 } // namespace vecCore
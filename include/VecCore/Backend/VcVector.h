@@ -9,6 +9,11 @@ struct TypeTraits<Vc::Mask<T>> {
   using ScalarType = Bool_s;
 };
 
+// Vc masks are vectors of the size of the data, not of one bool per lane
+template <typename T>
+struct VectorSizeTraits<Vc::Mask<T>> : std::integral_constant<Size_s, Vc::Mask<T>::Size> {
+};
+
 template <typename T>
 struct TypeTraits<Vc::Vector<T>> {
   using ScalarType = T;
@@ -16,6 +21,11 @@ struct TypeTraits<Vc::Vector<T>> {
   using IndexType  = typename Vc::Vector<T>::IndexType;
 };
 
+template <typename T>
+struct ExponentTraits<Vc::Vector<T>> {
+  using Type = typename Vc::Vector<T>::IndexType;
+};
+
 namespace backend {
 
 template <typename T = Real_s>
@@ -78,6 +88,29 @@ struct LoadStoreImplementation<Vc::Vector<T>> {
   }
 };
 
+template <typename T>
+struct AlignedLoadStoreImplementation<Vc::Vector<T>> {
+  using V = Vc::Vector<T>;
+
+  template <typename S = Scalar<V>>
+  static inline void LoadAligned(V &v, S const *ptr)
+  {
+    v.load(ptr, Vc::Aligned);
+  }
+
+  template <typename S = Scalar<V>>
+  static inline void StoreAligned(V const &v, S *ptr)
+  {
+    v.store(ptr, Vc::Aligned);
+  }
+
+  template <typename S = Scalar<V>>
+  static inline void StoreStreaming(V const &v, S *ptr)
+  {
+    v.store(ptr, Vc::Aligned | Vc::Streaming);
+  }
+};
+
 template <typename T>
 struct LoadStoreImplementation<Vc::Mask<T>> {
   using M = Vc::Mask<T>;
@@ -140,6 +173,20 @@ Vc::Mask<T> IsInf(const Vc::Vector<T> &x)
 {
   return Vc::isinf(x);
 }
+
+template <typename T>
+VECCORE_FORCE_INLINE
+Vc::Vector<T> Frexp(const Vc::Vector<T> &x, Exponent<Vc::Vector<T>> *exp)
+{
+  return Vc::frexp(x, exp);
+}
+
+template <typename T>
+VECCORE_FORCE_INLINE
+Vc::Vector<T> Ldexp(const Vc::Vector<T> &x, const Exponent<Vc::Vector<T>> &exp)
+{
+  return Vc::ldexp(x, exp);
+}
 }
 
 } // namespace vecCore
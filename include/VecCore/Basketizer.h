@@ -0,0 +1,360 @@
+#ifndef VECCORE_BASKETIZER_H
+#define VECCORE_BASKETIZER_H
+
+#include "Backend/Interface.h"
+#include "Backend/Implementation.h"
+#include "AoSoA.h"
+#include "Utilities.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+
+namespace vecCore {
+
+// Batching of scalar work items from many producers into full vectors.
+//
+// Items with one field of each of the vector types Fields... are pushed one
+// at a time, from any number of threads, into baskets of a fixed capacity,
+// which is a multiple of the vector size. The fields of a basket are stored
+// as aligned arrays, a structure of arrays. A basket is consumed, by calling
+// the kernel with it, when it is full or when it is flushed, either
+// explicitly or by Poll() once its first item is older than the deadline:
+//
+//   struct Propagate {
+//     void operator()(const Basket<Double_v, Double_v, Int64_v> &b) const
+//     {
+//       for (size_t i = 0; i < b.GetNblocks(); ++i) {
+//         Double_v x = b.Field<0>(i), dx = b.Field<1>(i);
+//         Int64_v id = b.Field<2>(i);
+//         ... // scatter results back by id
+//       }
+//     }
+//   };
+//
+//   Basketizer<Propagate, Double_v, Double_v, Int64_v> baskets(Propagate(), 64);
+//
+//   baskets.Push(x, dx, id); // from each producer
+//   baskets.Poll();          // from time to time, consumes late baskets
+//   baskets.Flush();         // at the end, consumes what is left
+//
+// Pushing is lock-free as long as a basket is free: each item takes the next
+// ticket of a single counter, which gives its basket and its place in the
+// basket, and the producer filling the last place of a basket consumes it.
+// When all baskets are full or being consumed, producers wait for the next
+// one. Kernels run on the threads of the producers and of Poll() and Flush(),
+// so several baskets may be consumed at the same time, and neither Poll()
+// nor Flush() may be called by the kernel.
+//
+// Nor may the kernel push items into its own basketizer, e.g. secondary
+// particles produced by a transport kernel: the basket of such an item may be
+// the one the kernel is consuming, or one waiting for it, and Push() would
+// wait forever. Such items go to another basketizer, or are pushed after the
+// kernel returns.
+//
+// When a basket with fewer items than its capacity is flushed, the lanes
+// past the last item of its last block hold copies of its first item, so
+// that kernels may process whole blocks and ignore the values of these lanes.
+
+template <typename... Fields>
+class Basket {
+  static_assert(sizeof...(Fields) > 0, "Basket needs at least one field");
+  static_assert(detail::SameVectorSize<Fields...>::value, "fields of a Basket must have the same vector size");
+
+  template <typename T>
+  using Array_t = std::vector<Scalar<T>, AlignedAllocator<Scalar<T>, (alignof(T) > VECCORE_SIMD_ALIGN ? alignof(T)
+                                                                                                     : VECCORE_SIMD_ALIGN)>>;
+
+public:
+  template <size_t I>
+  using Field_t = typename std::tuple_element<I, std::tuple<Fields...>>::type;
+
+  template <size_t I>
+  using FieldScalar_t = Scalar<Field_t<I>>;
+
+  static constexpr size_t kFields = sizeof...(Fields);
+
+  static constexpr size_t BlockSize() { return VectorSize<Field_t<0>>(); }
+
+  explicit Basket(size_t capacity) : fArrays(Array_t<Fields>(capacity)...), fSize(0) {}
+
+  // Number of items, and of blocks holding them
+  size_t Size() const { return fSize; }
+  size_t GetNblocks() const { return (fSize + BlockSize() - 1) / BlockSize(); }
+
+  // Number of items in block b
+  size_t GetBlockCount(size_t b) const { return std::min(BlockSize(), fSize - b * BlockSize()); }
+
+  // Vector of field I in block b
+  template <size_t I>
+  Field_t<I> Field(size_t b) const
+  {
+    Field_t<I> v;
+    LoadAligned(v, Data<I>() + b * BlockSize());
+    return v;
+  }
+
+  // Array of field I, aligned to the vector size
+  template <size_t I>
+  FieldScalar_t<I> *Data()
+  {
+    return std::get<I>(fArrays).data();
+  }
+
+  template <size_t I>
+  const FieldScalar_t<I> *Data() const
+  {
+    return std::get<I>(fArrays).data();
+  }
+
+private:
+  template <class Kernel, typename... F>
+  friend class Basketizer;
+
+  template <size_t I, typename S, typename... Rest>
+  void Write(size_t i, std::integral_constant<size_t, I>, const S &x, const Rest &... rest)
+  {
+    Data<I>()[i] = x;
+    Write(i, std::integral_constant<size_t, I + 1>(), rest...);
+  }
+
+  void Write(size_t, std::integral_constant<size_t, kFields>) {}
+
+  // Fills the lanes past the last item of the last block with the first item
+  template <size_t I>
+  void Pad(std::integral_constant<size_t, I>)
+  {
+    for (size_t i = fSize; i < GetNblocks() * BlockSize(); ++i)
+      Data<I>()[i] = Data<I>()[0];
+    Pad(std::integral_constant<size_t, I + 1>());
+  }
+
+  void Pad(std::integral_constant<size_t, kFields>) {}
+
+  std::tuple<Array_t<Fields>...> fArrays;
+  size_t fSize;
+};
+
+// Counts of a basketizer since its construction or the last call of Reset().
+// The latency of a basket is the time from the push of its first item to the
+// call of the kernel with it.
+struct BasketizerStats {
+  uint64_t fItems;
+  uint64_t fBaskets;
+  uint64_t fFlushed;
+  uint64_t fCapacity;
+  double fLatencySum;
+  double fLatencyMax;
+
+  // Fraction of the places of consumed baskets holding items
+  double FillRatio() const { return fBaskets ? double(fItems) / double(fBaskets * fCapacity) : 0.0; }
+
+  // Latencies in seconds
+  double MeanLatency() const { return fBaskets ? fLatencySum / double(fBaskets) : 0.0; }
+  double MaxLatency() const { return fLatencyMax; }
+};
+
+template <class Kernel, typename... Fields>
+class Basketizer {
+  using Clock = std::chrono::steady_clock;
+
+public:
+  using Basket_t = Basket<Fields...>;
+
+  static constexpr size_t BlockSize() { return Basket_t::BlockSize(); }
+
+  // Baskets of the capacity rounded up to a multiple of the vector size. The
+  // baskets are filled one after the other, and reused once consumed. A zero
+  // deadline disables flushing by Poll().
+  Basketizer(const Kernel &kernel, size_t capacity, size_t baskets = 4,
+             Clock::duration deadline = std::chrono::milliseconds(1))
+      : fKernel(kernel), fCapacity(std::max((capacity + BlockSize() - 1) / BlockSize(), size_t(1)) * BlockSize()),
+        fDeadline(std::chrono::duration_cast<std::chrono::nanoseconds>(deadline).count()), fTicket(0)
+  {
+    for (size_t i = 0; i < std::max(baskets, size_t(1)); ++i)
+      fSlots.emplace_back(new Slot(fCapacity, i));
+    Reset();
+  }
+
+  Basketizer(const Basketizer &) = delete;
+  Basketizer &operator=(const Basketizer &) = delete;
+
+  ~Basketizer() { Flush(); }
+
+  size_t Capacity() const { return fCapacity; }
+
+  // Adds an item, and consumes its basket when this fills it
+  void Push(const Scalar<Fields> &... fields)
+  {
+    const size_t ticket = fTicket.fetch_add(1, std::memory_order_relaxed);
+    const size_t gen    = ticket / fCapacity;
+    const size_t i      = ticket % fCapacity;
+
+    Slot &slot = Wait(gen);
+    if (i == 0) slot.fStart.store(Now(), std::memory_order_relaxed);
+    slot.fBasket.Write(i, std::integral_constant<size_t, 0>(), fields...);
+
+    if (slot.fFilled.fetch_add(1, std::memory_order_acq_rel) + 1 == fCapacity) Consume(slot, gen);
+  }
+
+  // Consumes the basket being filled if its first item is older than the
+  // deadline, and returns whether it did
+  bool Poll()
+  {
+    if (fDeadline == 0) return false;
+
+    size_t ticket = fTicket.load(std::memory_order_relaxed);
+    if (ticket % fCapacity == 0) return false;
+
+    const size_t gen = ticket / fCapacity;
+    const Slot &slot = *fSlots[gen % fSlots.size()];
+    if (slot.fGeneration.load(std::memory_order_acquire) != gen) return false;
+
+    const int64_t start = slot.fStart.load(std::memory_order_relaxed);
+    if (start == 0 || Now() - start < fDeadline) return false;
+
+    if (!fTicket.compare_exchange_strong(ticket, (gen + 1) * fCapacity, std::memory_order_relaxed)) return false;
+
+    Close(ticket);
+    return true;
+  }
+
+  // Consumes the basket being filled, and waits until all baskets with items
+  // pushed before are consumed
+  void Flush()
+  {
+    size_t ticket = fTicket.load(std::memory_order_relaxed);
+    while (ticket % fCapacity != 0) {
+      const size_t end = (ticket / fCapacity + 1) * fCapacity;
+      if (fTicket.compare_exchange_weak(ticket, end, std::memory_order_relaxed)) {
+        Close(ticket);
+        ticket = end;
+      }
+    }
+
+    // baskets are released out of order, so each one is waited for until it
+    // is released by the last generation before the flush that fills it
+    const size_t gens = ticket / fCapacity, n = fSlots.size();
+    for (size_t i = 0; i < std::min(gens, n); ++i) {
+      const size_t last = gens - 1 - (gens - 1 - i) % n;
+      while (fSlots[i]->fGeneration.load(std::memory_order_acquire) <= last)
+        std::this_thread::yield();
+    }
+  }
+
+  BasketizerStats Stats() const
+  {
+    BasketizerStats stats;
+    stats.fItems      = fItems.load(std::memory_order_relaxed);
+    stats.fBaskets    = fBaskets.load(std::memory_order_relaxed);
+    stats.fFlushed    = fFlushed.load(std::memory_order_relaxed);
+    stats.fCapacity   = fCapacity;
+    stats.fLatencySum = 1e-9 * double(fLatencySum.load(std::memory_order_relaxed));
+    stats.fLatencyMax = 1e-9 * double(fLatencyMax.load(std::memory_order_relaxed));
+    return stats;
+  }
+
+  void Reset()
+  {
+    fItems.store(0, std::memory_order_relaxed);
+    fBaskets.store(0, std::memory_order_relaxed);
+    fFlushed.store(0, std::memory_order_relaxed);
+    fLatencySum.store(0, std::memory_order_relaxed);
+    fLatencyMax.store(0, std::memory_order_relaxed);
+  }
+
+private:
+  // Basket i of n is filled by the items of generations i, i + n, i + 2n...,
+  // where generation g has the tickets from g * capacity to (g + 1) * capacity
+  struct Slot {
+    Slot(size_t capacity, size_t gen) : fBasket(capacity), fGeneration(gen), fFilled(0), fStart(0), fSize(capacity)
+    {
+    }
+
+    Basket_t fBasket;
+    std::atomic<size_t> fGeneration; // of the items, once the previous one is consumed
+    std::atomic<size_t> fFilled;     // places taken, by items or by flushing
+    std::atomic<int64_t> fStart;     // time of the first push, or zero
+    size_t fSize;                    // number of items, set when flushing
+  };
+
+  static int64_t Now()
+  {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now().time_since_epoch()).count();
+  }
+
+  // Basket of the generation, once it is free
+  Slot &Wait(size_t gen)
+  {
+    Slot &slot = *fSlots[gen % fSlots.size()];
+    while (slot.fGeneration.load(std::memory_order_acquire) != gen)
+      std::this_thread::yield();
+    return slot;
+  }
+
+  // Fills the places of a basket past the ticket, which was the next one
+  void Close(size_t ticket)
+  {
+    const size_t gen  = ticket / fCapacity;
+    const size_t size = ticket % fCapacity;
+
+    Slot &slot = Wait(gen);
+    slot.fSize = size;
+    if (slot.fFilled.fetch_add(fCapacity - size, std::memory_order_acq_rel) + fCapacity - size == fCapacity)
+      Consume(slot, gen);
+  }
+
+  void Consume(Slot &slot, size_t gen)
+  {
+    Basket_t &basket = slot.fBasket;
+    basket.fSize     = slot.fSize;
+    basket.Pad(std::integral_constant<size_t, 0>());
+
+    const uint64_t latency = uint64_t(std::max(Now() - slot.fStart.load(std::memory_order_relaxed), int64_t(0)));
+    uint64_t max           = fLatencyMax.load(std::memory_order_relaxed);
+    while (latency > max && !fLatencyMax.compare_exchange_weak(max, latency, std::memory_order_relaxed)) {
+    }
+
+    fItems.fetch_add(basket.fSize, std::memory_order_relaxed);
+    fBaskets.fetch_add(1, std::memory_order_relaxed);
+    if (basket.fSize < fCapacity) fFlushed.fetch_add(1, std::memory_order_relaxed);
+    fLatencySum.fetch_add(latency, std::memory_order_relaxed);
+
+    try {
+      fKernel(static_cast<const Basket_t &>(basket));
+    } catch (...) {
+      Release(slot, gen);
+      throw;
+    }
+    Release(slot, gen);
+  }
+
+  void Release(Slot &slot, size_t gen)
+  {
+    slot.fSize = fCapacity;
+    slot.fFilled.store(0, std::memory_order_relaxed);
+    slot.fStart.store(0, std::memory_order_relaxed);
+    slot.fGeneration.store(gen + fSlots.size(), std::memory_order_release);
+  }
+
+  const Kernel fKernel;
+  const size_t fCapacity;
+  const int64_t fDeadline;
+  std::vector<std::unique_ptr<Slot>> fSlots;
+  std::atomic<size_t> fTicket;
+  std::atomic<uint64_t> fItems;
+  std::atomic<uint64_t> fBaskets;
+  std::atomic<uint64_t> fFlushed;
+  std::atomic<uint64_t> fLatencySum;
+  std::atomic<uint64_t> fLatencyMax;
+};
+
+} // namespace vecCore
+
+#endif
@@ -0,0 +1,390 @@
+#ifndef VECCORE_COMPLEX_H
+#define VECCORE_COMPLEX_H
+
+#include "Backend/Interface.h"
+#include "Backend/Implementation.h"
+#include "VecMath.h"
+
+#include <complex>
+
+namespace vecCore {
+
+// Complex numbers with real and imaginary parts held in separate backend
+// vectors (SoA layout), so that each lane of Complex<T> is an independent
+// complex number and arithmetic maps directly onto vector instructions.
+//
+// Complex<T> is a backend type in its own right: its scalar type is
+// std::complex<Scalar<T>>, and it shares the mask and index types of T. Hence
+// VectorSize(), Get(), Set(), Load(), Store(), Gather() and Scatter() work
+// lane by lane on std::complex values, which also converts from and to the
+// interleaved layout used by std::complex arrays. MaskedAssign() and Blend()
+// take a Mask<T> and operate on both parts at once.
+
+template <typename T>
+class Complex {
+public:
+  using Scalar_t = Scalar<T>;
+
+  VECCORE_FORCE_INLINE
+  VECCORE_ATT_HOST_DEVICE
+  Complex() : fReal(Scalar_t(0)), fImag(Scalar_t(0)) {}
+
+  VECCORE_FORCE_INLINE
+  VECCORE_ATT_HOST_DEVICE
+  Complex(const T &re) : fReal(re), fImag(Scalar_t(0)) {}
+
+  VECCORE_FORCE_INLINE
+  VECCORE_ATT_HOST_DEVICE
+  Complex(const T &re, const T &im) : fReal(re), fImag(im) {}
+
+  VECCORE_FORCE_INLINE
+  VECCORE_ATT_HOST_DEVICE
+  T &Real() { return fReal; }
+
+  VECCORE_FORCE_INLINE
+  VECCORE_ATT_HOST_DEVICE
+  T const &Real() const { return fReal; }
+
+  VECCORE_FORCE_INLINE
+  VECCORE_ATT_HOST_DEVICE
+  T &Imag() { return fImag; }
+
+  VECCORE_FORCE_INLINE
+  VECCORE_ATT_HOST_DEVICE
+  T const &Imag() const { return fImag; }
+
+  VECCORE_FORCE_INLINE
+  VECCORE_ATT_HOST_DEVICE
+  Complex &operator+=(const Complex &z)
+  {
+    fReal += z.fReal;
+    fImag += z.fImag;
+    return *this;
+  }
+
+  VECCORE_FORCE_INLINE
+  VECCORE_ATT_HOST_DEVICE
+  Complex &operator-=(const Complex &z)
+  {
+    fReal -= z.fReal;
+    fImag -= z.fImag;
+    return *this;
+  }
+
+  VECCORE_FORCE_INLINE
+  VECCORE_ATT_HOST_DEVICE
+  Complex &operator*=(const Complex &z)
+  {
+    T re  = math::FMA(fReal, z.fReal, T(-fImag * z.fImag));
+    fImag = math::FMA(fReal, z.fImag, T(fImag * z.fReal));
+    fReal = re;
+    return *this;
+  }
+
+  // Textbook division, which overflows or underflows when the squared
+  // modulus of the divisor does, i.e. beyond about the square root of the
+  // largest or smallest representable number.
+
+  VECCORE_FORCE_INLINE
+  VECCORE_ATT_HOST_DEVICE
+  Complex &operator/=(const Complex &z)
+  {
+    T norm = T(Scalar_t(1)) / math::FMA(z.fReal, z.fReal, T(z.fImag * z.fImag));
+    T re   = math::FMA(fReal, z.fReal, T(fImag * z.fImag)) * norm;
+    fImag  = math::FMA(fImag, z.fReal, T(-fReal * z.fImag)) * norm;
+    fReal  = re;
+    return *this;
+  }
+
+  VECCORE_FORCE_INLINE
+  VECCORE_ATT_HOST_DEVICE
+  Complex &operator+=(const T &x)
+  {
+    fReal += x;
+    return *this;
+  }
+
+  VECCORE_FORCE_INLINE
+  VECCORE_ATT_HOST_DEVICE
+  Complex &operator-=(const T &x)
+  {
+    fReal -= x;
+    return *this;
+  }
+
+  VECCORE_FORCE_INLINE
+  VECCORE_ATT_HOST_DEVICE
+  Complex &operator*=(const T &x)
+  {
+    fReal *= x;
+    fImag *= x;
+    return *this;
+  }
+
+  VECCORE_FORCE_INLINE
+  VECCORE_ATT_HOST_DEVICE
+  Complex &operator/=(const T &x)
+  {
+    fReal /= x;
+    fImag /= x;
+    return *this;
+  }
+
+private:
+  T fReal;
+  T fImag;
+};
+
+template <typename T>
+struct TypeTraits<Complex<T>> {
+  using ScalarType = std::complex<Scalar<T>>;
+  using MaskType   = Mask<T>;
+  using IndexType  = Index<T>;
+};
+
+template <typename T>
+struct IndexingImplementation<Complex<T>> {
+  VECCORE_FORCE_INLINE
+  static std::complex<Scalar<T>> Get(const Complex<T> &z, size_t i)
+  {
+    return std::complex<Scalar<T>>(vecCore::Get(z.Real(), i), vecCore::Get(z.Imag(), i));
+  }
+
+  VECCORE_FORCE_INLINE
+  static void Set(Complex<T> &z, size_t i, std::complex<Scalar<T>> const val)
+  {
+    vecCore::Set(z.Real(), i, val.real());
+    vecCore::Set(z.Imag(), i, val.imag());
+  }
+};
+
+template <typename T>
+struct MaskingImplementation<Complex<T>> {
+  VECCORE_FORCE_INLINE
+  VECCORE_ATT_HOST_DEVICE
+  static void Assign(Complex<T> &dst, Mask<T> const &mask, Complex<T> const &src)
+  {
+    vecCore::MaskedAssign(dst.Real(), mask, src.Real());
+    vecCore::MaskedAssign(dst.Imag(), mask, src.Imag());
+  }
+
+  VECCORE_FORCE_INLINE
+  VECCORE_ATT_HOST_DEVICE
+  static void Blend(Complex<T> &dst, Mask<T> const &mask, Complex<T> const &src1, Complex<T> const &src2)
+  {
+    dst = Complex<T>(vecCore::Blend(mask, src1.Real(), src2.Real()), vecCore::Blend(mask, src1.Imag(), src2.Imag()));
+  }
+};
+
+// Arithmetic and Comparisons
+
+template <typename T>
+VECCORE_FORCE_INLINE
+VECCORE_ATT_HOST_DEVICE
+Complex<T> operator-(const Complex<T> &z)
+{
+  return Complex<T>(-z.Real(), -z.Imag());
+}
+
+#define VECCORE_COMPLEX_BINARY_OP(OP, OPEQ)                                  \
+  template <typename T>                                                      \
+  VECCORE_FORCE_INLINE                                                       \
+  VECCORE_ATT_HOST_DEVICE                                                    \
+  Complex<T> operator OP(Complex<T> z, const Complex<T> &w)                  \
+  {                                                                          \
+    return z OPEQ w;                                                         \
+  }                                                                          \
+                                                                             \
+  template <typename T>                                                      \
+  VECCORE_FORCE_INLINE                                                       \
+  VECCORE_ATT_HOST_DEVICE                                                    \
+  Complex<T> operator OP(Complex<T> z, const T &x)                           \
+  {                                                                          \
+    return z OPEQ x;                                                         \
+  }
+
+VECCORE_COMPLEX_BINARY_OP(+, +=)
+VECCORE_COMPLEX_BINARY_OP(-, -=)
+VECCORE_COMPLEX_BINARY_OP(*, *=)
+VECCORE_COMPLEX_BINARY_OP(/, /=)
+
+#undef VECCORE_COMPLEX_BINARY_OP
+
+template <typename T>
+VECCORE_FORCE_INLINE
+VECCORE_ATT_HOST_DEVICE
+Complex<T> operator+(const T &x, Complex<T> z)
+{
+  return z += x;
+}
+
+template <typename T>
+VECCORE_FORCE_INLINE
+VECCORE_ATT_HOST_DEVICE
+Complex<T> operator-(const T &x, const Complex<T> &z)
+{
+  return Complex<T>(x - z.Real(), -z.Imag());
+}
+
+template <typename T>
+VECCORE_FORCE_INLINE
+VECCORE_ATT_HOST_DEVICE
+Complex<T> operator*(const T &x, Complex<T> z)
+{
+  return z *= x;
+}
+
+template <typename T>
+VECCORE_FORCE_INLINE
+VECCORE_ATT_HOST_DEVICE
+Complex<T> operator/(const T &x, const Complex<T> &z)
+{
+  return Complex<T>(x) /= z;
+}
+
+template <typename T>
+VECCORE_FORCE_INLINE
+VECCORE_ATT_HOST_DEVICE
+Mask<T> operator==(const Complex<T> &z, const Complex<T> &w)
+{
+  return z.Real() == w.Real() && z.Imag() == w.Imag();
+}
+
+template <typename T>
+VECCORE_FORCE_INLINE
+VECCORE_ATT_HOST_DEVICE
+Mask<T> operator!=(const Complex<T> &z, const Complex<T> &w)
+{
+  return z.Real() != w.Real() || z.Imag() != w.Imag();
+}
+
+namespace math {
+
+// Complex Functions
+
+template <typename T>
+VECCORE_FORCE_INLINE
+VECCORE_ATT_HOST_DEVICE
+T Real(const Complex<T> &z)
+{
+  return z.Real();
+}
+
+template <typename T>
+VECCORE_FORCE_INLINE
+VECCORE_ATT_HOST_DEVICE
+T Imag(const Complex<T> &z)
+{
+  return z.Imag();
+}
+
+template <typename T>
+VECCORE_FORCE_INLINE
+VECCORE_ATT_HOST_DEVICE
+Complex<T> Conj(const Complex<T> &z)
+{
+  return Complex<T>(z.Real(), -z.Imag());
+}
+
+// Squared modulus, much cheaper than Abs() and sufficient for comparisons
+
+template <typename T>
+VECCORE_FORCE_INLINE
+VECCORE_ATT_HOST_DEVICE
+T Abs2(const Complex<T> &z)
+{
+  return FMA(z.Real(), z.Real(), T(z.Imag() * z.Imag()));
+}
+
+// Modulus, scaled to avoid overflow and underflow of the intermediate square
+
+template <typename T>
+VECCORE_FORCE_INLINE
+VECCORE_ATT_HOST_DEVICE
+T Abs(const Complex<T> &z)
+{
+  T x = Abs(z.Real()), y = Abs(z.Imag());
+  T a = Max(x, y), b = Min(x, y);
+  T r = b / a;
+  T m = a * Sqrt(FMA(r, r, T(Scalar<T>(1))));
+  return Blend(a == T(Scalar<T>(0)) || b == NumericLimits<T>::Infinity(), T(a + b), m);
+}
+
+template <typename T>
+VECCORE_FORCE_INLINE
+VECCORE_ATT_HOST_DEVICE
+T Arg(const Complex<T> &z)
+{
+  return ATan2(z.Imag(), z.Real());
+}
+
+// Complex number with given modulus and argument
+
+template <typename T>
+VECCORE_FORCE_INLINE
+VECCORE_ATT_HOST_DEVICE
+Complex<T> Polar(const T &rho, const T &theta)
+{
+  T s, c;
+  SinCos(theta, &s, &c);
+  return Complex<T>(rho * c, rho * s);
+}
+
+template <typename T>
+VECCORE_FORCE_INLINE
+VECCORE_ATT_HOST_DEVICE
+Complex<T> Exp(const Complex<T> &z)
+{
+  return Polar(Exp(z.Real()), z.Imag());
+}
+
+// Principal value of the logarithm, with the branch cut along the negative real axis
+
+template <typename T>
+VECCORE_FORCE_INLINE
+VECCORE_ATT_HOST_DEVICE
+Complex<T> Log(const Complex<T> &z)
+{
+  return Complex<T>(Log(Abs(z)), Arg(z));
+}
+
+// Integer power by repeated squaring, which takes O(log n) multiplications
+// and is exact for small Gaussian integers, unlike Exp(n * Log(z))
+
+template <typename T>
+VECCORE_FORCE_INLINE
+VECCORE_ATT_HOST_DEVICE
+Complex<T> Pow(const Complex<T> &z, int n)
+{
+  Complex<T> x(z), y(T(Scalar<T>(1)));
+  for (unsigned int k = n < 0 ? -static_cast<unsigned int>(n) : n; k; k >>= 1) {
+    if (k & 1) y *= x;
+    if (k > 1) x *= x;
+  }
+  return n < 0 ? Complex<T>(T(Scalar<T>(1))) / y : y;
+}
+
+template <typename T>
+VECCORE_FORCE_INLINE
+VECCORE_ATT_HOST_DEVICE
+Complex<T> Pow(const Complex<T> &z, const Complex<T> &w)
+{
+  return Exp(w * Log(z));
+}
+
+template <typename T>
+VECCORE_FORCE_INLINE
+VECCORE_ATT_HOST_DEVICE
+Complex<T> Sqrt(const Complex<T> &z)
+{
+  // Half-angle formulas, with the larger part computed first to avoid cancellation
+  T r = Sqrt(T(Scalar<T>(0.5)) * (Abs(z) + Abs(z.Real())));
+  T s = Blend(r == T(Scalar<T>(0)), r, T(Abs(z.Imag()) / (T(Scalar<T>(2)) * r)));
+  Mask<T> pos = z.Real() >= T(Scalar<T>(0));
+  return Complex<T>(Blend(pos, r, s), CopySign(Blend(pos, s, r), z.Imag()));
+}
+
+} // namespace math
+} // namespace vecCore
+
+#endif
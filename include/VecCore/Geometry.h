@@ -0,0 +1,491 @@
+#ifndef VECCORE_GEOMETRY_H
+#define VECCORE_GEOMETRY_H
+
+#include "Vector3D.h"
+
+namespace vecCore {
+namespace geometry {
+
+// Distance and safety kernels for simple solids, for one ray per lane.
+//
+// Solids are centered at the origin of their local frame (use Transform3D to
+// get there), and their dimensions are scalars shared by all lanes. For a
+// point p and a unit direction d, each solid provides
+//
+//   Contains(p)         mask of lanes with p inside or on the surface
+//   DistanceToIn(p, d)  distance along d to enter the solid, 0 for points
+//                       inside, and infinity when the ray misses it
+//   DistanceToOut(p, d) distance along d to leave the solid, 0 for points
+//                       outside
+//   SafetyToIn(p)       lower bound on the distance from p to the solid,
+//                       0 for points inside
+//   SafetyToOut(p)      lower bound on the distance from p to the surface,
+//                       0 for points outside
+//
+// Quadratics are solved in forms without cancellation. Where the remaining
+// work is expensive and all lanes are known to miss, the kernels return early
+// on backends with short enough vectors (see EarlyReturnMaxLength()).
+
+constexpr size_t kEarlyReturnMaxLength = 8;
+
+// Slab test of a ray against the axis aligned box [lo, hi]. Takes the inverse
+// of the direction, which can be shared between several boxes, and returns
+// the mask of lanes where the ray hits the box at non-negative distance. The
+// ray is inside the box for tnear < t < tfar, and tnear is negative for
+// origins inside the box.
+
+template <typename T>
+VECCORE_FORCE_INLINE
+VECCORE_ATT_HOST_DEVICE
+Mask<T> RayAABB(const Vector3D<T> &lo, const Vector3D<T> &hi, const Vector3D<T> &p, const Vector3D<T> &invdir,
+                T &tnear, T &tfar)
+{
+  tnear = -NumericLimits<T>::Infinity();
+  tfar  = NumericLimits<T>::Infinity();
+  for (int i = 0; i < 3; ++i) {
+    T t1 = (lo[i] - p[i]) * invdir[i];
+    T t2 = (hi[i] - p[i]) * invdir[i];
+    tnear = math::Max(tnear, math::Min(t1, t2));
+    tfar  = math::Min(tfar, math::Max(t1, t2));
+  }
+  return tnear <= tfar && tfar >= T(Scalar<T>(0));
+}
+
+// Box with half lengths dx, dy, dz.
+
+class Box {
+public:
+  Box(double dx, double dy, double dz) : fD{dx, dy, dz} {}
+
+  double GetDx() const { return fD[0]; }
+  double GetDy() const { return fD[1]; }
+  double GetDz() const { return fD[2]; }
+
+  template <typename T>
+  VECCORE_FORCE_INLINE
+  VECCORE_ATT_HOST_DEVICE
+  Mask<T> Contains(const Vector3D<T> &p) const
+  {
+    return SignedSafety(p) <= T(Scalar<T>(0));
+  }
+
+  template <typename T>
+  VECCORE_FORCE_INLINE
+  VECCORE_ATT_HOST_DEVICE
+  T DistanceToIn(const Vector3D<T> &p, const Vector3D<T> &d) const
+  {
+    const Vector3D<T> hi = Dimensions<T>(), lo = -hi;
+    const T one(Scalar<T>(1));
+    T tnear, tfar;
+    Mask<T> hit = RayAABB(lo, hi, p, Vector3D<T>(one / d.X(), one / d.Y(), one / d.Z()), tnear, tfar);
+    return Blend(hit, math::Max(tnear, T(Scalar<T>(0))), NumericLimits<T>::Infinity());
+  }
+
+  template <typename T>
+  VECCORE_FORCE_INLINE
+  VECCORE_ATT_HOST_DEVICE
+  T DistanceToOut(const Vector3D<T> &p, const Vector3D<T> &d) const
+  {
+    T dist = NumericLimits<T>::Infinity();
+    for (int i = 0; i < 3; ++i)
+      dist = math::Min(dist, T((math::CopySign(T(Scalar<T>(fD[i])), d[i]) - p[i]) / d[i]));
+    return Blend(Contains(p), math::Max(dist, T(Scalar<T>(0))), T(Scalar<T>(0)));
+  }
+
+  template <typename T>
+  VECCORE_FORCE_INLINE
+  VECCORE_ATT_HOST_DEVICE
+  T SafetyToIn(const Vector3D<T> &p) const
+  {
+    return math::Max(SignedSafety(p), T(Scalar<T>(0)));
+  }
+
+  template <typename T>
+  VECCORE_FORCE_INLINE
+  VECCORE_ATT_HOST_DEVICE
+  T SafetyToOut(const Vector3D<T> &p) const
+  {
+    T safety = T(Scalar<T>(fD[0])) - math::Abs(p.X());
+    safety   = math::Min(safety, T(T(Scalar<T>(fD[1])) - math::Abs(p.Y())));
+    safety   = math::Min(safety, T(T(Scalar<T>(fD[2])) - math::Abs(p.Z())));
+    return math::Max(safety, T(Scalar<T>(0)));
+  }
+
+private:
+  template <typename T>
+  VECCORE_FORCE_INLINE
+  VECCORE_ATT_HOST_DEVICE
+  Vector3D<T> Dimensions() const
+  {
+    return Vector3D<T>(T(Scalar<T>(fD[0])), T(Scalar<T>(fD[1])), T(Scalar<T>(fD[2])));
+  }
+
+  // largest distance outside any of the three slabs, negative inside
+  template <typename T>
+  VECCORE_FORCE_INLINE
+  VECCORE_ATT_HOST_DEVICE
+  T SignedSafety(const Vector3D<T> &p) const
+  {
+    T safety = math::Abs(p.X()) - T(Scalar<T>(fD[0]));
+    safety   = math::Max(safety, T(math::Abs(p.Y()) - T(Scalar<T>(fD[1]))));
+    safety   = math::Max(safety, T(math::Abs(p.Z()) - T(Scalar<T>(fD[2]))));
+    return safety;
+  }
+
+  double fD[3];
+};
+
+// Solid sphere with radius r.
+
+class Sphere {
+public:
+  explicit Sphere(double r) : fR(r) {}
+
+  double GetRadius() const { return fR; }
+
+  template <typename T>
+  VECCORE_FORCE_INLINE
+  VECCORE_ATT_HOST_DEVICE
+  Mask<T> Contains(const Vector3D<T> &p) const
+  {
+    return p.Mag2() <= T(Scalar<T>(fR * fR));
+  }
+
+  template <typename T>
+  VECCORE_FORCE_INLINE
+  VECCORE_ATT_HOST_DEVICE
+  T DistanceToIn(const Vector3D<T> &p, const Vector3D<T> &d) const
+  {
+    const T zero(Scalar<T>(0)), inf(NumericLimits<T>::Infinity());
+
+    // |p + t d|^2 = r^2, i.e. t^2 + 2 b t + c = 0
+    T b    = math::Dot(p, d);
+    T c    = p.Mag2() - T(Scalar<T>(fR * fR));
+    T disc = b * b - c;
+
+    Mask<T> inside = c <= zero;
+    Mask<T> miss   = !inside && (b >= zero || disc < zero);
+
+    if (EarlyReturnMaxLength(b, kEarlyReturnMaxLength) && MaskFull(miss)) return inf;
+
+    // smaller root (-b - sqrt(disc)), rewritten to avoid cancellation for b < 0
+    T dist = c / (math::Sqrt(math::Max(disc, zero)) - b);
+    MaskedAssign(dist, miss, inf);
+    MaskedAssign(dist, inside, zero);
+    return dist;
+  }
+
+  template <typename T>
+  VECCORE_FORCE_INLINE
+  VECCORE_ATT_HOST_DEVICE
+  T DistanceToOut(const Vector3D<T> &p, const Vector3D<T> &d) const
+  {
+    const T zero(Scalar<T>(0));
+
+    T b = math::Dot(p, d);
+    T c = p.Mag2() - T(Scalar<T>(fR * fR));
+    T s = math::Sqrt(math::Max(T(b * b - c), zero));
+
+    // larger root (-b + s), rewritten to avoid cancellation for b > 0
+    T dist = Blend(b > zero, T(-c / (b + s)), T(s - b));
+    return Blend(c <= zero, math::Max(dist, zero), zero);
+  }
+
+  template <typename T>
+  VECCORE_FORCE_INLINE
+  VECCORE_ATT_HOST_DEVICE
+  T SafetyToIn(const Vector3D<T> &p) const
+  {
+    return math::Max(T(p.Mag() - T(Scalar<T>(fR))), T(Scalar<T>(0)));
+  }
+
+  template <typename T>
+  VECCORE_FORCE_INLINE
+  VECCORE_ATT_HOST_DEVICE
+  T SafetyToOut(const Vector3D<T> &p) const
+  {
+    return math::Max(T(T(Scalar<T>(fR)) - p.Mag()), T(Scalar<T>(0)));
+  }
+
+private:
+  double fR;
+};
+
+// Cylindrical tube along z, with inner radius rmin (which may be zero for a
+// solid cylinder), outer radius rmax, and half length dz.
+
+class Tube {
+public:
+  Tube(double rmin, double rmax, double dz) : fRmin(rmin), fRmax(rmax), fDz(dz) {}
+
+  double GetRmin() const { return fRmin; }
+  double GetRmax() const { return fRmax; }
+  double GetDz() const { return fDz; }
+
+  template <typename T>
+  VECCORE_FORCE_INLINE
+  VECCORE_ATT_HOST_DEVICE
+  Mask<T> Contains(const Vector3D<T> &p) const
+  {
+    T rho2 = p.X() * p.X() + p.Y() * p.Y();
+    return math::Abs(p.Z()) <= T(Scalar<T>(fDz)) && rho2 <= T(Scalar<T>(fRmax * fRmax)) &&
+           rho2 >= T(Scalar<T>(fRmin * fRmin));
+  }
+
+  template <typename T>
+  VECCORE_FORCE_INLINE
+  VECCORE_ATT_HOST_DEVICE
+  T DistanceToIn(const Vector3D<T> &p, const Vector3D<T> &d) const
+  {
+    const T zero(Scalar<T>(0)), inf(NumericLimits<T>::Infinity());
+    const T dz = T(Scalar<T>(fDz)), rmax2 = T(Scalar<T>(fRmax * fRmax)), rmin2 = T(Scalar<T>(fRmin * fRmin));
+
+    if (EarlyReturnMaxLength(dz, kEarlyReturnMaxLength) && MaskFull(Miss(p, d))) return inf;
+
+    // (x + t dx)^2 + (y + t dy)^2 = r^2, i.e. a t^2 + 2 b t + c = 0
+    T rho2 = p.X() * p.X() + p.Y() * p.Y();
+    T a    = d.X() * d.X() + d.Y() * d.Y();
+    T b    = p.X() * d.X() + p.Y() * d.Y();
+
+    // end caps, from outside the slab |z| <= dz towards it
+    T dist = (math::CopySign(dz, p.Z()) - p.Z()) / d.Z();
+    T hit2 = RadiusSquared(p, d, dist);
+    MaskedAssign(dist, !(math::Abs(p.Z()) >= dz && p.Z() * d.Z() < zero && hit2 <= rmax2 && hit2 >= rmin2), inf);
+
+    // outer surface, smaller root, from outside
+    T c    = rho2 - rmax2;
+    T disc = b * b - a * c;
+    T t    = c / (math::Sqrt(disc) - b);
+    MaskedAssign(dist, c > zero && b < zero && disc >= zero && t < dist && math::Abs(T(p.Z() + t * d.Z())) <= dz, t);
+
+    // inner surface, larger root, from within the hole or through an end cap
+    if (fRmin > 0) {
+      c    = rho2 - rmin2;
+      disc = b * b - a * c;
+      T s  = math::Sqrt(disc);
+      t    = Blend(b > zero, T(-c / (b + s)), T((s - b) / a));
+      MaskedAssign(dist, a > zero && disc >= zero && t >= zero && t < dist && math::Abs(T(p.Z() + t * d.Z())) <= dz,
+                   t);
+    }
+
+    MaskedAssign(dist, Contains(p), zero);
+    return dist;
+  }
+
+  template <typename T>
+  VECCORE_FORCE_INLINE
+  VECCORE_ATT_HOST_DEVICE
+  T DistanceToOut(const Vector3D<T> &p, const Vector3D<T> &d) const
+  {
+    const T zero(Scalar<T>(0));
+    const T dz = T(Scalar<T>(fDz)), rmax2 = T(Scalar<T>(fRmax * fRmax)), rmin2 = T(Scalar<T>(fRmin * fRmin));
+
+    T rho2 = p.X() * p.X() + p.Y() * p.Y();
+    T a    = d.X() * d.X() + d.Y() * d.Y();
+    T b    = p.X() * d.X() + p.Y() * d.Y();
+
+    // end caps
+    T dist = (math::CopySign(dz, d.Z()) - p.Z()) / d.Z();
+
+    // outer surface, larger root
+    T c = rho2 - rmax2;
+    T s = math::Sqrt(math::Max(T(b * b - a * c), zero));
+    T t = Blend(b > zero, T(-c / (b + s)), T((s - b) / a));
+    MaskedAssign(dist, a > zero && t < dist, t);
+
+    // inner surface, smaller root, when moving towards the axis
+    if (fRmin > 0) {
+      c      = rho2 - rmin2;
+      T disc = b * b - a * c;
+      t      = c / (math::Sqrt(disc) - b);
+      MaskedAssign(dist, b < zero && disc >= zero && t < dist, t);
+    }
+
+    return Blend(Contains(p), math::Max(dist, zero), zero);
+  }
+
+  template <typename T>
+  VECCORE_FORCE_INLINE
+  VECCORE_ATT_HOST_DEVICE
+  T SafetyToIn(const Vector3D<T> &p) const
+  {
+    T rho    = math::Sqrt(p.X() * p.X() + p.Y() * p.Y());
+    T safety = math::Max(T(math::Abs(p.Z()) - T(Scalar<T>(fDz))), T(rho - T(Scalar<T>(fRmax))));
+    safety   = math::Max(safety, T(T(Scalar<T>(fRmin)) - rho));
+    return math::Max(safety, T(Scalar<T>(0)));
+  }
+
+  template <typename T>
+  VECCORE_FORCE_INLINE
+  VECCORE_ATT_HOST_DEVICE
+  T SafetyToOut(const Vector3D<T> &p) const
+  {
+    T rho    = math::Sqrt(p.X() * p.X() + p.Y() * p.Y());
+    T safety = math::Min(T(T(Scalar<T>(fDz)) - math::Abs(p.Z())), T(T(Scalar<T>(fRmax)) - rho));
+    if (fRmin > 0) safety = math::Min(safety, T(rho - T(Scalar<T>(fRmin))));
+    return math::Max(safety, T(Scalar<T>(0)));
+  }
+
+private:
+  // squared distance from the axis at distance t along the ray
+  template <typename T>
+  VECCORE_FORCE_INLINE
+  VECCORE_ATT_HOST_DEVICE
+  static T RadiusSquared(const Vector3D<T> &p, const Vector3D<T> &d, const T &t)
+  {
+    T x = p.X() + t * d.X(), y = p.Y() + t * d.Y();
+    return x * x + y * y;
+  }
+
+  // cheap test for rays that certainly miss: moving away from the slab of the
+  // end caps, or away from the axis while outside the outer radius
+  template <typename T>
+  VECCORE_FORCE_INLINE
+  VECCORE_ATT_HOST_DEVICE
+  Mask<T> Miss(const Vector3D<T> &p, const Vector3D<T> &d) const
+  {
+    const T zero(Scalar<T>(0));
+    T rho2 = p.X() * p.X() + p.Y() * p.Y();
+    return (math::Abs(p.Z()) > T(Scalar<T>(fDz)) && p.Z() * d.Z() >= zero) ||
+           (rho2 > T(Scalar<T>(fRmax * fRmax)) && p.X() * d.X() + p.Y() * d.Y() >= zero);
+  }
+
+  double fRmin;
+  double fRmax;
+  double fDz;
+};
+
+// Solid truncated cone along z, with radius r1 at z = -dz and r2 at z = +dz.
+
+class Cone {
+public:
+  Cone(double r1, double r2, double dz)
+      : fR1(r1), fR2(r2), fDz(dz), fSlope((r2 - r1) / (2 * dz)), fRmid(0.5 * (r1 + r2)),
+        fCosAlpha(1 / std::sqrt(1 + fSlope * fSlope))
+  {
+  }
+
+  double GetR1() const { return fR1; }
+  double GetR2() const { return fR2; }
+  double GetDz() const { return fDz; }
+
+  template <typename T>
+  VECCORE_FORCE_INLINE
+  VECCORE_ATT_HOST_DEVICE
+  Mask<T> Contains(const Vector3D<T> &p) const
+  {
+    T r = Radius(p.Z());
+    return math::Abs(p.Z()) <= T(Scalar<T>(fDz)) && p.X() * p.X() + p.Y() * p.Y() <= r * r;
+  }
+
+  template <typename T>
+  VECCORE_FORCE_INLINE
+  VECCORE_ATT_HOST_DEVICE
+  T DistanceToIn(const Vector3D<T> &p, const Vector3D<T> &d) const
+  {
+    const T zero(Scalar<T>(0)), inf(NumericLimits<T>::Infinity());
+    const T dz = T(Scalar<T>(fDz));
+
+    // moving away from the slab of the end caps
+    Mask<T> miss = math::Abs(p.Z()) > dz && p.Z() * d.Z() >= zero;
+
+    if (EarlyReturnMaxLength(dz, kEarlyReturnMaxLength) && MaskFull(miss)) return inf;
+
+    // end caps, from outside the slab |z| <= dz towards it
+    T dist = (math::CopySign(dz, p.Z()) - p.Z()) / d.Z();
+    T x = p.X() + dist * d.X(), y = p.Y() + dist * d.Y();
+    T r = Blend(p.Z() > zero, T(Scalar<T>(fR2)), T(Scalar<T>(fR1)));
+    MaskedAssign(dist, !(math::Abs(p.Z()) >= dz && p.Z() * d.Z() < zero && x * x + y * y <= r * r), inf);
+
+    // lateral surface, entering root, which lies on the cone itself rather
+    // than on its mirror image whenever it is within the end caps
+    T a, b, c;
+    Lateral(p, d, a, b, c);
+    T disc = b * b - a * c;
+    T s    = math::Sqrt(disc);
+    T t    = Blend(b < zero, T(c / (s - b)), T(-(b + s) / a));
+    MaskedAssign(dist, disc >= zero && t >= zero && t < dist && math::Abs(T(p.Z() + t * d.Z())) <= dz, t);
+
+    MaskedAssign(dist, Contains(p), zero);
+    return dist;
+  }
+
+  template <typename T>
+  VECCORE_FORCE_INLINE
+  VECCORE_ATT_HOST_DEVICE
+  T DistanceToOut(const Vector3D<T> &p, const Vector3D<T> &d) const
+  {
+    const T zero(Scalar<T>(0));
+    const T dz = T(Scalar<T>(fDz));
+
+    // end caps
+    T dist = (math::CopySign(dz, d.Z()) - p.Z()) / d.Z();
+
+    // lateral surface, exiting root on the same nappe of the cone
+    T a, b, c;
+    Lateral(p, d, a, b, c);
+    T disc = b * b - a * c;
+    T s    = math::Sqrt(disc);
+    T t    = Blend(b < zero, T((s - b) / a), T(-c / (b + s)));
+    MaskedAssign(dist, disc >= zero && t >= zero && t < dist && Radius(T(p.Z() + t * d.Z())) >= zero, t);
+
+    return Blend(Contains(p), math::Max(dist, zero), zero);
+  }
+
+  template <typename T>
+  VECCORE_FORCE_INLINE
+  VECCORE_ATT_HOST_DEVICE
+  T SafetyToIn(const Vector3D<T> &p) const
+  {
+    T rho    = math::Sqrt(p.X() * p.X() + p.Y() * p.Y());
+    T safety = math::Max(T(math::Abs(p.Z()) - T(Scalar<T>(fDz))), T((rho - Radius(p.Z())) * T(Scalar<T>(fCosAlpha))));
+    return math::Max(safety, T(Scalar<T>(0)));
+  }
+
+  template <typename T>
+  VECCORE_FORCE_INLINE
+  VECCORE_ATT_HOST_DEVICE
+  T SafetyToOut(const Vector3D<T> &p) const
+  {
+    T rho    = math::Sqrt(p.X() * p.X() + p.Y() * p.Y());
+    T safety = math::Min(T(T(Scalar<T>(fDz)) - math::Abs(p.Z())), T((Radius(p.Z()) - rho) * T(Scalar<T>(fCosAlpha))));
+    return math::Max(safety, T(Scalar<T>(0)));
+  }
+
+private:
+  // radius of the lateral surface at height z
+  template <typename T>
+  VECCORE_FORCE_INLINE
+  VECCORE_ATT_HOST_DEVICE
+  T Radius(const T &z) const
+  {
+    return math::FMA(T(Scalar<T>(fSlope)), z, T(Scalar<T>(fRmid)));
+  }
+
+  // coefficients of a t^2 + 2 b t + c = 0 for the intersection with the cone
+  // x^2 + y^2 = Radius(z)^2, where the lateral surface is entered at the root
+  // with a t + b < 0 and left at the root with a t + b > 0
+  template <typename T>
+  VECCORE_FORCE_INLINE
+  VECCORE_ATT_HOST_DEVICE
+  void Lateral(const Vector3D<T> &p, const Vector3D<T> &d, T &a, T &b, T &c) const
+  {
+    T r  = Radius(p.Z());
+    T rd = T(Scalar<T>(fSlope)) * d.Z();
+    a    = d.X() * d.X() + d.Y() * d.Y() - rd * rd;
+    b    = p.X() * d.X() + p.Y() * d.Y() - r * rd;
+    c    = p.X() * p.X() + p.Y() * p.Y() - r * r;
+  }
+
+  double fR1;
+  double fR2;
+  double fDz;
+  double fSlope;
+  double fRmid;
+  double fCosAlpha;
+};
+
+} // namespace geometry
+} // namespace vecCore
+
+#endif
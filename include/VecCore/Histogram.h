@@ -0,0 +1,171 @@
+#ifndef VECCORE_HISTOGRAM_H
+#define VECCORE_HISTOGRAM_H
+
+#include "Backend/Interface.h"
+#include "Backend/Implementation.h"
+#include "Utilities.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+#include <new>
+#include <vector>
+
+namespace vecCore {
+
+// Histogram with vectorized fill from a vector of bin indices.
+//
+// A plain Gather/Scatter update is wrong when several lanes hit the same
+// bin, since only one of the conflicting writes survives. Fill() therefore
+// first combines the weights of conflicting lanes with ConflictPrefixSum(),
+// after which the last lane in each group of equal indices carries the total
+// increment of the group. As Scatter writes lanes in ascending order, that is
+// the value which ends up in memory.
+//
+// Bin contents are kept in a cache line aligned buffer which is padded to a
+// whole number of cache lines and vectors, so that private copies used by
+// different threads never share a cache line and can be merged with vector
+// loads and stores.
+
+template <typename T>
+class Histogram {
+public:
+  using Scalar_t = Scalar<T>;
+  using Index_v  = Index<T>;
+
+  static constexpr size_t kCacheLine = 64;
+  static constexpr size_t kAlign     = kCacheLine > VECCORE_SIMD_ALIGN ? kCacheLine : VECCORE_SIMD_ALIGN;
+
+  explicit Histogram(size_t nbins) : fNbins(nbins), fSize(PaddedSize(nbins)), fData(Allocate(fSize)) { Reset(); }
+
+  Histogram(const Histogram &h) : fNbins(h.fNbins), fSize(h.fSize), fData(Allocate(fSize))
+  {
+    std::memcpy(fData, h.fData, fSize * sizeof(Scalar_t));
+  }
+
+  Histogram(Histogram &&h) noexcept : fNbins(h.fNbins), fSize(h.fSize), fData(h.fData)
+  {
+    h.fNbins = h.fSize = 0;
+    h.fData = nullptr;
+  }
+
+  Histogram &operator=(Histogram h) noexcept
+  {
+    std::swap(fNbins, h.fNbins);
+    std::swap(fSize, h.fSize);
+    std::swap(fData, h.fData);
+    return *this;
+  }
+
+  ~Histogram() { AlignedFree(fData); }
+
+  size_t GetNbins() const { return fNbins; }
+
+  Scalar_t *GetData() { return fData; }
+  Scalar_t const *GetData() const { return fData; }
+
+  Scalar_t operator[](size_t bin) const { return fData[bin]; }
+
+  void Reset() { std::fill(fData, fData + fSize, Scalar_t(0)); }
+
+  // Unweighted fill, each lane counts once
+  void Fill(const Index_v &bins) { Fill(bins, T(Scalar_t(1))); }
+
+  // Weighted fill, all lanes must hold valid bin indices
+  void Fill(const Index_v &bins, const T &weights)
+  {
+    T increment = ConflictFree(bins) ? weights : ConflictPrefixSum(weights, bins);
+    Scatter(Gather<T>(fData, bins) + increment, fData, bins);
+  }
+
+  // Weighted fill of active lanes only, inactive lanes may hold invalid indices
+  void Fill(const Index_v &bins, const T &weights, const Mask<T> &mask)
+  {
+    if (MaskEmpty(mask)) return;
+
+    if (MaskFull(mask)) {
+      Fill(bins, weights);
+      return;
+    }
+
+    // redirect inactive lanes to bin 0 with zero weight
+    Index_v idx(bins);
+    for (size_t i = 0; i < VectorSize<T>(); ++i)
+      if (!Get(mask, i)) Set(idx, i, 0);
+
+    Fill(idx, Blend(mask, weights, T(Scalar_t(0))));
+  }
+
+  // Add contents of another histogram with the same binning to this one
+  void Merge(const Histogram &h)
+  {
+    assert(fNbins == h.fNbins);
+
+    T x, y;
+    for (size_t i = 0; i < fSize; i += VectorSize<T>()) {
+      Load(x, fData + i);
+      Load(y, h.fData + i);
+      Store(T(x + y), fData + i);
+    }
+  }
+
+private:
+  static size_t PaddedSize(size_t nbins)
+  {
+    // both are powers of two, so the larger one is a multiple of the smaller
+    const size_t block = std::max(kCacheLine / sizeof(Scalar_t), VectorSize<T>());
+    return std::max(block, block * ((nbins + block - 1) / block));
+  }
+
+  static Scalar_t *Allocate(size_t size)
+  {
+    void *ptr = AlignedAlloc(kAlign, size * sizeof(Scalar_t));
+    if (!ptr) throw std::bad_alloc();
+    return static_cast<Scalar_t *>(ptr);
+  }
+
+  size_t fNbins;
+  size_t fSize;
+  Scalar_t *fData;
+};
+
+// Set of private histograms, one per thread, which are filled independently
+// without any synchronization and summed up at the end with Merge(). There
+// is always at least one private histogram.
+
+template <typename T>
+class PerThreadHistogram {
+public:
+  PerThreadHistogram(size_t nbins, size_t nthreads) : fHistograms(std::max(nthreads, size_t(1)), Histogram<T>(nbins))
+  {
+  }
+
+  size_t GetNbins() const { return fHistograms.front().GetNbins(); }
+
+  size_t GetNthreads() const { return fHistograms.size(); }
+
+  Histogram<T> &Local(size_t thread) { return fHistograms[thread]; }
+  Histogram<T> const &Local(size_t thread) const { return fHistograms[thread]; }
+
+  void Reset()
+  {
+    for (auto &h : fHistograms)
+      h.Reset();
+  }
+
+  // Sum of all private copies, must only be called once all threads are done filling
+  Histogram<T> Merge() const
+  {
+    Histogram<T> result(fHistograms.front());
+    for (size_t i = 1; i < fHistograms.size(); ++i)
+      result.Merge(fHistograms[i]);
+    return result;
+  }
+
+private:
+  std::vector<Histogram<T>> fHistograms;
+};
+
+} // namespace vecCore
+
+#endif
@@ -0,0 +1,219 @@
+#ifndef VECCORE_LANE_PROFILER_H
+#define VECCORE_LANE_PROFILER_H
+
+// Lane utilization profiler for masked loops, enabled by defining
+// VECCORE_PROFILE_LANES before including VecCore, e.g. with
+// -DVECCORE_PROFILE_LANES on the command line. Otherwise, it is compiled out.
+//
+// Calls to MaskEmpty(), MaskFull(), MaskedAssign() and Blend() are then
+// recorded per call site and template instantiation: the number of calls,
+// how many calls had each number of active lanes in the mask, and the
+// fraction of lanes active overall. For MaskEmpty() and MaskFull(), calls returning true
+// are counted as exits, since they end loops such as
+//
+//   while (!MaskEmpty(active)) { ... }
+//
+// so that calls per exit is the mean number of iterations of such loops. A
+// report of all call sites, ordered by the number of inactive lanes, is
+// written to stderr at exit. Sites with many inactive lanes are those where
+// refilling or compacting lanes would pay off.
+//
+// The functions are replaced by macros, defined last by the VecCore header,
+// which pass the call site to the overloads below. Hence, only calls in code
+// after the VecCore header are recorded, and not calls within VecCore itself,
+// calls with explicit template arguments, e.g. MaskedAssign<T>(...), or calls
+// with the function name in parentheses, e.g. (MaskEmpty)(m). Other functions
+// or methods with the same names, declared after the VecCore header, must be
+// called or declared with their name in parentheses as well.
+
+#if defined(VECCORE_PROFILE_LANES) && !defined(VECCORE_CUDA)
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace vecCore {
+namespace profile {
+
+class LaneSite {
+public:
+  static constexpr size_t kMaxLanes = 64;
+
+  LaneSite(const char *file, int line, const char *function)
+      : fFile(file), fLine(line), fFunction(function), fLanes(0), fCalls(0), fExits(0)
+  {
+    for (auto &count : fHistogram)
+      count.store(0, std::memory_order_relaxed);
+  }
+
+  LaneSite(const LaneSite &) = delete;
+  LaneSite &operator=(const LaneSite &) = delete;
+
+  template <typename M>
+  void Record(const M &mask, bool exit)
+  {
+    size_t active = 0;
+    for (size_t i = 0; i < VectorSize<M>(); ++i)
+      if (Get(mask, i)) ++active;
+
+    fLanes.store(VectorSize<M>(), std::memory_order_relaxed);
+    fCalls.fetch_add(1, std::memory_order_relaxed);
+    if (exit) fExits.fetch_add(1, std::memory_order_relaxed);
+    fHistogram[std::min(active, kMaxLanes)].fetch_add(1, std::memory_order_relaxed);
+  }
+
+  const char *File() const { return fFile; }
+  int Line() const { return fLine; }
+  const char *Function() const { return fFunction; }
+
+  size_t Lanes() const { return fLanes.load(std::memory_order_relaxed); }
+  uint64_t Calls() const { return fCalls.load(std::memory_order_relaxed); }
+  uint64_t Exits() const { return fExits.load(std::memory_order_relaxed); }
+
+  // Number of calls with n active lanes
+  uint64_t Count(size_t n) const { return n <= kMaxLanes ? fHistogram[n].load(std::memory_order_relaxed) : 0; }
+
+  uint64_t ActiveLanes() const
+  {
+    uint64_t sum = 0;
+    for (size_t n = 1; n <= kMaxLanes; ++n)
+      sum += n * Count(n);
+    return sum;
+  }
+
+  uint64_t InactiveLanes() const { return Calls() * Lanes() - ActiveLanes(); }
+
+  double Utilization() const { return Calls() ? double(ActiveLanes()) / double(Calls() * Lanes()) : 0.0; }
+
+private:
+  const char *fFile;
+  int fLine;
+  const char *fFunction;
+  std::atomic<size_t> fLanes;
+  std::atomic<uint64_t> fCalls;
+  std::atomic<uint64_t> fExits;
+  std::atomic<uint64_t> fHistogram[kMaxLanes + 1];
+};
+
+// All call sites recorded so far. The profile is never destroyed, so that
+// calls during the destruction of static objects can still be recorded.
+class LaneProfile {
+public:
+  static LaneProfile &Instance()
+  {
+    static LaneProfile *profile = new LaneProfile();
+    return *profile;
+  }
+
+  LaneProfile(const LaneProfile &) = delete;
+  LaneProfile &operator=(const LaneProfile &) = delete;
+
+  LaneSite &Add(const char *file, int line, const char *function)
+  {
+    std::lock_guard<std::mutex> lock(fMutex);
+    fSites.emplace_back(new LaneSite(file, line, function));
+    return *fSites.back();
+  }
+
+  std::vector<const LaneSite *> Sites() const
+  {
+    std::lock_guard<std::mutex> lock(fMutex);
+    std::vector<const LaneSite *> sites;
+    for (auto &site : fSites)
+      sites.push_back(site.get());
+    return sites;
+  }
+
+  void Report(FILE *out) const
+  {
+    std::vector<const LaneSite *> sites;
+    for (const LaneSite *site : Sites())
+      if (site->Calls() > 0) sites.push_back(site);
+
+    if (sites.empty()) return;
+
+    std::stable_sort(sites.begin(), sites.end(), [](const LaneSite *a, const LaneSite *b) {
+      return a->InactiveLanes() > b->InactiveLanes();
+    });
+
+    fprintf(out, "\nVecCore lane utilization, by number of inactive lanes\n");
+
+    for (const LaneSite *site : sites) {
+      fprintf(out, "\n%s at %s:%d, %zu lanes\n", site->Function(), site->File(), site->Line(), site->Lanes());
+      fprintf(out, "  calls %llu, ", (unsigned long long)site->Calls());
+      if (strcmp(site->Function(), "MaskEmpty") == 0 || strcmp(site->Function(), "MaskFull") == 0)
+        fprintf(out, "exits %llu (%.1f calls per exit), ", (unsigned long long)site->Exits(),
+                site->Exits() ? double(site->Calls()) / double(site->Exits()) : 0.0);
+      fprintf(out, "utilization %.1f%%\n", 100.0 * site->Utilization());
+
+      fprintf(out, "  active lanes:");
+      for (size_t n = 0; n <= std::min(site->Lanes(), LaneSite::kMaxLanes); ++n)
+        fprintf(out, " %zu: %.1f%%", n, 100.0 * double(site->Count(n)) / double(site->Calls()));
+      fprintf(out, "\n");
+    }
+  }
+
+private:
+  LaneProfile() { std::atexit([] { Instance().Report(stderr); }); }
+
+  mutable std::mutex fMutex;
+  std::vector<std::unique_ptr<LaneSite>> fSites;
+};
+
+} // namespace profile
+
+template <typename M>
+Bool_s MaskEmpty(profile::LaneSite &site, const M &mask)
+{
+  Bool_s empty = MaskEmpty(mask);
+  site.Record(mask, empty);
+  return empty;
+}
+
+template <typename M>
+Bool_s MaskFull(profile::LaneSite &site, const M &mask)
+{
+  Bool_s full = MaskFull(mask);
+  site.Record(mask, full);
+  return full;
+}
+
+template <typename T, typename M, typename S>
+void MaskedAssign(profile::LaneSite &site, T &dst, const M &mask, const S &src)
+{
+  site.Record(mask, false);
+  MaskedAssign(dst, mask, src);
+}
+
+template <typename M, typename T1, typename T2>
+auto Blend(profile::LaneSite &site, const M &mask, const T1 &src1, const T2 &src2)
+    -> decltype(Blend(mask, src1, src2))
+{
+  site.Record(mask, false);
+  return Blend(mask, src1, src2);
+}
+
+} // namespace vecCore
+
+// One site per call and template instantiation, created on the first call
+#define VECCORE_LANE_SITE(function)                                                         \
+  ([]() -> vecCore::profile::LaneSite & {                                                   \
+    static vecCore::profile::LaneSite &site =                                               \
+        vecCore::profile::LaneProfile::Instance().Add(__FILE__, __LINE__, function);        \
+    return site;                                                                            \
+  }())
+
+#define MaskEmpty(...) MaskEmpty(VECCORE_LANE_SITE("MaskEmpty"), __VA_ARGS__)
+#define MaskFull(...) MaskFull(VECCORE_LANE_SITE("MaskFull"), __VA_ARGS__)
+#define MaskedAssign(...) MaskedAssign(VECCORE_LANE_SITE("MaskedAssign"), __VA_ARGS__)
+#define Blend(...) Blend(VECCORE_LANE_SITE("Blend"), __VA_ARGS__)
+
+#endif
+
+#endif
@@ -0,0 +1,279 @@
+#ifndef VECCORE_LAUNCH_H
+#define VECCORE_LAUNCH_H
+
+#include "Backend/Interface.h"
+#include "Backend/Implementation.h"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace vecCore {
+namespace cpu {
+
+// Kernels written for CUDA-style grids of thread blocks, run on the CPU.
+//
+// The threads of a block run in groups of VectorSize<T>() threads which are
+// consecutive along x, one thread per lane of the backend type T. Blocks are
+// distributed over a pool of threads. A kernel is a function object, called
+// for each group with a Thread<T> describing it, followed by the arguments of
+// the launch. Written as a template, the same kernel runs one thread at a
+// time with a scalar T, as on a GPU:
+//
+//   struct Saxpy {
+//     template <typename T>
+//     void operator()(const cpu::Thread<T> &t, float a, const float *x, float *y, size_t n) const
+//     {
+//       Mask<T> m = t.Below(n);
+//       if (MaskEmpty(m)) return;
+//       Index<T> i = t.GlobalX();
+//       ...
+//     }
+//   };
+//
+//   cpu::Launch<Float_v>(Dim3((n + 255) / 256), Dim3(256), Saxpy(), a, x, y, n);
+//
+// When blockDim.x is not a multiple of the vector size, the lanes of the last
+// group of each row of a block beyond the end of the row are inactive, and
+// their indices are past the end of the row. Kernels must leave memory at
+// such indices untouched. The groups of a block run one after the other on
+// the same thread, so the threads of a block can neither wait for each other,
+// as with __syncthreads(), nor share memory.
+
+struct Dim3 {
+  unsigned x, y, z;
+
+  VECCORE_ATT_HOST_DEVICE
+  Dim3(unsigned x = 1, unsigned y = 1, unsigned z = 1) : x(x), y(y), z(z) {}
+
+  VECCORE_ATT_HOST_DEVICE
+  size_t Size() const { return size_t(x) * y * z; }
+};
+
+template <typename I>
+struct Index3 {
+  I x, y, z;
+};
+
+template <typename T>
+class Thread {
+public:
+  using I = Index<T>;
+
+  // threadIdx.x differs between lanes, y and z are the same in all of them
+  Index3<I> threadIdx;
+  Dim3 blockIdx;
+  Dim3 blockDim;
+  Dim3 gridDim;
+
+  // lanes which are threads of the block
+  Mask<T> active;
+
+  Thread(const Dim3 &grid, const Dim3 &block, const Dim3 &index)
+      : blockIdx(index), blockDim(block), gridDim(grid), fIota(Scalar<T>(0)), fIotaIndex(Scalar<I>(0)), fX(0),
+        fLanes(0)
+  {
+    for (size_t i = 0; i < VectorSize<T>(); ++i) {
+      Set(fIota, i, Scalar<T>(i));
+      Set(fIotaIndex, i, Scalar<I>(i));
+    }
+  }
+
+  // Moves to the group of threads starting at x, y, z of the block
+  void Select(size_t x, size_t y, size_t z)
+  {
+    fX     = size_t(blockIdx.x) * blockDim.x + x;
+    fLanes = std::min(VectorSize<T>(), size_t(blockDim.x) - x);
+
+    threadIdx.x = I(Scalar<I>(x)) + fIotaIndex;
+    threadIdx.y = I(Scalar<I>(y));
+    threadIdx.z = I(Scalar<I>(z));
+    active      = fIota < T(Scalar<T>(fLanes));
+  }
+
+  // blockIdx.x * blockDim.x + threadIdx.x
+  I GlobalX() const { return I(Scalar<I>(fX)) + fIotaIndex; }
+
+  // Active lanes with GlobalX() below n, as for if (i < n) in CUDA kernels
+  Mask<T> Below(size_t n) const
+  {
+    const size_t lanes = n > fX ? std::min(fLanes, n - fX) : 0;
+    return fIota < T(Scalar<T>(lanes));
+  }
+
+private:
+  T fIota;
+  I fIotaIndex;
+  size_t fX;
+  size_t fLanes;
+};
+
+// Threads running the calls of Run(), together with the thread calling it.
+// Calls of Run() from several threads run one after the other, and calls
+// from within Run(), e.g. by a kernel, run on the calling thread only.
+class ThreadPool {
+public:
+  // The pool used by Launch() without one, with one thread per core
+  static ThreadPool &Instance()
+  {
+    static ThreadPool pool(std::max(std::thread::hardware_concurrency(), 1u) - 1);
+    return pool;
+  }
+
+  explicit ThreadPool(size_t workers) : fJob(nullptr), fGeneration(0), fStop(false)
+  {
+    for (size_t i = 0; i < workers; ++i)
+      fWorkers.emplace_back([this] { Loop(); });
+  }
+
+  ThreadPool(const ThreadPool &) = delete;
+  ThreadPool &operator=(const ThreadPool &) = delete;
+
+  ~ThreadPool()
+  {
+    {
+      std::lock_guard<std::mutex> lock(fMutex);
+      fStop = true;
+    }
+    fWake.notify_all();
+    for (auto &worker : fWorkers)
+      worker.join();
+  }
+
+  // Number of threads running calls, including the caller of Run()
+  size_t Size() const { return fWorkers.size() + 1; }
+
+  // Calls f(i) for 0 <= i < n and returns when all calls are done. The first
+  // exception thrown by a call is rethrown, and calls not started yet are
+  // skipped.
+  void Run(size_t n, const std::function<void(size_t)> &f)
+  {
+    if (fWorkers.empty() || n < 2 || InPool()) {
+      for (size_t i = 0; i < n; ++i)
+        f(i);
+      return;
+    }
+
+    std::lock_guard<std::mutex> run(fRunMutex);
+
+    Job job(n, f);
+    {
+      std::lock_guard<std::mutex> lock(fMutex);
+      fJob = &job;
+      ++fGeneration;
+    }
+    fWake.notify_all();
+
+    InPool() = true;
+    Work(job);
+    InPool() = false;
+
+    {
+      std::unique_lock<std::mutex> lock(fMutex);
+      fDone.wait(lock, [&] { return job.workers == 0; });
+      fJob = nullptr;
+    }
+
+    if (job.error) std::rethrow_exception(job.error);
+  }
+
+private:
+  struct Job {
+    Job(size_t n, const std::function<void(size_t)> &f) : n(n), f(f), next(0), workers(0) {}
+
+    const size_t n;
+    const std::function<void(size_t)> &f;
+    std::atomic<size_t> next;
+    size_t workers; // guarded by fMutex
+    std::exception_ptr error;
+  };
+
+  // Whether this thread is running calls of Run(), from any pool
+  static bool &InPool()
+  {
+    static thread_local bool inPool = false;
+    return inPool;
+  }
+
+  void Work(Job &job)
+  {
+    for (size_t i; (i = job.next.fetch_add(1, std::memory_order_relaxed)) < job.n;) {
+      try {
+        job.f(i);
+      } catch (...) {
+        std::lock_guard<std::mutex> lock(fMutex);
+        if (!job.error) job.error = std::current_exception();
+        job.next.store(job.n, std::memory_order_relaxed);
+      }
+    }
+  }
+
+  void Loop()
+  {
+    InPool() = true;
+
+    size_t generation = 0;
+    for (;;) {
+      Job *job;
+      {
+        std::unique_lock<std::mutex> lock(fMutex);
+        fWake.wait(lock, [&] { return fStop || fGeneration != generation; });
+        if (fStop) return;
+        generation = fGeneration;
+        job        = fJob;
+        if (!job) continue;
+        ++job->workers;
+      }
+
+      Work(*job);
+
+      {
+        std::lock_guard<std::mutex> lock(fMutex);
+        if (--job->workers == 0) fDone.notify_all();
+      }
+    }
+  }
+
+  std::vector<std::thread> fWorkers;
+  std::mutex fRunMutex;
+  std::mutex fMutex;
+  std::condition_variable fWake;
+  std::condition_variable fDone;
+  Job *fJob;
+  size_t fGeneration;
+  bool fStop;
+};
+
+// Runs kernel(thread, args...) for all threads of a grid of blocks, with the
+// lanes of T as threads, and returns when all are done
+template <typename T = Real_s, typename Kernel, typename... Args>
+void Launch(ThreadPool &pool, const Dim3 &grid, const Dim3 &block, const Kernel &kernel, const Args &... args)
+{
+  pool.Run(grid.Size(), [&](size_t b) {
+    const Dim3 index(unsigned(b % grid.x), unsigned(b / grid.x % grid.y), unsigned(b / grid.x / grid.y));
+
+    Thread<T> thread(grid, block, index);
+    for (size_t z = 0; z < block.z; ++z)
+      for (size_t y = 0; y < block.y; ++y)
+        for (size_t x = 0; x < block.x; x += VectorSize<T>()) {
+          thread.Select(x, y, z);
+          kernel(static_cast<const Thread<T> &>(thread), args...);
+        }
+  });
+}
+
+template <typename T = Real_s, typename Kernel, typename... Args>
+void Launch(const Dim3 &grid, const Dim3 &block, const Kernel &kernel, const Args &... args)
+{
+  Launch<T>(ThreadPool::Instance(), grid, block, kernel, args...);
+}
+
+} // namespace cpu
+} // namespace vecCore
+
+#endif
@@ -0,0 +1,163 @@
+#ifndef VECCORE_MATRIX3X3_H
+#define VECCORE_MATRIX3X3_H
+
+#include "Vector3D.h"
+
+namespace vecCore {
+
+// 3x3 matrices, stored in row-major order with each of the nine elements held
+// in a separate backend vector, such that each lane is an independent matrix.
+// As for Vector3D<T>, the scalar type is Matrix3x3<Scalar<T>>.
+
+template <typename T>
+class Matrix3x3 {
+public:
+  using Scalar_t = Scalar<T>;
+
+  // Identity matrix
+  VECCORE_FORCE_INLINE
+  VECCORE_ATT_HOST_DEVICE
+  Matrix3x3()
+  {
+    for (int i = 0; i < 9; ++i)
+      fM[i] = T(Scalar_t(i % 4 == 0 ? 1 : 0));
+  }
+
+  VECCORE_FORCE_INLINE
+  VECCORE_ATT_HOST_DEVICE
+  Matrix3x3(const T &xx, const T &xy, const T &xz, const T &yx, const T &yy, const T &yz, const T &zx, const T &zy,
+            const T &zz)
+      : fM{xx, xy, xz, yx, yy, yz, zx, zy, zz}
+  {
+  }
+
+  // Matrix with the given rows
+  VECCORE_FORCE_INLINE
+  VECCORE_ATT_HOST_DEVICE
+  Matrix3x3(const Vector3D<T> &x, const Vector3D<T> &y, const Vector3D<T> &z)
+      : fM{x.X(), x.Y(), x.Z(), y.X(), y.Y(), y.Z(), z.X(), z.Y(), z.Z()}
+  {
+  }
+
+  VECCORE_FORCE_INLINE
+  VECCORE_ATT_HOST_DEVICE
+  T &operator()(int i, int j) { return fM[3 * i + j]; }
+
+  VECCORE_FORCE_INLINE
+  VECCORE_ATT_HOST_DEVICE
+  T const &operator()(int i, int j) const { return fM[3 * i + j]; }
+
+  // Elements in row-major order
+  VECCORE_FORCE_INLINE
+  VECCORE_ATT_HOST_DEVICE
+  T &operator[](int i) { return fM[i]; }
+
+  VECCORE_FORCE_INLINE
+  VECCORE_ATT_HOST_DEVICE
+  T const &operator[](int i) const { return fM[i]; }
+
+  VECCORE_FORCE_INLINE
+  VECCORE_ATT_HOST_DEVICE
+  Vector3D<T> Row(int i) const { return Vector3D<T>(fM[3 * i], fM[3 * i + 1], fM[3 * i + 2]); }
+
+  VECCORE_FORCE_INLINE
+  VECCORE_ATT_HOST_DEVICE
+  Vector3D<T> Column(int j) const { return Vector3D<T>(fM[j], fM[3 + j], fM[6 + j]); }
+
+  VECCORE_FORCE_INLINE
+  VECCORE_ATT_HOST_DEVICE
+  Matrix3x3 Transpose() const { return Matrix3x3(Column(0), Column(1), Column(2)); }
+
+  VECCORE_FORCE_INLINE
+  VECCORE_ATT_HOST_DEVICE
+  T Determinant() const { return math::Dot(Row(0), math::Cross(Row(1), Row(2))); }
+
+  // Inverse from the adjugate, undefined for singular matrices. For rotation
+  // matrices, use the much cheaper Transpose() instead.
+  VECCORE_FORCE_INLINE
+  VECCORE_ATT_HOST_DEVICE
+  Matrix3x3 Inverse() const
+  {
+    Vector3D<T> c0 = math::Cross(Row(1), Row(2));
+    Vector3D<T> c1 = math::Cross(Row(2), Row(0));
+    Vector3D<T> c2 = math::Cross(Row(0), Row(1));
+    T invdet       = T(Scalar_t(1)) / math::Dot(Row(0), c0);
+    return Matrix3x3(c0 * invdet, c1 * invdet, c2 * invdet).Transpose();
+  }
+
+  VECCORE_FORCE_INLINE
+  VECCORE_ATT_HOST_DEVICE
+  Matrix3x3 &operator*=(const Matrix3x3 &m) { return *this = *this * m; }
+
+  VECCORE_FORCE_INLINE
+  VECCORE_ATT_HOST_DEVICE
+  friend Vector3D<T> operator*(const Matrix3x3 &m, const Vector3D<T> &v)
+  {
+    return Vector3D<T>(math::Dot(m.Row(0), v), math::Dot(m.Row(1), v), math::Dot(m.Row(2), v));
+  }
+
+  VECCORE_FORCE_INLINE
+  VECCORE_ATT_HOST_DEVICE
+  friend Matrix3x3 operator*(const Matrix3x3 &a, const Matrix3x3 &b)
+  {
+    Matrix3x3 c;
+    for (int i = 0; i < 3; ++i)
+      for (int j = 0; j < 3; ++j)
+        c(i, j) = math::FMA(a(i, 0), b(0, j), math::FMA(a(i, 1), b(1, j), T(a(i, 2) * b(2, j))));
+    return c;
+  }
+
+private:
+  T fM[9];
+};
+
+template <typename T>
+struct TypeTraits<Matrix3x3<T>> {
+  using ScalarType = Matrix3x3<Scalar<T>>;
+  using MaskType   = Mask<T>;
+  using IndexType  = Index<T>;
+};
+
+template <typename T>
+struct IndexingImplementation<Matrix3x3<T>> {
+  VECCORE_FORCE_INLINE
+  VECCORE_ATT_HOST_DEVICE
+  static Matrix3x3<Scalar<T>> Get(const Matrix3x3<T> &m, size_t i)
+  {
+    Matrix3x3<Scalar<T>> val;
+    for (int k = 0; k < 9; ++k)
+      val[k] = vecCore::Get(m[k], i);
+    return val;
+  }
+
+  VECCORE_FORCE_INLINE
+  VECCORE_ATT_HOST_DEVICE
+  static void Set(Matrix3x3<T> &m, size_t i, Matrix3x3<Scalar<T>> const val)
+  {
+    for (int k = 0; k < 9; ++k)
+      vecCore::Set(m[k], i, val[k]);
+  }
+};
+
+template <typename T>
+struct MaskingImplementation<Matrix3x3<T>> {
+  VECCORE_FORCE_INLINE
+  VECCORE_ATT_HOST_DEVICE
+  static void Assign(Matrix3x3<T> &dst, Mask<T> const &mask, Matrix3x3<T> const &src)
+  {
+    for (int k = 0; k < 9; ++k)
+      vecCore::MaskedAssign(dst[k], mask, src[k]);
+  }
+
+  VECCORE_FORCE_INLINE
+  VECCORE_ATT_HOST_DEVICE
+  static void Blend(Matrix3x3<T> &dst, Mask<T> const &mask, Matrix3x3<T> const &src1, Matrix3x3<T> const &src2)
+  {
+    for (int k = 0; k < 9; ++k)
+      dst[k] = vecCore::Blend(mask, src1[k], src2[k]);
+  }
+};
+
+} // namespace vecCore
+
+#endif
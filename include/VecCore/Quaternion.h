@@ -0,0 +1,203 @@
+#ifndef VECCORE_QUATERNION_H
+#define VECCORE_QUATERNION_H
+
+#include "Matrix3x3.h"
+
+namespace vecCore {
+
+// Quaternions w + x i + y j + z k, with each component in a separate backend
+// vector, such that each lane is an independent quaternion. Unit quaternions
+// represent rotations, which are composed by multiplication: (q1 * q2) rotates
+// first by q2, then by q1. As for Vector3D<T>, the scalar type is
+// Quaternion<Scalar<T>>.
+
+template <typename T>
+class Quaternion {
+public:
+  using Scalar_t = Scalar<T>;
+
+  // Identity rotation
+  VECCORE_FORCE_INLINE
+  VECCORE_ATT_HOST_DEVICE
+  Quaternion() : fW(Scalar_t(1)), fV() {}
+
+  VECCORE_FORCE_INLINE
+  VECCORE_ATT_HOST_DEVICE
+  Quaternion(const T &w, const T &x, const T &y, const T &z) : fW(w), fV(x, y, z) {}
+
+  VECCORE_FORCE_INLINE
+  VECCORE_ATT_HOST_DEVICE
+  Quaternion(const T &w, const Vector3D<T> &v) : fW(w), fV(v) {}
+
+  // Rotation by the given angle around the given unit vector
+  VECCORE_FORCE_INLINE
+  VECCORE_ATT_HOST_DEVICE
+  static Quaternion AxisAngle(const Vector3D<T> &axis, const T &angle)
+  {
+    T s, c;
+    math::SinCos(T(Scalar_t(0.5) * angle), &s, &c);
+    return Quaternion(c, axis * s);
+  }
+
+  VECCORE_FORCE_INLINE
+  VECCORE_ATT_HOST_DEVICE
+  T &W() { return fW; }
+
+  VECCORE_FORCE_INLINE
+  VECCORE_ATT_HOST_DEVICE
+  T const &W() const { return fW; }
+
+  VECCORE_FORCE_INLINE
+  VECCORE_ATT_HOST_DEVICE
+  T &X() { return fV.X(); }
+
+  VECCORE_FORCE_INLINE
+  VECCORE_ATT_HOST_DEVICE
+  T const &X() const { return fV.X(); }
+
+  VECCORE_FORCE_INLINE
+  VECCORE_ATT_HOST_DEVICE
+  T &Y() { return fV.Y(); }
+
+  VECCORE_FORCE_INLINE
+  VECCORE_ATT_HOST_DEVICE
+  T const &Y() const { return fV.Y(); }
+
+  VECCORE_FORCE_INLINE
+  VECCORE_ATT_HOST_DEVICE
+  T &Z() { return fV.Z(); }
+
+  VECCORE_FORCE_INLINE
+  VECCORE_ATT_HOST_DEVICE
+  T const &Z() const { return fV.Z(); }
+
+  // Vector (imaginary) part
+  VECCORE_FORCE_INLINE
+  VECCORE_ATT_HOST_DEVICE
+  Vector3D<T> &V() { return fV; }
+
+  VECCORE_FORCE_INLINE
+  VECCORE_ATT_HOST_DEVICE
+  Vector3D<T> const &V() const { return fV; }
+
+  VECCORE_FORCE_INLINE
+  VECCORE_ATT_HOST_DEVICE
+  T Norm2() const { return math::FMA(fW, fW, fV.Mag2()); }
+
+  VECCORE_FORCE_INLINE
+  VECCORE_ATT_HOST_DEVICE
+  T Norm() const { return math::Sqrt(Norm2()); }
+
+  // Renormalization, to be applied now and then to quaternions obtained by
+  // many compositions, to keep rounding errors from accumulating
+  VECCORE_FORCE_INLINE
+  VECCORE_ATT_HOST_DEVICE
+  void Normalize()
+  {
+    T n = math::RSqrt(Norm2());
+    fW *= n;
+    fV *= n;
+  }
+
+  VECCORE_FORCE_INLINE
+  VECCORE_ATT_HOST_DEVICE
+  Quaternion Conj() const { return Quaternion(fW, -fV); }
+
+  // Inverse, equal to Conj() for unit quaternions
+  VECCORE_FORCE_INLINE
+  VECCORE_ATT_HOST_DEVICE
+  Quaternion Inverse() const
+  {
+    T n = T(Scalar_t(1)) / Norm2();
+    return Quaternion(fW * n, fV * T(-n));
+  }
+
+  // Rotation of a vector by a unit quaternion, without forming the matrix
+  VECCORE_FORCE_INLINE
+  VECCORE_ATT_HOST_DEVICE
+  Vector3D<T> Rotate(const Vector3D<T> &v) const
+  {
+    Vector3D<T> t = math::Cross(fV, v) * T(Scalar_t(2));
+    return v + t * fW + math::Cross(fV, t);
+  }
+
+  // Rotation matrix of a unit quaternion, cheaper than repeated Rotate() calls
+  // when transforming several vectors with the same rotation
+  VECCORE_FORCE_INLINE
+  VECCORE_ATT_HOST_DEVICE
+  Matrix3x3<T> RotationMatrix() const
+  {
+    const T one(Scalar_t(1)), two(Scalar_t(2));
+    T x = fV.X(), y = fV.Y(), z = fV.Z();
+    T wx = fW * x, wy = fW * y, wz = fW * z;
+    T xx = x * x, xy = x * y, xz = x * z;
+    T yy = y * y, yz = y * z, zz = z * z;
+    return Matrix3x3<T>(one - two * (yy + zz), two * (xy - wz), two * (xz + wy),
+                        two * (xy + wz), one - two * (xx + zz), two * (yz - wx),
+                        two * (xz - wy), two * (yz + wx), one - two * (xx + yy));
+  }
+
+  VECCORE_FORCE_INLINE
+  VECCORE_ATT_HOST_DEVICE
+  Quaternion &operator*=(const Quaternion &q) { return *this = *this * q; }
+
+  // Hamilton product
+  VECCORE_FORCE_INLINE
+  VECCORE_ATT_HOST_DEVICE
+  friend Quaternion operator*(const Quaternion &p, const Quaternion &q)
+  {
+    return Quaternion(math::FMA(p.fW, q.fW, T(-math::Dot(p.fV, q.fV))),
+                      q.fV * p.fW + p.fV * q.fW + math::Cross(p.fV, q.fV));
+  }
+
+private:
+  T fW;
+  Vector3D<T> fV;
+};
+
+template <typename T>
+struct TypeTraits<Quaternion<T>> {
+  using ScalarType = Quaternion<Scalar<T>>;
+  using MaskType   = Mask<T>;
+  using IndexType  = Index<T>;
+};
+
+template <typename T>
+struct IndexingImplementation<Quaternion<T>> {
+  VECCORE_FORCE_INLINE
+  VECCORE_ATT_HOST_DEVICE
+  static Quaternion<Scalar<T>> Get(const Quaternion<T> &q, size_t i)
+  {
+    return Quaternion<Scalar<T>>(vecCore::Get(q.W(), i), vecCore::Get(q.V(), i));
+  }
+
+  VECCORE_FORCE_INLINE
+  VECCORE_ATT_HOST_DEVICE
+  static void Set(Quaternion<T> &q, size_t i, Quaternion<Scalar<T>> const val)
+  {
+    vecCore::Set(q.W(), i, val.W());
+    vecCore::Set(q.V(), i, val.V());
+  }
+};
+
+template <typename T>
+struct MaskingImplementation<Quaternion<T>> {
+  VECCORE_FORCE_INLINE
+  VECCORE_ATT_HOST_DEVICE
+  static void Assign(Quaternion<T> &dst, Mask<T> const &mask, Quaternion<T> const &src)
+  {
+    vecCore::MaskedAssign(dst.W(), mask, src.W());
+    vecCore::MaskedAssign(dst.V(), mask, src.V());
+  }
+
+  VECCORE_FORCE_INLINE
+  VECCORE_ATT_HOST_DEVICE
+  static void Blend(Quaternion<T> &dst, Mask<T> const &mask, Quaternion<T> const &src1, Quaternion<T> const &src2)
+  {
+    dst = Quaternion<T>(vecCore::Blend(mask, src1.W(), src2.W()), vecCore::Blend(mask, src1.V(), src2.V()));
+  }
+};
+
+} // namespace vecCore
+
+#endif
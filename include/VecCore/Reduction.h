@@ -0,0 +1,475 @@
+#ifndef VECCORE_REDUCTION_H
+#define VECCORE_REDUCTION_H
+
+#include "Backend/Interface.h"
+#include "Backend/Implementation.h"
+#include "Limits.h"
+#include "VecMath.h"
+
+#include <cmath>
+#include <limits>
+
+namespace vecCore {
+
+// Reductions of arrays, processed with the backend type T
+
+namespace detail {
+
+struct ArgMinCompare {
+  template <typename S>
+  static bool Better(const S &a, const S &b)
+  {
+    return a < b;
+  }
+
+  template <typename T, typename I>
+  VECCORE_FORCE_INLINE
+  static void Update(T &a, const T &b, I &ia, const I &ib)
+  {
+    MinIndex(a, b, ia, ib);
+  }
+};
+
+struct ArgMaxCompare {
+  template <typename S>
+  static bool Better(const S &a, const S &b)
+  {
+    return a > b;
+  }
+
+  template <typename T, typename I>
+  VECCORE_FORCE_INLINE
+  static void Update(T &a, const T &b, I &ia, const I &ib)
+  {
+    MaxIndex(a, b, ia, ib);
+  }
+};
+
+// Each lane keeps the best element among those it has seen, together with
+// its index in a vector of type Index<T>. The lanes are merged at the end.
+// Indices are relative to the start of chunks short enough for them to fit
+// into the scalar type of Index<T>.
+template <typename T, class Compare>
+size_t ArgBest(Scalar<T> const *x, size_t n)
+{
+  using I  = Index<T>;
+  using S  = Scalar<T>;
+  using SI = Scalar<I>;
+
+  constexpr size_t kVS = VectorSize<T>();
+
+  if (n == 0) return 0;
+
+  const size_t limit = size_t(NumericLimits<SI>::Max()) / kVS;
+  const size_t chunk = (limit > (size_t(1) << 48) ? (size_t(1) << 48) : limit - 1) * kVS;
+  const size_t nv    = n - n % kVS;
+
+  size_t best = 0;
+  S value     = x[0];
+
+  I lanes = I(SI(0));
+  for (size_t k = 0; k < kVS; ++k)
+    Set(lanes, k, SI(k));
+
+  for (size_t start = 0; start < nv; start += chunk) {
+    const size_t len = nv - start < chunk ? nv - start : chunk;
+
+    T v = T(S(0)), w = T(S(0));
+    I iv = lanes, iw = lanes;
+    const I step = I(SI(kVS));
+
+    Load(v, x + start);
+    for (size_t i = kVS; i < len; i += kVS) {
+      Load(w, x + start + i);
+      iw += step;
+      Compare::Update(v, w, iv, iw);
+    }
+
+    for (size_t k = 0; k < kVS; ++k) {
+      const S y      = Get(v, k);
+      const size_t j = start + size_t(Get(iv, k));
+      if (Compare::Better(y, value) || (y == value && j < best)) {
+        value = y;
+        best  = j;
+      }
+    }
+  }
+
+  for (size_t i = nv; i < n; ++i) {
+    if (Compare::Better(x[i], value)) {
+      value = x[i];
+      best  = i;
+    }
+  }
+
+  return best;
+}
+} // namespace detail
+
+// Index of the first smallest or largest of the n elements of x, or 0 if n
+// is 0. The elements must not be NaN.
+
+template <typename T>
+size_t ArgMin(Scalar<T> const *x, size_t n)
+{
+  return detail::ArgBest<T, detail::ArgMinCompare>(x, n);
+}
+
+template <typename T>
+size_t ArgMax(Scalar<T> const *x, size_t n)
+{
+  return detail::ArgBest<T, detail::ArgMaxCompare>(x, n);
+}
+
+// Largest absolute value of the n elements of x, or 0 if n is 0
+
+template <typename T>
+Scalar<T> MaxAbs(Scalar<T> const *x, size_t n)
+{
+  using S = Scalar<T>;
+
+  constexpr size_t kVS = VectorSize<T>();
+
+  T m = T(S(0)), v = T(S(0));
+  size_t i = 0;
+  for (; i + kVS <= n; i += kVS) {
+    Load(v, x + i);
+    m = math::Max(m, math::Abs(v));
+  }
+
+  S result = ReduceMax(m);
+  for (; i < n; ++i)
+    result = std::max(result, std::abs(x[i]));
+  return result;
+}
+
+namespace detail {
+// Type in which the folds of a reproducible sum are kept, and the number of
+// elements summed in lanes of the input type before they are moved into it.
+// A block size of 0 means that all elements are summed in lanes.
+template <typename S>
+struct ReproducibleTraits;
+
+template <>
+struct ReproducibleTraits<float> {
+  using Wide_t = double;
+  static constexpr size_t kBlock = 1024;
+};
+
+template <>
+struct ReproducibleTraits<double> {
+  using Wide_t = double;
+  static constexpr size_t kBlock = 0;
+};
+}
+
+// Reproducible summation, following Demmel and Nguyen.
+//
+// Each element is split into K parts with extractors M_k = 1.5 * 2^e_k, as
+// q = (M_k + r) - M_k and r -= q. The exponents e_k are fixed from a bound
+// on the absolute values of all elements and on how many are summed, so the
+// parts of each fold are multiples of the same power of two, and their sums
+// are exact. The result thus does not depend on the order of the additions:
+// it is the same bit for bit for any backend, vector size, and split of the
+// elements between accumulators, which are combined with Merge(). Parts below
+// the last fold are dropped, which bounds the error by about n * max|x| times
+// 2^(-K * (p - 1 - log2(n))) for p bits of mantissa (for Float_v, the number
+// of elements between moves of the lanes to the wide folds instead of n).
+//
+//   ReproducibleAccumulator<Double_v> sum(MaxAbs<Double_v>(x, n), n);
+//   sum.Add(x, n);
+//   double s = sum.Result();
+//
+// All accumulators which are merged must be created with the same bound and
+// number of elements, which must cover all elements added to any of them. The
+// elements must be finite, and the bound times 4 n (4096 for single precision)
+// must not overflow.
+
+template <typename T, size_t K = 3>
+class ReproducibleAccumulator {
+public:
+  using Scalar_t = Scalar<T>;
+  using Wide_t   = typename detail::ReproducibleTraits<Scalar_t>::Wide_t;
+
+  ReproducibleAccumulator(Scalar_t maxAbs, size_t n) : fFolds(0), fPending(0)
+  {
+    const size_t block = detail::ReproducibleTraits<Scalar_t>::kBlock;
+    fCapacity          = block ? block : (n > 0 ? n : 1);
+
+    int c = 0;
+    while ((size_t(1) << c) < fCapacity)
+      ++c;
+
+    const int digits = std::numeric_limits<Scalar_t>::digits;
+    const int minExp = std::numeric_limits<Scalar_t>::min_exponent - 1;
+
+    // 2^e_0 >= 2 n max|x| and 2^e_(k+1) >= 2 n max|r_k|, with |r_k| <= 2^(e_k - digits).
+    // The parts of a fold with e_k = minExp are multiples of the smallest subnormal.
+    int e = maxAbs > Scalar_t(0) ? std::max(std::ilogb(maxAbs) + 2 + c, minExp) : minExp - 1;
+    for (; fFolds < K && e >= minExp; ++fFolds, e -= digits - 1 - c)
+      fM[fFolds] = std::ldexp(Scalar_t(1.5), e);
+
+    for (size_t k = 0; k < K; ++k) {
+      fLanes[k] = T(Scalar_t(0));
+      fSum[k]   = Wide_t(0);
+    }
+  }
+
+  void Add(const T &v)
+  {
+    if (fPending + VectorSize<T>() > fCapacity) Flush();
+    fPending += VectorSize<T>();
+    Deposit(fLanes, v);
+  }
+
+  void Add(Scalar_t const *x, size_t n)
+  {
+    constexpr size_t kVS = VectorSize<T>();
+
+    // local copies of the lanes, which could otherwise alias x
+    T lanes[K], v = T(Scalar_t(0));
+    for (size_t k = 0; k < K; ++k)
+      lanes[k] = fLanes[k];
+
+    size_t i = 0;
+    for (; i + kVS <= n; i += kVS) {
+      if (fPending + kVS > fCapacity) {
+        for (size_t k = 0; k < K; ++k) {
+          fLanes[k] = lanes[k];
+          lanes[k]  = T(Scalar_t(0));
+        }
+        Flush();
+      }
+      fPending += kVS;
+      Load(v, x + i);
+      Deposit(lanes, v);
+    }
+
+    for (size_t k = 0; k < K; ++k)
+      fLanes[k] = lanes[k];
+
+    for (; i < n; ++i)
+      AddScalar(x[i]);
+  }
+
+  void Merge(const ReproducibleAccumulator &other)
+  {
+    for (size_t k = 0; k < fFolds; ++k)
+      fSum[k] += other.fSum[k] + Wide_t(ReduceAdd(other.fLanes[k]));
+  }
+
+  Scalar_t Result() const
+  {
+    Wide_t sum(0);
+    for (size_t k = 0; k < fFolds; ++k)
+      sum += fSum[k] + Wide_t(ReduceAdd(fLanes[k]));
+    return Scalar_t(sum);
+  }
+
+private:
+  void Deposit(T (&lanes)[K], T r) const
+  {
+    for (size_t k = 0; k < fFolds; ++k) {
+      const T M(fM[k]);
+      const T q = (M + r) - M;
+      lanes[k] += q;
+      r -= q;
+    }
+  }
+
+  void AddScalar(Scalar_t x)
+  {
+    for (size_t k = 0; k < fFolds; ++k) {
+      const Scalar_t q = (fM[k] + x) - fM[k];
+      fSum[k] += Wide_t(q);
+      x -= q;
+    }
+  }
+
+  // lanes hold at most fCapacity parts per fold, so their sum is exact
+  void Flush()
+  {
+    for (size_t k = 0; k < fFolds; ++k) {
+      fSum[k] += Wide_t(ReduceAdd(fLanes[k]));
+      fLanes[k] = T(Scalar_t(0));
+    }
+    fPending = 0;
+  }
+
+  Scalar_t fM[K];
+  size_t fFolds;
+  size_t fCapacity;
+  size_t fPending;
+  T fLanes[K];
+  Wide_t fSum[K];
+};
+
+// Sum of the n elements of x, which is the same for all backends
+
+template <typename T>
+Scalar<T> ReproducibleSum(Scalar<T> const *x, size_t n)
+{
+  ReproducibleAccumulator<T> sum(MaxAbs<T>(x, n), n);
+  sum.Add(x, n);
+  return sum.Result();
+}
+
+namespace detail {
+// Sum of a and b, with the rounding error of the sum in err (Knuth's TwoSum)
+template <typename T>
+VECCORE_FORCE_INLINE
+VECCORE_ATT_HOST_DEVICE
+T TwoSum(const T &a, const T &b, T &err)
+{
+  const T s  = a + b;
+  const T bp = s - a;
+  err        = (a - (s - bp)) + (b - bp);
+  return s;
+}
+}
+
+// Compensated summation in each lane.
+//
+// The rounding error of every addition is computed exactly and added to a
+// separate compensation, as in the Kahan-Babuska-Neumaier algorithm, so the
+// result is accurate to about one rounding of the final sum, independently of
+// the number of elements, for six more additions per element. The lanes are
+// combined, also with compensation, only by Result().
+//
+//   KahanAccumulator<Float_v> sum;
+//   for (...)
+//     sum.Add(edep, inside);  // masked add for divergent loops
+//   float total = sum.Result();
+
+template <typename T>
+class KahanAccumulator {
+public:
+  using Scalar_t = Scalar<T>;
+
+  KahanAccumulator() : fSum(Scalar_t(0)), fComp(Scalar_t(0)) {}
+
+  void Add(const T &x)
+  {
+    T err;
+    fSum = detail::TwoSum(fSum, x, err);
+    fComp += err;
+  }
+
+  // Adds the lanes of x where mask is true
+  void Add(const T &x, const Mask<T> &mask) { Add(Blend(mask, x, T(Scalar_t(0)))); }
+
+  void Add(Scalar_t const *x, size_t n)
+  {
+    constexpr size_t kVS = VectorSize<T>();
+
+    T v = T(Scalar_t(0));
+    size_t i = 0;
+    for (; i + kVS <= n; i += kVS) {
+      Load(v, x + i);
+      Add(v);
+    }
+
+    if (i < n) {
+      v = T(Scalar_t(0));
+      for (size_t k = 0; i + k < n; ++k)
+        Set(v, k, x[i + k]);
+      Add(v);
+    }
+  }
+
+  void Merge(const KahanAccumulator &other)
+  {
+    Add(other.fSum);
+    fComp += other.fComp;
+  }
+
+  Scalar_t Result() const
+  {
+    Scalar_t sum(0), comp(0), err(0);
+    for (size_t i = 0; i < VectorSize<T>(); ++i) {
+      sum = detail::TwoSum(sum, Scalar_t(Get(fSum, i)), err);
+      comp += err + Get(fComp, i);
+    }
+    return sum + comp;
+  }
+
+private:
+  T fSum;
+  T fComp;
+};
+
+// Summation of a type T in the wider type W with fewer lanes, such as Float_v
+// in Double_v. Each vector of T is converted to VectorSize<T>() /
+// VectorSize<W>() vectors of W, which are summed in separate accumulators.
+// The relative error is then about n times the precision of W, instead of n
+// times that of T, for one conversion and one more addition per vector of T.
+//
+//   WideningAccumulator<Float_v, Double_v> sum;
+//   sum.Add(edep, n);
+//   double total = sum.Result();
+
+template <typename T, typename W>
+class WideningAccumulator {
+public:
+  using Scalar_t = Scalar<T>;
+  using Wide_t   = Scalar<W>;
+
+  static constexpr size_t kParts = VectorSize<T>() / VectorSize<W>();
+
+  static_assert(VectorSize<T>() % VectorSize<W>() == 0, "W must have fewer lanes than T");
+
+  WideningAccumulator()
+  {
+    for (size_t p = 0; p < kParts; ++p)
+      fSum[p] = W(Wide_t(0));
+  }
+
+  void Add(const T &x)
+  {
+    for (size_t p = 0; p < kParts; ++p)
+      fSum[p] += Widen<W>(x, p);
+  }
+
+  // Adds the lanes of x where mask is true
+  void Add(const T &x, const Mask<T> &mask) { Add(Blend(mask, x, T(Scalar_t(0)))); }
+
+  void Add(Scalar_t const *x, size_t n)
+  {
+    constexpr size_t kVS = VectorSize<T>();
+
+    T v = T(Scalar_t(0));
+    size_t i = 0;
+    for (; i + kVS <= n; i += kVS) {
+      Load(v, x + i);
+      Add(v);
+    }
+
+    if (i < n) {
+      v = T(Scalar_t(0));
+      for (size_t k = 0; i + k < n; ++k)
+        Set(v, k, x[i + k]);
+      Add(v);
+    }
+  }
+
+  void Merge(const WideningAccumulator &other)
+  {
+    for (size_t p = 0; p < kParts; ++p)
+      fSum[p] += other.fSum[p];
+  }
+
+  Wide_t Result() const
+  {
+    W sum = fSum[0];
+    for (size_t p = 1; p < kParts; ++p)
+      sum += fSum[p];
+    return ReduceAdd(sum);
+  }
+
+private:
+  W fSum[kParts];
+};
+
+} // namespace vecCore
+
+#endif
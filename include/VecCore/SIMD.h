@@ -1,8 +1,10 @@
 #ifndef VECCORE_SIMD_H
 #define VECCORE_SIMD_H
 
-#if defined(__i386__) || defined(__x86_64__)
-#include <x86intrin.h>
+// Only for _mm_sfence() in StoreFence(), as <x86intrin.h> takes several
+// times longer to parse; the backends include the intrinsics they use
+#if defined(__SSE__)
+#include <xmmintrin.h>
 #endif
 
 #if defined(__AVX512F__) || defined(__MIC__)
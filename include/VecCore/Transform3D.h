@@ -0,0 +1,149 @@
+#ifndef VECCORE_TRANSFORM3D_H
+#define VECCORE_TRANSFORM3D_H
+
+#include "Quaternion.h"
+
+namespace vecCore {
+
+// Rigid body transformations p -> R p + t, with R a rotation matrix and t a
+// translation vector, i.e. the affine 4x4 matrix
+//
+//   | R t |
+//   | 0 1 |
+//
+// without its constant last row. Each lane holds an independent transform.
+// (a * b) applies first b, then a. As for Vector3D<T>, the scalar type is
+// Transform3D<Scalar<T>>.
+
+template <typename T>
+class Transform3D {
+public:
+  using Scalar_t = Scalar<T>;
+
+  // Identity transformation
+  VECCORE_FORCE_INLINE
+  VECCORE_ATT_HOST_DEVICE
+  Transform3D() : fRotation(), fTranslation() {}
+
+  VECCORE_FORCE_INLINE
+  VECCORE_ATT_HOST_DEVICE
+  Transform3D(const Matrix3x3<T> &rotation, const Vector3D<T> &translation)
+      : fRotation(rotation), fTranslation(translation)
+  {
+  }
+
+  VECCORE_FORCE_INLINE
+  VECCORE_ATT_HOST_DEVICE
+  Transform3D(const Quaternion<T> &rotation, const Vector3D<T> &translation)
+      : fRotation(rotation.RotationMatrix()), fTranslation(translation)
+  {
+  }
+
+  VECCORE_FORCE_INLINE
+  VECCORE_ATT_HOST_DEVICE
+  Matrix3x3<T> &Rotation() { return fRotation; }
+
+  VECCORE_FORCE_INLINE
+  VECCORE_ATT_HOST_DEVICE
+  Matrix3x3<T> const &Rotation() const { return fRotation; }
+
+  VECCORE_FORCE_INLINE
+  VECCORE_ATT_HOST_DEVICE
+  Vector3D<T> &Translation() { return fTranslation; }
+
+  VECCORE_FORCE_INLINE
+  VECCORE_ATT_HOST_DEVICE
+  Vector3D<T> const &Translation() const { return fTranslation; }
+
+  VECCORE_FORCE_INLINE
+  VECCORE_ATT_HOST_DEVICE
+  Vector3D<T> TransformPoint(const Vector3D<T> &p) const { return fRotation * p + fTranslation; }
+
+  // Directions are only rotated, not translated
+  VECCORE_FORCE_INLINE
+  VECCORE_ATT_HOST_DEVICE
+  Vector3D<T> TransformDirection(const Vector3D<T> &d) const { return fRotation * d; }
+
+  // Inverse transformations, which rely on the rotation being orthogonal
+  VECCORE_FORCE_INLINE
+  VECCORE_ATT_HOST_DEVICE
+  Vector3D<T> InverseTransformPoint(const Vector3D<T> &p) const
+  {
+    return fRotation.Transpose() * (p - fTranslation);
+  }
+
+  VECCORE_FORCE_INLINE
+  VECCORE_ATT_HOST_DEVICE
+  Vector3D<T> InverseTransformDirection(const Vector3D<T> &d) const { return fRotation.Transpose() * d; }
+
+  VECCORE_FORCE_INLINE
+  VECCORE_ATT_HOST_DEVICE
+  Transform3D Inverse() const
+  {
+    Matrix3x3<T> r = fRotation.Transpose();
+    return Transform3D(r, -(r * fTranslation));
+  }
+
+  VECCORE_FORCE_INLINE
+  VECCORE_ATT_HOST_DEVICE
+  Transform3D &operator*=(const Transform3D &t) { return *this = *this * t; }
+
+  VECCORE_FORCE_INLINE
+  VECCORE_ATT_HOST_DEVICE
+  friend Transform3D operator*(const Transform3D &a, const Transform3D &b)
+  {
+    return Transform3D(a.fRotation * b.fRotation, a.TransformPoint(b.fTranslation));
+  }
+
+private:
+  Matrix3x3<T> fRotation;
+  Vector3D<T> fTranslation;
+};
+
+template <typename T>
+struct TypeTraits<Transform3D<T>> {
+  using ScalarType = Transform3D<Scalar<T>>;
+  using MaskType   = Mask<T>;
+  using IndexType  = Index<T>;
+};
+
+template <typename T>
+struct IndexingImplementation<Transform3D<T>> {
+  VECCORE_FORCE_INLINE
+  VECCORE_ATT_HOST_DEVICE
+  static Transform3D<Scalar<T>> Get(const Transform3D<T> &t, size_t i)
+  {
+    return Transform3D<Scalar<T>>(vecCore::Get(t.Rotation(), i), vecCore::Get(t.Translation(), i));
+  }
+
+  VECCORE_FORCE_INLINE
+  VECCORE_ATT_HOST_DEVICE
+  static void Set(Transform3D<T> &t, size_t i, Transform3D<Scalar<T>> const val)
+  {
+    vecCore::Set(t.Rotation(), i, val.Rotation());
+    vecCore::Set(t.Translation(), i, val.Translation());
+  }
+};
+
+template <typename T>
+struct MaskingImplementation<Transform3D<T>> {
+  VECCORE_FORCE_INLINE
+  VECCORE_ATT_HOST_DEVICE
+  static void Assign(Transform3D<T> &dst, Mask<T> const &mask, Transform3D<T> const &src)
+  {
+    vecCore::MaskedAssign(dst.Rotation(), mask, src.Rotation());
+    vecCore::MaskedAssign(dst.Translation(), mask, src.Translation());
+  }
+
+  VECCORE_FORCE_INLINE
+  VECCORE_ATT_HOST_DEVICE
+  static void Blend(Transform3D<T> &dst, Mask<T> const &mask, Transform3D<T> const &src1, Transform3D<T> const &src2)
+  {
+    dst = Transform3D<T>(vecCore::Blend(mask, src1.Rotation(), src2.Rotation()),
+                         vecCore::Blend(mask, src1.Translation(), src2.Translation()));
+  }
+};
+
+} // namespace vecCore
+
+#endif
@@ -1,7 +1,12 @@
 #ifndef VECCORE_UTILITIES_H
 #define VECCORE_UTILITIES_H
 
+#include "Common.h"
+
+#include <cstddef>
 #include <cstdlib>
+#include <limits>
+#include <new>
 
 namespace vecCore {
 
@@ -19,6 +24,63 @@ inline void AlignedFree(void *ptr)
 {
   free(ptr);
 }
+
+// Allocator for standard containers of backend types, which need stricter
+// alignment than operator new guarantees before C++17, as in
+//
+//   std::vector<Float_v, AlignedAllocator<Float_v>> v(n);
+
+template <typename T, size_t Align = VECCORE_SIMD_ALIGN>
+class AlignedAllocator {
+  static_assert(Align >= alignof(T), "alignment is weaker than that of the value type");
+  static_assert((Align & (Align - 1)) == 0, "alignment must be a power of two");
+
+public:
+  using value_type      = T;
+  using pointer         = T *;
+  using const_pointer   = const T *;
+  using reference       = T &;
+  using const_reference = const T &;
+  using size_type       = size_t;
+  using difference_type = ptrdiff_t;
+
+  // posix_memalign() needs a multiple of sizeof(void *)
+  static constexpr size_t kAlignment = Align < sizeof(void *) ? sizeof(void *) : Align;
+
+  template <typename U>
+  struct rebind {
+    using other = AlignedAllocator<U, Align>;
+  };
+
+  AlignedAllocator() = default;
+
+  template <typename U>
+  AlignedAllocator(const AlignedAllocator<U, Align> &) {}
+
+  T *allocate(size_t n)
+  {
+    if (n > std::numeric_limits<size_t>::max() / sizeof(T)) throw std::bad_alloc();
+    void *ptr = AlignedAlloc(kAlignment, n * sizeof(T));
+    if (!ptr) throw std::bad_alloc();
+    return static_cast<T *>(ptr);
+  }
+
+  void deallocate(T *ptr, size_t) { AlignedFree(ptr); }
+
+  size_t max_size() const { return std::numeric_limits<size_t>::max() / sizeof(T); }
+};
+
+template <typename T, typename U, size_t Align>
+bool operator==(const AlignedAllocator<T, Align> &, const AlignedAllocator<U, Align> &)
+{
+  return true;
+}
+
+template <typename T, typename U, size_t Align>
+bool operator!=(const AlignedAllocator<T, Align> &, const AlignedAllocator<U, Align> &)
+{
+  return false;
+}
 }
 
 #endif
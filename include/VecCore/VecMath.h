@@ -2,6 +2,7 @@
 #define VECCORE_MATH_H
 
 #include <cmath>
+#include <limits>
 
 namespace vecCore {
 namespace math {
@@ -80,6 +81,16 @@ T Sign(const T &x)
   return CopySign(T(1), x);
 }
 
+// Fused Multiply-Add
+
+template <typename T>
+VECCORE_FORCE_INLINE
+VECCORE_ATT_HOST_DEVICE
+T FMA(const T &a, const T &b, const T &c)
+{
+  return a * b + c;
+}
+
 // Trigonometric Functions
 
 template <typename T>
@@ -136,6 +147,17 @@ void SinCos(const Double_s &x, Double_s *s, Double_s *c)
   sincos(x, s, c);
 }
 
+template <typename T, template <typename> class Wrapper>
+VECCORE_FORCE_INLINE
+VECCORE_ATT_HOST_DEVICE
+void SinCos(const Wrapper<T> &x, Wrapper<T> *s, Wrapper<T> *c)
+{
+  T sx, cx;
+  SinCos(static_cast<T>(x), &sx, &cx);
+  *s = sx;
+  *c = cx;
+}
+
 template <typename T>
 VECCORE_FORCE_INLINE
 VECCORE_ATT_HOST_DEVICE
@@ -236,20 +258,32 @@ T Exp(const T &x)
   return std::exp(x);
 }
 
+// The generic versions of Frexp, Ldexp and Ilogb work one element at a time,
+// backends which can manipulate the bits of the exponent in place override them
+
 template <typename T>
 VECCORE_FORCE_INLINE
 VECCORE_ATT_HOST_DEVICE
-T Frexp(const T &x, int *exp)
+T Frexp(const T &x, Exponent<T> *exp)
 {
-  return std::frexp(x, exp);
+  T m(x);
+  for (size_t i = 0; i < VectorSize<T>(); ++i) {
+    int e;
+    Set(m, i, std::frexp(Get(x, i), &e));
+    Set(*exp, i, e);
+  }
+  return m;
 }
 
 template <typename T>
 VECCORE_FORCE_INLINE
 VECCORE_ATT_HOST_DEVICE
-T Ldexp(const T &x, int exp)
+T Ldexp(const T &x, const Exponent<T> &exp)
 {
-  return std::ldexp(x, exp);
+  T y(x);
+  for (size_t i = 0; i < VectorSize<T>(); ++i)
+    Set(y, i, std::ldexp(Get(x, i), Get(exp, i)));
+  return y;
 }
 
 template <typename T>
@@ -268,14 +302,6 @@ T Log10(const T &x)
   return std::log10(x);
 }
 
-template <typename T>
-VECCORE_FORCE_INLINE
-VECCORE_ATT_HOST_DEVICE
-T Modf(const T &x, T *intpart)
-{
-  return std::modf(x, intpart);
-}
-
 template <typename T>
 VECCORE_FORCE_INLINE
 VECCORE_ATT_HOST_DEVICE
@@ -295,9 +321,12 @@ T Expm1(const T &x)
 template <typename T>
 VECCORE_FORCE_INLINE
 VECCORE_ATT_HOST_DEVICE
-T Ilogb(const T &x)
+Exponent<T> Ilogb(const T &x)
 {
-  return std::ilogb(x);
+  Exponent<T> e;
+  for (size_t i = 0; i < VectorSize<T>(); ++i)
+    Set(e, i, std::ilogb(Get(x, i)));
+  return e;
 }
 
 template <typename T>
@@ -327,9 +356,9 @@ T Logb(const T &x)
 template <typename T>
 VECCORE_FORCE_INLINE
 VECCORE_ATT_HOST_DEVICE
-T Scalbn(const T &x, int n)
+T Scalbn(const T &x, const Exponent<T> &n)
 {
-  return std::scalbn(x, n);
+  return Ldexp(x, n);
 }
 
 template <typename T>
@@ -350,6 +379,17 @@ T Sqrt(const T &x)
   return std::sqrt(x);
 }
 
+// Reciprocal square root, backends may refine a hardware estimate instead of
+// dividing, in which case the result is accurate to a few ulps
+
+template <typename T>
+VECCORE_FORCE_INLINE
+VECCORE_ATT_HOST_DEVICE
+T RSqrt(const T &x)
+{
+  return T(Scalar<T>(1)) / Sqrt(x);
+}
+
 template <typename T>
 VECCORE_FORCE_INLINE
 VECCORE_ATT_HOST_DEVICE
@@ -398,20 +438,89 @@ T Floor(const T &x)
   return std::floor(x);
 }
 
+template <typename T>
+VECCORE_FORCE_INLINE
+VECCORE_ATT_HOST_DEVICE
+T Trunc(const T &x)
+{
+  return std::trunc(x);
+}
+
+// Steps of the remainder in Fmod(): the number of exponent bits reduced in
+// each step, and the bits of the high part of the split mantissa, such that
+// both parts times an integer below 2^(kBits + 2) are exact
+template <typename S>
+struct FmodParams {
+  static constexpr int kBits  = (std::numeric_limits<S>::digits - 4) / 2;
+  static constexpr int kHigh  = std::numeric_limits<S>::digits - kBits - 2;
+  static constexpr double kHi = double(1ull << kHigh);
+};
+
+// Exact remainder by long division in binary, several bits at a time. With
+// y = m 2^e and the remainder r scaled by 2^-e to be below 2^(kBits + 1) m,
+// the quotient q = trunc(r / m), rounded up so it is never one too small, is
+// an integer of at most kBits + 2 bits. With m split into a high and a low
+// part, r - q m = (r - q mh) - q ml is computed without rounding: both
+// products are exact, the first difference is exact since q mh is close to
+// r, and the result is exact since it is in (-m, m). This holds whether or
+// not the compiler contracts the products into fused multiply-adds. A
+// negative remainder is corrected by adding m. For arguments with very
+// different exponents, e starts kBits below the exponent of the remainder
+// and decreases by kBits in each step, so that there are at most about
+// 2100 / kBits steps for doubles and 280 / kBits for floats.
 template <typename T>
 VECCORE_FORCE_INLINE
 VECCORE_ATT_HOST_DEVICE
 T Fmod(const T &x, const T &y)
+{
+  using S = Scalar<T>;
+  using P = FmodParams<S>;
+
+  T r = Abs(x), a = Abs(y);
+
+  // fmod(x, 0), fmod(inf, y) and NaN arguments give NaN
+  Mask<T> invalid = !(a > T(0)) || !(r < NumericLimits<T>::Infinity());
+
+  Exponent<T> ea, er, e;
+  T m  = Frexp(a, &ea);
+  T mh = T(S(1 / P::kHi)) * Trunc(T(m * T(S(P::kHi))));
+  T ml = m - mh;
+
+  const T up(S(1) + 4 * std::numeric_limits<S>::epsilon());
+
+  Mask<T> active = !invalid && r >= a;
+  while (!MaskEmpty(active)) {
+    Frexp(r, &er);
+    e = er - Exponent<T>(P::kBits);
+    MaskedAssign(e, e < ea, ea);
+
+    T rm = Ldexp(r, Exponent<T>(Exponent<T>(0) - e));
+    T q  = Trunc(T(rm / m * up));
+    T d  = (rm - q * mh) - q * ml;
+    MaskedAssign(d, d < T(0), T(d + m));
+
+    MaskedAssign(r, active, Ldexp(d, e));
+    active = active && r >= a;
+  }
+
+  MaskedAssign(r, invalid, T(std::numeric_limits<Scalar<T>>::quiet_NaN()));
+  return CopySign(r, x);
+}
+
+template <>
+VECCORE_FORCE_INLINE
+VECCORE_ATT_HOST_DEVICE
+Float_s Fmod(const Float_s &x, const Float_s &y)
 {
   return std::fmod(x, y);
 }
 
-template <typename T>
+template <>
 VECCORE_FORCE_INLINE
 VECCORE_ATT_HOST_DEVICE
-T Trunc(const T &x)
+Double_s Fmod(const Double_s &x, const Double_s &y)
 {
-  return std::trunc(x);
+  return std::fmod(x, y);
 }
 
 template <typename T>
@@ -422,6 +531,511 @@ T Round(const T &x)
   return std::round(x);
 }
 
+template <typename T>
+VECCORE_FORCE_INLINE
+VECCORE_ATT_HOST_DEVICE
+T Modf(const T &x, T *intpart)
+{
+  *intpart = Trunc(x);
+  // the fractional part has the sign of x, and is zero for infinities
+  T f = Blend(Abs(x) == NumericLimits<T>::Infinity(), T(0), T(x - *intpart));
+  return CopySign(f, x);
+}
+
+template <>
+VECCORE_FORCE_INLINE
+VECCORE_ATT_HOST_DEVICE
+Float_s Modf(const Float_s &x, Float_s *intpart)
+{
+  return std::modf(x, intpart);
+}
+
+template <>
+VECCORE_FORCE_INLINE
+VECCORE_ATT_HOST_DEVICE
+Double_s Modf(const Double_s &x, Double_s *intpart)
+{
+  return std::modf(x, intpart);
+}
+
+// Polynomials
+
+// Evaluation of c[0] + c[1] x + ... + c[N-1] x^(N-1), with coefficients in
+// order of increasing degree, from an array, a list of arguments, or a class
+// with the number of coefficients and a constexpr function computing them,
+// which is then evaluated at compile time:
+//
+//   const double c[] = {1.0, 0.5, 0.25};
+//   T p = math::Horner(x, c);
+//   T q = math::Horner(x, 1.0, 0.5, 0.25);
+//
+//   struct C {
+//     static constexpr size_t kSize = 3;
+//     static constexpr double Coef(size_t i) { return 1.0 / (1 << i); }
+//   };
+//   T r = math::Horner<C>(x);
+//
+// Horner's scheme is a chain of N - 1 dependent multiply-adds. Estrin's scheme
+// splits it into independent halves combined with powers x^2, x^4, ..., which
+// shortens the chain to about 2 log2(N) operations at the cost of a few extra
+// multiplications. It pays off for degrees above 6 or so, unless several
+// polynomials are evaluated side by side. Both use FMA() throughout.
+
+namespace detail {
+
+// largest power of two smaller than n, for n >= 2
+constexpr size_t EstrinSplit(size_t n, size_t m = 1)
+{
+  return 2 * m < n ? EstrinSplit(n, 2 * m) : m;
+}
+
+constexpr size_t FloorLog2(size_t n)
+{
+  return n < 2 ? 0 : 1 + FloorLog2(n / 2);
+}
+
+// Sources of coefficients for the schemes below
+
+template <typename S>
+struct ArrayCoefficients {
+  const S *fC;
+
+  template <size_t I>
+  VECCORE_FORCE_INLINE
+  VECCORE_ATT_HOST_DEVICE
+  S Get() const
+  {
+    return fC[I];
+  }
+};
+
+template <class C, size_t I>
+struct ConstantCoefficient {
+  static constexpr double value = C::Coef(I);
+};
+
+template <class C>
+struct ClassCoefficients {
+  template <size_t I>
+  VECCORE_FORCE_INLINE
+  VECCORE_ATT_HOST_DEVICE
+  double Get() const
+  {
+    return ConstantCoefficient<C, I>::value;
+  }
+};
+
+// Horner's scheme for coefficients I, ..., I + N - 1
+template <size_t I, size_t N>
+struct HornerScheme {
+  template <typename T, class Source>
+  VECCORE_FORCE_INLINE
+  VECCORE_ATT_HOST_DEVICE
+  static T Eval(const T &x, const Source &c)
+  {
+    return FMA(HornerScheme<I + 1, N - 1>::Eval(x, c), x, T(Scalar<T>(c.template Get<I>())));
+  }
+};
+
+template <size_t I>
+struct HornerScheme<I, 1> {
+  template <typename T, class Source>
+  VECCORE_FORCE_INLINE
+  VECCORE_ATT_HOST_DEVICE
+  static T Eval(const T &, const Source &c)
+  {
+    return T(Scalar<T>(c.template Get<I>()));
+  }
+};
+
+// Estrin's scheme for coefficients I, ..., I + N - 1, where the lower part
+// has a power of two number of terms, and xp[k] = x^(2^k)
+template <size_t I, size_t N>
+struct EstrinScheme {
+  static constexpr size_t kLow = EstrinSplit(N);
+
+  template <typename T, class Source>
+  VECCORE_FORCE_INLINE
+  VECCORE_ATT_HOST_DEVICE
+  static T Eval(const T *xp, const Source &c)
+  {
+    return FMA(EstrinScheme<I + kLow, N - kLow>::Eval(xp, c), xp[FloorLog2(kLow)],
+               EstrinScheme<I, kLow>::Eval(xp, c));
+  }
+};
+
+template <size_t I>
+struct EstrinScheme<I, 1> {
+  template <typename T, class Source>
+  VECCORE_FORCE_INLINE
+  VECCORE_ATT_HOST_DEVICE
+  static T Eval(const T *, const Source &c)
+  {
+    return T(Scalar<T>(c.template Get<I>()));
+  }
+};
+
+template <size_t N, typename T, class Source>
+VECCORE_FORCE_INLINE
+VECCORE_ATT_HOST_DEVICE
+T EstrinEval(const T &x, const Source &c)
+{
+  T xp[FloorLog2(EstrinSplit(N)) + 1];
+  xp[0] = x;
+  for (size_t k = 1; k < sizeof(xp) / sizeof(T); ++k)
+    xp[k] = xp[k - 1] * xp[k - 1];
+  return EstrinScheme<0, N>::Eval(xp, c);
+}
+
+} // namespace detail
+
+template <typename T, typename S, size_t N>
+VECCORE_FORCE_INLINE
+VECCORE_ATT_HOST_DEVICE
+T Horner(const T &x, const S (&c)[N])
+{
+  return detail::HornerScheme<0, N>::Eval(x, detail::ArrayCoefficients<S>{c});
+}
+
+template <typename T, typename... S>
+VECCORE_FORCE_INLINE
+VECCORE_ATT_HOST_DEVICE
+T Horner(const T &x, S... c)
+{
+  const Scalar<T> coef[] = {Scalar<T>(c)...};
+  return Horner(x, coef);
+}
+
+template <class C, typename T>
+VECCORE_FORCE_INLINE
+VECCORE_ATT_HOST_DEVICE
+T Horner(const T &x)
+{
+  return detail::HornerScheme<0, C::kSize>::Eval(x, detail::ClassCoefficients<C>());
+}
+
+template <typename T, typename S, size_t N>
+VECCORE_FORCE_INLINE
+VECCORE_ATT_HOST_DEVICE
+T Estrin(const T &x, const S (&c)[N])
+{
+  return detail::EstrinEval<N>(x, detail::ArrayCoefficients<S>{c});
+}
+
+template <typename T, typename... S>
+VECCORE_FORCE_INLINE
+VECCORE_ATT_HOST_DEVICE
+T Estrin(const T &x, S... c)
+{
+  const Scalar<T> coef[] = {Scalar<T>(c)...};
+  return Estrin(x, coef);
+}
+
+template <class C, typename T>
+VECCORE_FORCE_INLINE
+VECCORE_ATT_HOST_DEVICE
+T Estrin(const T &x)
+{
+  return detail::EstrinEval<C::kSize>(x, detail::ClassCoefficients<C>());
+}
+
+// Rational function P(x) / Q(x), with both coefficient arrays in order of
+// increasing degree. The two Horner chains are independent, so they overlap.
+template <typename T, typename S, size_t N, size_t M>
+VECCORE_FORCE_INLINE
+VECCORE_ATT_HOST_DEVICE
+T Rational(const T &x, const S (&p)[N], const S (&q)[M])
+{
+  return Horner(x, p) / Horner(x, q);
+}
+
+// Special Functions
+
+namespace detail {
+
+// sin(pi * x), exact at integers and with full relative accuracy near them,
+// as the distance to the nearest integer n is computed without rounding error
+template <typename T>
+VECCORE_FORCE_INLINE
+VECCORE_ATT_HOST_DEVICE
+T SinPi(const T &x)
+{
+  T n = Floor(x + T(0.5));
+  T s = Sin(T(M_PI) * (x - n));
+  return Blend(n - T(2) * Floor(T(0.5) * n) != T(0), T(T(0) - s), s);
+}
+
+// exp(-x * x), with x * x split into an exact and a small part
+template <typename T>
+VECCORE_FORCE_INLINE
+VECCORE_ATT_HOST_DEVICE
+T ExpMinusSquare(const T &x)
+{
+  T h = Floor(T(64) * x + T(0.5)) * T(1.0 / 64);
+  T l = x - h;
+  return Exp(T(0) - h * h) * Exp(T(0) - FMA(T(2), h, l) * l);
+}
+
+// erfc(x) for x >= 1, rational approximations from Cephes
+template <typename T>
+VECCORE_FORCE_INLINE
+VECCORE_ATT_HOST_DEVICE
+T ErfcLarge(const T &x)
+{
+  using S = Scalar<T>;
+
+  const S P[] = {5.57535335369399327526E2, 1.02755188689515710272E3,  9.34528527171957607540E2,
+                 5.26445194995477358631E2, 1.96520832956077098242E2,  4.86371970985681366614E1,
+                 7.46321056442269912687E0, 5.64189564831068821977E-1, 2.46196981473530512524E-10};
+  const S Q[] = {5.57535340817727675546E2, 1.65666309194161350182E3, 2.24633760818710981792E3,
+                 1.82390916687909736289E3, 9.75708501743205489753E2, 3.54937778887819891062E2,
+                 8.67072140885989742329E1, 1.32281951154744992508E1, 1.0};
+  const S R[] = {2.97886665372100240670E0, 7.40974269950448939160E0, 6.16021097993053585195E0,
+                 5.01905042251180477414E0, 1.27536670759978104416E0, 5.64189583547755073984E-1};
+  const S U[] = {3.36907645100081516050E0, 9.60896809063285878198E0, 1.70814450747565897222E1,
+                 1.20489539808096656605E1, 9.39603524938001434673E0, 2.26052863220117276590E0, 1.0};
+
+  Mask<T> near = x < T(8);
+  T p;
+
+  if (MaskFull(near))
+    p = Rational(x, P, Q);
+  else if (MaskEmpty(near))
+    p = Rational(x, R, U);
+  else
+    p = Blend(near, Rational(x, P, Q), Rational(x, R, U));
+
+  // the rational approximation overflows long after exp(-x * x) underflows
+  T y = ExpMinusSquare(x) * p;
+  MaskedAssign(y, Mask<T>(x > T(30)), T(0));
+  return y;
+}
+
+// erf(x) for |x| < 1, rational approximation from Cephes
+template <typename T>
+VECCORE_FORCE_INLINE
+VECCORE_ATT_HOST_DEVICE
+T ErfSmall(const T &x)
+{
+  using S = Scalar<T>;
+
+  const S P[] = {5.55923013010394962768E4, 7.00332514112805075473E3, 2.23200534594684319226E3,
+                 9.00260197203842689217E1, 9.60497373987051638749E0};
+  const S Q[] = {4.92673942608635921086E4, 2.26290000613890934246E4, 4.59432382970980127987E3,
+                 5.21357949780152679795E2, 3.35617141647503099647E1, 1.0};
+
+  return x * Rational(T(x * x), P, Q);
+}
+
+// Lanczos approximation (g = 7, n = 9) of gamma(x + 1) / (sqrt(2 pi) t^(x + 1/2) e^-t),
+// where t = x + g + 1/2, good to about 15 significant digits for x >= -1/2
+template <typename T>
+VECCORE_FORCE_INLINE
+VECCORE_ATT_HOST_DEVICE
+T LanczosSum(const T &x)
+{
+  using S = Scalar<T>;
+
+  const S c[] = {676.5203681218851,   -1259.1392167224028,  771.32342877765313,
+                 -176.61502916214059, 12.507343278686905,   -0.13857109526572012,
+                 9.9843695780195716e-6, 1.5056327351493116e-7};
+
+  T sum(S(0.99999999999980993));
+  for (size_t k = 0; k < 8; ++k)
+    sum += T(c[k]) / (x + T(S(k + 1)));
+  return sum;
+}
+
+// log(gamma(x)) for x >= 1/2, where inf - inf at x = inf is replaced by inf
+template <typename T>
+VECCORE_FORCE_INLINE
+VECCORE_ATT_HOST_DEVICE
+T LGammaLanczos(const T &x)
+{
+  T xm = x - T(1);
+  T t  = xm + T(7.5);
+  T y  = T(0.91893853320467274178) + (xm + T(0.5)) * Log(t) - t + Log(LanczosSum(xm));
+  MaskedAssign(y, Mask<T>(x == NumericLimits<T>::Infinity()), NumericLimits<T>::Infinity());
+  return y;
+}
+
+// Argument above which gamma(x) overflows
+template <typename S>
+struct TGammaParams {
+  static constexpr double kOverflow = std::numeric_limits<S>::digits > 24 ? 171.7 : 35.1;
+};
+
+// gamma(x) for x >= 1/2, t^(x - 1/2) split in two halves to postpone overflow.
+// Beyond the overflow, where p * e^-t may be inf * 0, the result is inf.
+template <typename T>
+VECCORE_FORCE_INLINE
+VECCORE_ATT_HOST_DEVICE
+T TGammaLanczos(const T &x)
+{
+  T xm = x - T(1);
+  T t  = xm + T(7.5);
+  T p  = Pow(t, T(0.5) * (xm + T(0.5)));
+  T y  = T(2.50662827463100050242) * LanczosSum(xm) * (p * Exp(T(0) - t)) * p;
+  MaskedAssign(y, Mask<T>(x > T(TGammaParams<Scalar<T>>::kOverflow)), NumericLimits<T>::Infinity());
+  return y;
+}
+
+// Number of terms needed in the power series and asymptotic expansion of the
+// modified Bessel functions I0 and I1, and the argument above which to switch
+// from the former to the latter, for full single or double precision
+template <typename S>
+struct BesselIParams {
+  static constexpr bool kDouble   = std::numeric_limits<S>::digits > 24;
+  static constexpr size_t kSeries = kDouble ? 36 : 16;
+  static constexpr size_t kAsymp  = kDouble ? 28 : 12;
+  static constexpr double kSwitch = kDouble ? 20.0 : 9.0;
+};
+
+// Power series of I_nu(x) / (x/2)^nu = sum_k (x^2/4)^k / (k! (k + nu)!), for nu = 0, 1
+template <size_t nu, size_t N>
+struct BesselISeriesCoefficients {
+  static constexpr size_t kSize = N;
+
+  static constexpr double Coef(size_t k) { return k == 0 ? 1.0 : Coef(k - 1) / double(k * (k + nu)); }
+};
+
+template <typename T, size_t nu>
+VECCORE_FORCE_INLINE
+VECCORE_ATT_HOST_DEVICE
+T BesselISeries(const T &x)
+{
+  using C = BesselISeriesCoefficients<nu, BesselIParams<Scalar<T>>::kSeries + 1>;
+  return Estrin<C>(T(T(0.25) * x * x));
+}
+
+// Asymptotic expansion of I_nu(x) sqrt(2 pi x) e^-x, in powers of 1/(8x), for nu = 0, 1
+template <size_t nu, size_t N>
+struct BesselIAsympCoefficients {
+  static constexpr size_t kSize = N;
+
+  static constexpr double Coef(size_t k)
+  {
+    return k == 0 ? 1.0 : Coef(k - 1) * (double((2 * k - 1) * (2 * k - 1)) - double(4 * nu * nu)) / double(k);
+  }
+};
+
+template <typename T, size_t nu>
+VECCORE_FORCE_INLINE
+VECCORE_ATT_HOST_DEVICE
+T BesselIAsymp(const T &x)
+{
+  using C = BesselIAsympCoefficients<nu, BesselIParams<Scalar<T>>::kAsymp + 1>;
+  return Estrin<C>(T(T(0.125) / x));
+}
+
+// I_nu(|x|) for nu = 0, 1, the exponential is split to postpone overflow
+template <typename T, size_t nu>
+VECCORE_FORCE_INLINE
+VECCORE_ATT_HOST_DEVICE
+T BesselI(const T &x)
+{
+  using S = Scalar<T>;
+
+  T a = Abs(x);
+  Mask<T> small = a <= T(S(BesselIParams<S>::kSwitch));
+
+  T s(S(0)), l;
+  if (!MaskEmpty(small)) {
+    s = BesselISeries<T, nu>(a);
+    if (nu == 1) s *= T(0.5) * a;
+    if (MaskFull(small)) return s;
+  }
+
+  // sqrt(2 pi a) split to avoid overflow at the largest a, inf / inf at a = inf
+  T e = Exp(T(0.5) * a);
+  l   = e * (e * BesselIAsymp<T, nu>(a) / (T(2.50662827463100050242) * Sqrt(a)));
+  MaskedAssign(l, Mask<T>(a == NumericLimits<T>::Infinity()), NumericLimits<T>::Infinity());
+
+  return MaskEmpty(small) ? l : Blend(small, s, l);
+}
+
+} // namespace detail
+
+template <typename T>
+VECCORE_FORCE_INLINE
+VECCORE_ATT_HOST_DEVICE
+T Erf(const T &x)
+{
+  T a = Abs(x);
+  Mask<T> small = a < T(1);
+
+  if (MaskFull(small)) return detail::ErfSmall(x);
+
+  T y = CopySign(T(1) - detail::ErfcLarge(a), x);
+
+  return MaskEmpty(small) ? y : Blend(small, detail::ErfSmall(x), y);
+}
+
+template <typename T>
+VECCORE_FORCE_INLINE
+VECCORE_ATT_HOST_DEVICE
+T Erfc(const T &x)
+{
+  T a = Abs(x);
+  Mask<T> small = a < T(1);
+
+  if (MaskFull(small)) return T(1) - detail::ErfSmall(x);
+
+  T y = detail::ErfcLarge(a);
+  MaskedAssign(y, Mask<T>(x < T(0)), T(2) - y);
+
+  return MaskEmpty(small) ? y : Blend(small, T(T(1) - detail::ErfSmall(x)), y);
+}
+
+template <typename T>
+VECCORE_FORCE_INLINE
+VECCORE_ATT_HOST_DEVICE
+T LGamma(const T &x)
+{
+  Mask<T> reflect = x < T(0.5);
+
+  if (MaskEmpty(reflect)) return detail::LGammaLanczos(x);
+
+  // lgamma(x) = log(pi / |sin(pi x)|) - lgamma(1 - x), and lgamma(-inf) = inf
+  T y = detail::LGammaLanczos(Blend(reflect, T(T(1) - x), x));
+  y   = Blend(reflect, T(Log(T(M_PI) / Abs(detail::SinPi(x))) - y), y);
+  MaskedAssign(y, Mask<T>(x == -NumericLimits<T>::Infinity()), NumericLimits<T>::Infinity());
+  return y;
+}
+
+template <typename T>
+VECCORE_FORCE_INLINE
+VECCORE_ATT_HOST_DEVICE
+T TGamma(const T &x)
+{
+  Mask<T> reflect = x < T(0.5);
+
+  if (MaskEmpty(reflect)) return detail::TGammaLanczos(x);
+
+  // gamma(x) = pi / (sin(pi x) gamma(1 - x)), undefined at negative integers
+  T y = detail::TGammaLanczos(Blend(reflect, T(T(1) - x), x));
+  T s = detail::SinPi(x);
+  MaskedAssign(y, reflect, T(T(M_PI) / (s * y)));
+  MaskedAssign(y, Mask<T>(x < T(0) && s == T(0)), T(std::numeric_limits<Scalar<T>>::quiet_NaN()));
+  return y;
+}
+
+template <typename T>
+VECCORE_FORCE_INLINE
+VECCORE_ATT_HOST_DEVICE
+T BesselI0(const T &x)
+{
+  return detail::BesselI<T, 0>(x);
+}
+
+template <typename T>
+VECCORE_FORCE_INLINE
+VECCORE_ATT_HOST_DEVICE
+T BesselI1(const T &x)
+{
+  return CopySign(detail::BesselI<T, 1>(x), x);
+}
+
 // Miscellaneous Utilities
 
 template <typename T>
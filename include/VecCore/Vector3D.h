@@ -0,0 +1,255 @@
+#ifndef VECCORE_VECTOR3D_H
+#define VECCORE_VECTOR3D_H
+
+#include "Backend/Interface.h"
+#include "Backend/Implementation.h"
+#include "VecMath.h"
+
+namespace vecCore {
+
+// Three dimensional vectors with components held in separate backend vectors
+// (SoA layout), such that each lane of Vector3D<T> is an independent vector.
+//
+// Like Complex<T>, Vector3D<T> is a backend type: its scalar type is
+// Vector3D<Scalar<T>>, i.e. the vector in a single lane, and it shares the
+// mask and index types of T. Get(), Set(), Load(), Store(), Gather() and
+// Scatter() therefore move whole vectors from and to arrays of scalar
+// vectors (AoS layout), and MaskedAssign() and Blend() take a Mask<T>. With a
+// scalar T, Vector3D<T> is its own scalar type, so the same code compiles for
+// a single vector.
+
+template <typename T>
+class Vector3D {
+public:
+  using Scalar_t = Scalar<T>;
+
+  VECCORE_FORCE_INLINE
+  VECCORE_ATT_HOST_DEVICE
+  Vector3D() : fX(Scalar_t(0)), fY(Scalar_t(0)), fZ(Scalar_t(0)) {}
+
+  VECCORE_FORCE_INLINE
+  VECCORE_ATT_HOST_DEVICE
+  Vector3D(const T &x, const T &y, const T &z) : fX(x), fY(y), fZ(z) {}
+
+  VECCORE_FORCE_INLINE
+  VECCORE_ATT_HOST_DEVICE
+  T &X() { return fX; }
+
+  VECCORE_FORCE_INLINE
+  VECCORE_ATT_HOST_DEVICE
+  T const &X() const { return fX; }
+
+  VECCORE_FORCE_INLINE
+  VECCORE_ATT_HOST_DEVICE
+  T &Y() { return fY; }
+
+  VECCORE_FORCE_INLINE
+  VECCORE_ATT_HOST_DEVICE
+  T const &Y() const { return fY; }
+
+  VECCORE_FORCE_INLINE
+  VECCORE_ATT_HOST_DEVICE
+  T &Z() { return fZ; }
+
+  VECCORE_FORCE_INLINE
+  VECCORE_ATT_HOST_DEVICE
+  T const &Z() const { return fZ; }
+
+  VECCORE_FORCE_INLINE
+  VECCORE_ATT_HOST_DEVICE
+  T &operator[](int i) { return i == 0 ? fX : (i == 1 ? fY : fZ); }
+
+  VECCORE_FORCE_INLINE
+  VECCORE_ATT_HOST_DEVICE
+  T const &operator[](int i) const { return i == 0 ? fX : (i == 1 ? fY : fZ); }
+
+  // Squared length
+  VECCORE_FORCE_INLINE
+  VECCORE_ATT_HOST_DEVICE
+  T Mag2() const { return math::FMA(fX, fX, math::FMA(fY, fY, T(fZ * fZ))); }
+
+  VECCORE_FORCE_INLINE
+  VECCORE_ATT_HOST_DEVICE
+  T Mag() const { return math::Sqrt(Mag2()); }
+
+  // Unit vector in the same direction, undefined for null vectors
+  VECCORE_FORCE_INLINE
+  VECCORE_ATT_HOST_DEVICE
+  Vector3D Unit() const { return *this * math::RSqrt(Mag2()); }
+
+  VECCORE_FORCE_INLINE
+  VECCORE_ATT_HOST_DEVICE
+  void Normalize() { *this *= math::RSqrt(Mag2()); }
+
+  VECCORE_FORCE_INLINE
+  VECCORE_ATT_HOST_DEVICE
+  Vector3D operator-() const { return Vector3D(-fX, -fY, -fZ); }
+
+  VECCORE_FORCE_INLINE
+  VECCORE_ATT_HOST_DEVICE
+  Vector3D &operator+=(const Vector3D &v)
+  {
+    fX += v.fX;
+    fY += v.fY;
+    fZ += v.fZ;
+    return *this;
+  }
+
+  VECCORE_FORCE_INLINE
+  VECCORE_ATT_HOST_DEVICE
+  Vector3D &operator-=(const Vector3D &v)
+  {
+    fX -= v.fX;
+    fY -= v.fY;
+    fZ -= v.fZ;
+    return *this;
+  }
+
+  VECCORE_FORCE_INLINE
+  VECCORE_ATT_HOST_DEVICE
+  Vector3D &operator*=(const T &a)
+  {
+    fX *= a;
+    fY *= a;
+    fZ *= a;
+    return *this;
+  }
+
+  VECCORE_FORCE_INLINE
+  VECCORE_ATT_HOST_DEVICE
+  Vector3D &operator/=(const T &a)
+  {
+    return *this *= T(Scalar_t(1)) / a;
+  }
+
+private:
+  T fX;
+  T fY;
+  T fZ;
+};
+
+template <typename T>
+struct TypeTraits<Vector3D<T>> {
+  using ScalarType = Vector3D<Scalar<T>>;
+  using MaskType   = Mask<T>;
+  using IndexType  = Index<T>;
+};
+
+template <typename T>
+struct IndexingImplementation<Vector3D<T>> {
+  VECCORE_FORCE_INLINE
+  VECCORE_ATT_HOST_DEVICE
+  static Vector3D<Scalar<T>> Get(const Vector3D<T> &v, size_t i)
+  {
+    return Vector3D<Scalar<T>>(vecCore::Get(v.X(), i), vecCore::Get(v.Y(), i), vecCore::Get(v.Z(), i));
+  }
+
+  VECCORE_FORCE_INLINE
+  VECCORE_ATT_HOST_DEVICE
+  static void Set(Vector3D<T> &v, size_t i, Vector3D<Scalar<T>> const val)
+  {
+    vecCore::Set(v.X(), i, val.X());
+    vecCore::Set(v.Y(), i, val.Y());
+    vecCore::Set(v.Z(), i, val.Z());
+  }
+};
+
+template <typename T>
+struct MaskingImplementation<Vector3D<T>> {
+  VECCORE_FORCE_INLINE
+  VECCORE_ATT_HOST_DEVICE
+  static void Assign(Vector3D<T> &dst, Mask<T> const &mask, Vector3D<T> const &src)
+  {
+    vecCore::MaskedAssign(dst.X(), mask, src.X());
+    vecCore::MaskedAssign(dst.Y(), mask, src.Y());
+    vecCore::MaskedAssign(dst.Z(), mask, src.Z());
+  }
+
+  VECCORE_FORCE_INLINE
+  VECCORE_ATT_HOST_DEVICE
+  static void Blend(Vector3D<T> &dst, Mask<T> const &mask, Vector3D<T> const &src1, Vector3D<T> const &src2)
+  {
+    dst = Vector3D<T>(vecCore::Blend(mask, src1.X(), src2.X()), vecCore::Blend(mask, src1.Y(), src2.Y()),
+                      vecCore::Blend(mask, src1.Z(), src2.Z()));
+  }
+};
+
+template <typename T>
+VECCORE_FORCE_INLINE
+VECCORE_ATT_HOST_DEVICE
+Vector3D<T> operator+(Vector3D<T> u, const Vector3D<T> &v)
+{
+  return u += v;
+}
+
+template <typename T>
+VECCORE_FORCE_INLINE
+VECCORE_ATT_HOST_DEVICE
+Vector3D<T> operator-(Vector3D<T> u, const Vector3D<T> &v)
+{
+  return u -= v;
+}
+
+template <typename T>
+VECCORE_FORCE_INLINE
+VECCORE_ATT_HOST_DEVICE
+Vector3D<T> operator*(Vector3D<T> v, const T &a)
+{
+  return v *= a;
+}
+
+template <typename T>
+VECCORE_FORCE_INLINE
+VECCORE_ATT_HOST_DEVICE
+Vector3D<T> operator*(const T &a, Vector3D<T> v)
+{
+  return v *= a;
+}
+
+template <typename T>
+VECCORE_FORCE_INLINE
+VECCORE_ATT_HOST_DEVICE
+Vector3D<T> operator/(Vector3D<T> v, const T &a)
+{
+  return v /= a;
+}
+
+template <typename T>
+VECCORE_FORCE_INLINE
+VECCORE_ATT_HOST_DEVICE
+Mask<T> operator==(const Vector3D<T> &u, const Vector3D<T> &v)
+{
+  return u.X() == v.X() && u.Y() == v.Y() && u.Z() == v.Z();
+}
+
+template <typename T>
+VECCORE_FORCE_INLINE
+VECCORE_ATT_HOST_DEVICE
+Mask<T> operator!=(const Vector3D<T> &u, const Vector3D<T> &v)
+{
+  return u.X() != v.X() || u.Y() != v.Y() || u.Z() != v.Z();
+}
+
+namespace math {
+
+template <typename T>
+VECCORE_FORCE_INLINE
+VECCORE_ATT_HOST_DEVICE
+T Dot(const Vector3D<T> &u, const Vector3D<T> &v)
+{
+  return FMA(u.X(), v.X(), FMA(u.Y(), v.Y(), T(u.Z() * v.Z())));
+}
+
+template <typename T>
+VECCORE_FORCE_INLINE
+VECCORE_ATT_HOST_DEVICE
+Vector3D<T> Cross(const Vector3D<T> &u, const Vector3D<T> &v)
+{
+  return Vector3D<T>(FMA(u.Y(), v.Z(), T(-u.Z() * v.Y())), FMA(u.Z(), v.X(), T(-u.X() * v.Z())),
+                     FMA(u.X(), v.Y(), T(-u.Y() * v.X())));
+}
+
+} // namespace math
+} // namespace vecCore
+
+#endif
@@ -3,7 +3,9 @@
 #include <VecCore/VecCore>
 
 #include <array>
+#include <cstring>
 #include <memory>
+#include <thread>
 #include <vector>
 
 using namespace testing;
@@ -99,6 +101,26 @@ TYPED_TEST_P(AlignmentTest, StdArray)
   EXPECT_TRUE(is_aligned(std::addressof(v), VECCORE_SIMD_ALIGN));
 }
 
+TYPED_TEST_P(AlignmentTest, AlignedAllocator)
+{
+  using Vector_t = typename TestFixture::Vector_t;
+
+  for (size_t n = 1; n <= 16; ++n) {
+    std::vector<Vector_t, vecCore::AlignedAllocator<Vector_t>> v(n);
+    EXPECT_TRUE(is_aligned(v.data(), VECCORE_SIMD_ALIGN));
+  }
+}
+
+TYPED_TEST_P(AlignmentTest, ArenaAllocator)
+{
+  using Vector_t = typename TestFixture::Vector_t;
+
+  for (size_t n = 1; n <= 16; ++n) {
+    std::vector<Vector_t, vecCore::ArenaAllocator<Vector_t>> v(n);
+    EXPECT_TRUE(is_aligned(v.data(), VECCORE_SIMD_ALIGN));
+  }
+}
+
 #if 0
 TYPED_TEST_P(AlignmentTest, StdVector)
 {
@@ -120,7 +142,7 @@ TYPED_TEST_P(AlignmentTest, Collection)
 
 REGISTER_TYPED_TEST_CASE_P(AlignmentTest, Stack, Heap, StdArray, StdVector, Collection);
 #endif
-REGISTER_TYPED_TEST_CASE_P(AlignmentTest, Stack, Heap, StdArray);
+REGISTER_TYPED_TEST_CASE_P(AlignmentTest, Stack, Heap, StdArray, AlignedAllocator, ArenaAllocator);
 
 #define TEST_BACKEND_P(name, types, x) \
   INSTANTIATE_TYPED_TEST_CASE_P(name, AlignmentTest, types<vecCore::backend::x>)
@@ -148,6 +170,70 @@ TEST_BACKEND_P(AgnerAVX, AgnerAVXTypes, AgnerAVX);
 TEST_BACKEND_P(AgnerAVX512, AgnerAVX512Types, AgnerAVX512);
 #endif
 
+TEST(Arena, Reuse)
+{
+  Arena &arena = Arena::Instance();
+
+  // released blocks are handed out again by the same thread
+  for (size_t size = 1; size <= 4 * Arena::kMaxBlock; size *= 3) {
+    void *p = arena.Allocate(size);
+    EXPECT_TRUE(is_aligned(p, VECCORE_SIMD_ALIGN));
+    memset(p, 0xff, size);
+    arena.Deallocate(p, size);
+
+    void *q = arena.Allocate(size);
+    if (size <= Arena::kMaxBlock) {
+      EXPECT_EQ(p, q);
+    }
+    arena.Deallocate(q, size);
+  }
+
+  const size_t reserved = arena.GetReserved();
+  for (size_t i = 0; i < 1000; ++i)
+    arena.Deallocate(arena.Allocate(1024), 1024);
+  EXPECT_EQ(reserved, arena.GetReserved());
+}
+
+TEST(Arena, Threads)
+{
+  Arena &arena = Arena::Instance();
+  arena.SetHugePages(true);
+
+  // blocks allocated by one thread are released by another
+  constexpr size_t kThreads = 4, kBlocks = 2000;
+  std::vector<std::vector<unsigned char *>> blocks(kThreads, std::vector<unsigned char *>(kBlocks));
+
+  auto size = [](size_t t, size_t i) { return 1 + (t * 7919 + i * 104729) % 5000; };
+
+  std::vector<std::thread> threads;
+  for (size_t t = 0; t < kThreads; ++t) {
+    threads.emplace_back([&, t]() {
+      for (size_t i = 0; i < kBlocks; ++i) {
+        blocks[t][i] = static_cast<unsigned char *>(arena.Allocate(size(t, i)));
+        memset(blocks[t][i], int(t + 1), size(t, i));
+      }
+    });
+  }
+  for (auto &thread : threads)
+    thread.join();
+  threads.clear();
+
+  for (size_t t = 0; t < kThreads; ++t) {
+    threads.emplace_back([&, t]() {
+      const size_t u = (t + 1) % kThreads;
+      for (size_t i = 0; i < kBlocks; ++i) {
+        for (size_t k = 0; k < size(u, i); ++k)
+          EXPECT_EQ(blocks[u][i][k], u + 1);
+        arena.Deallocate(blocks[u][i], size(u, i));
+      }
+    });
+  }
+  for (auto &thread : threads)
+    thread.join();
+
+  arena.SetHugePages(false);
+}
+
 int main(int argc, char *argv[])
 {
   ::testing::InitGoogleTest(&argc, argv);
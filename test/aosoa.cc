@@ -0,0 +1,268 @@
+#include <VecCore/VecCore>
+
+#include <gtest/gtest.h>
+
+using namespace testing;
+
+#if defined(GTEST_HAS_TYPED_TEST) && defined(GTEST_HAS_TYPED_TEST_P)
+
+template <class Backend>
+using FloatTypes = Types<typename Backend::Float_v, typename Backend::Double_v>;
+
+///////////////////////////////////////////////////////////////////////////////
+
+template <class T>
+class VectorTypeTest : public Test {
+public:
+  using Scalar_t = typename vecCore::ScalarType<T>::Type;
+  using Vector_t = T;
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+template <class T>
+class AoSoATest : public VectorTypeTest<T> {
+public:
+  using Scalar_t = typename VectorTypeTest<T>::Scalar_t;
+  using AoSoA_t  = vecCore::AoSoA<T, T, T>;
+
+  // sizes with every possible number of elements in the last block
+  static size_t MaxSize() { return 3 * vecCore::VectorSize<T>() + 1; }
+
+  static void Fill(AoSoA_t &a)
+  {
+    for (size_t i = 0; i < a.Size(); ++i) {
+      a[i].template Set<0>(Scalar_t(i));
+      a[i].template Set<1>(Scalar_t(2 * i));
+      a[i].template Set<2>(Scalar_t(-1));
+    }
+  }
+};
+
+TYPED_TEST_CASE_P(AoSoATest);
+
+TYPED_TEST_P(AoSoATest, Layout)
+{
+  using AoSoA_t = typename TestFixture::AoSoA_t;
+
+  constexpr size_t kVS = vecCore::VectorSize<TypeParam>();
+
+  EXPECT_EQ(AoSoA_t::BlockSize(), kVS);
+  EXPECT_EQ(AoSoA_t::template GetNvectors<2>(), 1u);
+  EXPECT_EQ(sizeof(typename AoSoA_t::Block_t), 3 * sizeof(TypeParam));
+
+  for (size_t n = 0; n <= TestFixture::MaxSize(); ++n) {
+    AoSoA_t a(n);
+    EXPECT_EQ(a.Size(), n);
+    EXPECT_EQ(a.GetNblocks(), (n + kVS - 1) / kVS);
+    EXPECT_EQ(size_t(a.end() - a.begin()), a.GetNblocks());
+
+    size_t count = 0;
+    for (size_t b = 0; b < a.GetNblocks(); ++b) {
+      EXPECT_EQ((uintptr_t)&a.template Field<0>(b) % alignof(TypeParam), 0u);
+      EXPECT_EQ((uintptr_t)&a.template Field<2>(b) % alignof(TypeParam), 0u);
+      count += a.GetBlockCount(b);
+    }
+    EXPECT_EQ(count, n);
+  }
+}
+
+TYPED_TEST_P(AoSoATest, Access)
+{
+  using Scalar_t = typename TestFixture::Scalar_t;
+  using AoSoA_t  = typename TestFixture::AoSoA_t;
+
+  constexpr size_t kVS = vecCore::VectorSize<TypeParam>();
+
+  for (size_t n = 0; n <= TestFixture::MaxSize(); ++n) {
+    AoSoA_t a(n);
+    TestFixture::Fill(a);
+
+    // elements are lanes of the field vectors, padding lanes are zero
+    for (size_t b = 0; b < a.GetNblocks(); ++b) {
+      for (size_t k = 0; k < kVS; ++k) {
+        size_t i = b * kVS + k;
+        bool valid = i < n;
+        EXPECT_EQ(vecCore::Get(a.template Field<0>(b), k), valid ? Scalar_t(i) : Scalar_t(0));
+        EXPECT_EQ(vecCore::Get(a.template Field<1>(b), k), valid ? Scalar_t(2 * i) : Scalar_t(0));
+        EXPECT_EQ(vecCore::Get(a.GetBlock(b).template Field<2>(), k), valid ? Scalar_t(-1) : Scalar_t(0));
+      }
+    }
+
+    const AoSoA_t &c = a;
+    size_t i = 0;
+    c.ForEach([&](const typename AoSoA_t::template Element<const AoSoA_t> &e) {
+      EXPECT_EQ(e.template Get<0>(), Scalar_t(i));
+      EXPECT_EQ(e.template Get<1>(), Scalar_t(2 * i));
+      ++i;
+    });
+    EXPECT_EQ(i, n);
+  }
+}
+
+TYPED_TEST_P(AoSoATest, Kernel)
+{
+  using Scalar_t = typename TestFixture::Scalar_t;
+  using AoSoA_t  = typename TestFixture::AoSoA_t;
+
+  for (size_t n = 0; n <= TestFixture::MaxSize(); ++n) {
+    AoSoA_t a(n);
+    TestFixture::Fill(a);
+
+    size_t count = 0;
+    a.ForEachBlock([&](typename AoSoA_t::Block_t &block, size_t k) {
+      block.template Field<2>() = block.template Field<0>() * block.template Field<1>() + Scalar_t(1);
+      count += k;
+    });
+    EXPECT_EQ(count, n);
+
+    for (auto &block : a)
+      block.template Field<0>() += block.template Field<2>();
+
+    for (size_t i = 0; i < n; ++i) {
+      EXPECT_EQ(a[i].template Get<2>(), Scalar_t(2 * i * i + 1));
+      EXPECT_EQ(a[i].template Get<0>(), Scalar_t(2 * i * i + i + 1));
+    }
+  }
+}
+
+TYPED_TEST_P(AoSoATest, Resize)
+{
+  using Scalar_t = typename TestFixture::Scalar_t;
+  using AoSoA_t  = typename TestFixture::AoSoA_t;
+
+  const size_t n = TestFixture::MaxSize();
+
+  AoSoA_t a(n);
+  TestFixture::Fill(a);
+
+  // shrinking and growing again keeps the first elements and clears the others
+  a.Resize(n / 2);
+  a.Resize(n);
+
+  for (size_t i = 0; i < n; ++i) {
+    EXPECT_EQ(a[i].template Get<0>(), i < n / 2 ? Scalar_t(i) : Scalar_t(0));
+    EXPECT_EQ(a[i].template Get<2>(), i < n / 2 ? Scalar_t(-1) : Scalar_t(0));
+  }
+
+  a.Clear();
+  EXPECT_EQ(a.Size(), 0u);
+  EXPECT_EQ(a.GetNblocks(), 0u);
+}
+
+REGISTER_TYPED_TEST_CASE_P(AoSoATest, Layout, Access, Kernel, Resize);
+
+#define TEST_BACKEND_P(name, x) INSTANTIATE_TYPED_TEST_CASE_P(name, AoSoATest, FloatTypes<vecCore::backend::x>);
+
+#define TEST_BACKEND(x) TEST_BACKEND_P(x, x)
+
+///////////////////////////////////////////////////////////////////////////////
+
+TEST_BACKEND(Scalar);
+TEST_BACKEND(ScalarWrapper);
+
+#ifdef VECCORE_ENABLE_VC
+TEST_BACKEND(VcScalar);
+TEST_BACKEND(VcVector);
+TEST_BACKEND_P(VcSimdArray, VcSimdArray<16>);
+#endif
+
+#ifdef VECCORE_ENABLE_UMESIMD
+TEST_BACKEND(UMESimd);
+TEST_BACKEND_P(UMESimdArray, UMESimdArray<16>);
+#endif
+
+#ifdef VECCORE_ENABLE_AGNER
+TEST_BACKEND(AgnerAVX);
+TEST_BACKEND(AgnerAVX512);
+#endif
+
+#else // if !GTEST_HAS_TYPED_TEST
+TEST(DummyTest, TypedTestsAreNotSupportedOnThisPlatform)
+{
+}
+#endif
+
+///////////////////////////////////////////////////////////////////////////////
+
+// Fields of different widths, with several vectors of the narrower fields per
+// block, e.g. Vec8f and two Vec4d with AVX
+template <class Backend>
+void TestMixedWidths()
+{
+  using Float_v  = typename Backend::Float_v;
+  using Double_v = typename Backend::Double_v;
+  using AoSoA_t  = vecCore::AoSoA<Double_v, Float_v>;
+
+  constexpr size_t kVF = vecCore::VectorSize<Float_v>(), kVD = vecCore::VectorSize<Double_v>();
+  constexpr size_t kBS = kVF > kVD ? kVF : kVD;
+
+  EXPECT_EQ(AoSoA_t::BlockSize(), kBS);
+  EXPECT_EQ(AoSoA_t::template GetNvectors<0>(), kBS / kVD);
+  EXPECT_EQ(AoSoA_t::template GetNvectors<1>(), kBS / kVF);
+  // at most the padding needed to align the next block
+  EXPECT_GE(sizeof(typename AoSoA_t::Block_t), kBS * (sizeof(double) + sizeof(float)));
+  EXPECT_LT(sizeof(typename AoSoA_t::Block_t), kBS * (sizeof(double) + sizeof(float)) + alignof(Double_v));
+
+  const size_t n = 3 * kBS + 1;
+  AoSoA_t a(n);
+  for (size_t i = 0; i < n; ++i) {
+    a[i].template Set<0>(double(i));
+    a[i].template Set<1>(float(2 * i));
+  }
+
+  for (size_t b = 0; b < a.GetNblocks(); ++b) {
+    for (size_t j = 0; j < AoSoA_t::template GetNvectors<0>(); ++j) {
+      EXPECT_EQ((uintptr_t)&a.template Field<0>(b, j) % alignof(Double_v), 0u);
+      for (size_t k = 0; k < kVD; ++k) {
+        size_t i = b * kBS + j * kVD + k;
+        EXPECT_EQ(vecCore::Get(a.template Field<0>(b, j), k), i < n ? double(i) : 0.0);
+      }
+    }
+    for (size_t j = 0; j < AoSoA_t::template GetNvectors<1>(); ++j) {
+      EXPECT_EQ((uintptr_t)&a.template Field<1>(b, j) % alignof(Float_v), 0u);
+      for (size_t k = 0; k < kVF; ++k) {
+        size_t i = b * kBS + j * kVF + k;
+        EXPECT_EQ(vecCore::Get(a.template Field<1>(b, j), k), i < n ? float(2 * i) : 0.0f);
+      }
+    }
+  }
+
+  for (auto &block : a) {
+    for (size_t j = 0; j < AoSoA_t::template GetNvectors<0>(); ++j)
+      block.template Field<0>(j) += Double_v(1.0);
+    for (size_t j = 0; j < AoSoA_t::template GetNvectors<1>(); ++j)
+      block.template Field<1>(j) *= Float_v(0.5f);
+  }
+
+  for (size_t i = 0; i < n; ++i) {
+    EXPECT_EQ(a[i].template Get<0>(), double(i + 1));
+    EXPECT_EQ(a[i].template Get<1>(), float(i));
+  }
+}
+
+TEST(AoSoA, MixedWidths)
+{
+  TestMixedWidths<vecCore::backend::Scalar>();
+  TestMixedWidths<vecCore::backend::ScalarWrapper>();
+
+#ifdef VECCORE_ENABLE_VC
+  TestMixedWidths<vecCore::backend::VcVector>();
+  TestMixedWidths<vecCore::backend::VcSimdArray<16>>();
+#endif
+
+#ifdef VECCORE_ENABLE_UMESIMD
+  TestMixedWidths<vecCore::backend::UMESimd>();
+#endif
+
+#ifdef VECCORE_ENABLE_AGNER
+  TestMixedWidths<vecCore::backend::AgnerAVX>();
+  TestMixedWidths<vecCore::backend::AgnerAVX512>();
+#endif
+}
+
+int main(int argc, char *argv[])
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
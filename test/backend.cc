@@ -340,6 +340,42 @@ TYPED_TEST_P(VectorInterfaceTest, StoreToPtr)
     EXPECT_EQ(input[i], output[i]);
 }
 
+TYPED_TEST_P(VectorInterfaceTest, AlignedLoadStore)
+{
+  using Vector_t = typename TestFixture::Vector_t;
+  using Scalar_t = typename TestFixture::Scalar_t;
+
+  constexpr size_t kVS = vecCore::VectorSize<Vector_t>();
+  constexpr size_t N   = 2 * kVS;
+
+  alignas(64) Scalar_t input[N];
+  alignas(64) Scalar_t aligned[N];
+  alignas(64) Scalar_t streamed[N];
+
+  for (size_t i = 0; i < N; ++i) {
+    input[i]    = Scalar_t(3 * i + 1);
+    aligned[i]  = 0;
+    streamed[i] = 0;
+  }
+
+  vecCore::Prefetch(&input[0]);
+  vecCore::Prefetch<vecCore::PrefetchHint::NTA>(&input[kVS]);
+  vecCore::Prefetch<vecCore::PrefetchHint::Write>(&streamed[0]);
+
+  for (size_t i = 0; i < N; i += kVS) {
+    Vector_t x(Scalar_t(0));
+    vecCore::LoadAligned(x, &input[i]);
+    vecCore::StoreAligned(x, &aligned[i]);
+    vecCore::StoreStreaming(x, &streamed[i]);
+  }
+  vecCore::StoreFence();
+
+  for (size_t i = 0; i < N; ++i) {
+    EXPECT_EQ(input[i], aligned[i]);
+    EXPECT_EQ(input[i], streamed[i]);
+  }
+}
+
 TYPED_TEST_P(VectorInterfaceTest, StoreMaskToPtr)
 {
   using Vector_t = typename TestFixture::Vector_t;
@@ -483,6 +519,91 @@ TYPED_TEST_P(VectorInterfaceTest, ReduceMinMax)
   EXPECT_EQ(Scalar_t(vecCore::VectorSize<Vector_t>()), vecCore::ReduceMax(v));
 }
 
+TYPED_TEST_P(VectorInterfaceTest, ReduceAddN)
+{
+  using Scalar_t = typename TestFixture::Scalar_t;
+  using Vector_t = typename TestFixture::Vector_t;
+
+  constexpr size_t kVS = vecCore::VectorSize<Vector_t>();
+  constexpr size_t kHalf = kVS > 1 ? kVS / 2 : 1;
+
+  // lane j of v[i] is i + j % 4, small enough for every scalar type
+  Vector_t v[kVS];
+  for (size_t i = 0; i < kVS; ++i) {
+    v[i] = Vector_t(Scalar_t(0));
+    for (size_t j = 0; j < kVS; ++j)
+      vecCore::Set(v[i], j, Scalar_t(i + j % 4));
+  }
+
+  Scalar_t offset(0);
+  for (size_t j = 0; j < kVS; ++j)
+    offset += Scalar_t(j % 4);
+
+  Vector_t sums = vecCore::ReduceAddN(v);
+  for (size_t i = 0; i < kVS; ++i)
+    EXPECT_EQ(vecCore::Get(sums, i), Scalar_t(kVS * i + offset));
+
+  Vector_t half[kHalf];
+  for (size_t i = 0; i < kHalf; ++i)
+    half[i] = v[i];
+
+  Vector_t partial = vecCore::ReduceAddN(half);
+  for (size_t i = 0; i < kVS; ++i)
+    EXPECT_EQ(vecCore::Get(partial, i), i < kHalf ? Scalar_t(kVS * i + offset) : Scalar_t(0));
+}
+
+TYPED_TEST_P(VectorInterfaceTest, ReduceMinMaxIndex)
+{
+  using Scalar_t = typename TestFixture::Scalar_t;
+  using Vector_t = typename TestFixture::Vector_t;
+
+  constexpr size_t kVS = vecCore::VectorSize<Vector_t>();
+
+  // every position of the extreme values, with a tie in a later lane
+  for (size_t k = 0; k < kVS; ++k) {
+    Vector_t v(Scalar_t(0));
+
+    for (size_t i = 0; i < kVS; ++i)
+      vecCore::Set(v, i, Scalar_t(i % 3 + 2));
+
+    vecCore::Set(v, k, Scalar_t(1));
+    vecCore::Set(v, kVS - 1 - k, Scalar_t(9));
+    if (k + 1 < kVS && k != kVS - 2 - k) vecCore::Set(v, kVS - 1, Scalar_t(1));
+
+    EXPECT_EQ(k, vecCore::ReduceMinIndex(v));
+    EXPECT_EQ(kVS - 1 - k, vecCore::ReduceMaxIndex(v));
+  }
+}
+
+TYPED_TEST_P(VectorInterfaceTest, MinMaxIndex)
+{
+  using Scalar_t = typename TestFixture::Scalar_t;
+  using Vector_t = typename TestFixture::Vector_t;
+  using Index_t  = vecCore::Index<Vector_t>;
+  using SIndex_t = vecCore::Scalar<Index_t>;
+
+  constexpr size_t kVS = vecCore::VectorSize<Vector_t>();
+
+  Vector_t a(Scalar_t(0)), b(Scalar_t(0));
+  for (size_t i = 0; i < kVS; ++i) {
+    vecCore::Set(a, i, Scalar_t(i % 3));
+    vecCore::Set(b, i, Scalar_t(1));
+  }
+
+  Vector_t min = a, max = a;
+  Index_t imin(SIndex_t(1)), imax(SIndex_t(1));
+  vecCore::MinIndex(min, b, imin, Index_t(SIndex_t(2)));
+  vecCore::MaxIndex(max, b, imax, Index_t(SIndex_t(2)));
+
+  // ties keep the first operand
+  for (size_t i = 0; i < kVS; ++i) {
+    EXPECT_EQ(vecCore::Get(min, i), Scalar_t(i % 3 < 1 ? i % 3 : 1));
+    EXPECT_EQ(vecCore::Get(max, i), Scalar_t(i % 3 > 1 ? i % 3 : 1));
+    EXPECT_EQ(vecCore::Get(imin, i), SIndex_t(i % 3 > 1 ? 2 : 1));
+    EXPECT_EQ(vecCore::Get(imax, i), SIndex_t(i % 3 < 1 ? 2 : 1));
+  }
+}
+
 TYPED_TEST_P(VectorInterfaceTest, Convert)
 {
   using Scalar_t = typename TestFixture::Scalar_t;
@@ -564,8 +685,9 @@ REGISTER_TYPED_TEST_CASE_P(VectorInterfaceTest,
                            VectorSize, VectorSizeVariable,
                            VectorLaneRead, VectorLaneWrite,
                            MaskLaneRead, MaskLaneWrite,
-                           StoreToPtr, StoreMaskToPtr,
+                           StoreToPtr, StoreMaskToPtr, AlignedLoadStore,
                            ReduceAdd, ReduceMinMax,
+                           ReduceAddN, ReduceMinMaxIndex, MinMaxIndex,
                            Convert, Gather, Scatter);
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,269 @@
+#include <VecCore/VecCore>
+#include <VecCore/Basketizer.h>
+
+#include <atomic>
+#include <chrono>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+#include <gtest/gtest.h>
+
+using namespace testing;
+
+#if defined(GTEST_HAS_TYPED_TEST) && defined(GTEST_HAS_TYPED_TEST_P)
+
+template <class Backend>
+using FloatTypes = Types<typename Backend::Float_v, typename Backend::Double_v>;
+
+///////////////////////////////////////////////////////////////////////////////
+
+template <class T>
+class VectorTypeTest : public Test {
+public:
+  using Scalar_t = typename vecCore::ScalarType<T>::Type;
+  using Vector_t = T;
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+// Counts the items of each id, with y = 2 * id, and checks the padding of
+// flushed baskets
+template <typename T>
+struct CountKernel {
+  std::vector<std::atomic<int>> *count;
+  std::atomic<int> *errors;
+  std::atomic<size_t> *sizes;
+
+  void operator()(const vecCore::Basket<T, T> &b) const
+  {
+    using S = vecCore::Scalar<T>;
+
+    *sizes += b.Size();
+    for (size_t i = 0; i < b.GetNblocks(); ++i) {
+      T id = b.template Field<0>(i), y = b.template Field<1>(i);
+      for (size_t k = 0; k < vecCore::VectorSize<T>(); ++k) {
+        const S idk = vecCore::Get(id, k);
+        if (vecCore::Get(y, k) != S(2) * idk) ++*errors;
+        if (k < b.GetBlockCount(i))
+          ++(*count)[size_t(idk)];
+        else if (idk != b.template Data<0>()[0])
+          ++*errors;
+      }
+    }
+  }
+};
+
+template <class T>
+class BasketizerTest : public VectorTypeTest<T> {
+public:
+  BasketizerTest() : fCount(10000), fErrors(0), fSizes(0)
+  {
+    for (auto &c : fCount)
+      c = 0;
+  }
+
+  CountKernel<T> Kernel() { return CountKernel<T>{&fCount, &fErrors, &fSizes}; }
+
+  std::vector<std::atomic<int>> fCount;
+  std::atomic<int> fErrors;
+  std::atomic<size_t> fSizes;
+};
+
+TYPED_TEST_CASE_P(BasketizerTest);
+
+TYPED_TEST_P(BasketizerTest, Capacity)
+{
+  using Vector_t = typename TestFixture::Vector_t;
+  constexpr size_t kVS = vecCore::VectorSize<Vector_t>();
+
+  vecCore::Basketizer<CountKernel<Vector_t>, Vector_t, Vector_t> b1(this->Kernel(), 1), b2(this->Kernel(), 3 * kVS);
+
+  EXPECT_EQ(b1.Capacity(), kVS);
+  EXPECT_EQ(b2.Capacity(), 3 * kVS);
+}
+
+TYPED_TEST_P(BasketizerTest, Push)
+{
+  using Scalar_t = typename TestFixture::Scalar_t;
+  using Vector_t = typename TestFixture::Vector_t;
+
+  const size_t n = 1000;
+  vecCore::Basketizer<CountKernel<Vector_t>, Vector_t, Vector_t> baskets(this->Kernel(), 30, 2, {});
+
+  for (size_t i = 0; i < n; ++i)
+    baskets.Push(Scalar_t(i), Scalar_t(2 * i));
+
+  // only full baskets are consumed until the flush
+  const size_t capacity = baskets.Capacity();
+  EXPECT_EQ(this->fSizes.load(), n / capacity * capacity);
+  EXPECT_FALSE(baskets.Poll());
+
+  baskets.Flush();
+  EXPECT_EQ(this->fSizes.load(), n);
+  EXPECT_EQ(this->fErrors.load(), 0);
+  for (size_t i = 0; i < this->fCount.size(); ++i)
+    EXPECT_EQ(this->fCount[i].load(), i < n ? 1 : 0);
+
+  vecCore::BasketizerStats stats = baskets.Stats();
+  EXPECT_EQ(stats.fItems, n);
+  EXPECT_EQ(stats.fBaskets, (n + capacity - 1) / capacity);
+  EXPECT_EQ(stats.fFlushed, n % capacity ? 1u : 0u);
+  EXPECT_DOUBLE_EQ(stats.FillRatio(), double(n) / double(stats.fBaskets * capacity));
+  EXPECT_GE(stats.MaxLatency(), stats.MeanLatency());
+
+  // flushing without items does nothing
+  baskets.Flush();
+  EXPECT_EQ(baskets.Stats().fBaskets, stats.fBaskets);
+
+  baskets.Reset();
+  EXPECT_EQ(baskets.Stats().fBaskets, 0u);
+  EXPECT_EQ(baskets.Stats().FillRatio(), 0.0);
+}
+
+TYPED_TEST_P(BasketizerTest, Deadline)
+{
+  using Scalar_t = typename TestFixture::Scalar_t;
+  using Vector_t = typename TestFixture::Vector_t;
+
+  vecCore::Basketizer<CountKernel<Vector_t>, Vector_t, Vector_t> baskets(this->Kernel(), 64, 4,
+                                                                         std::chrono::milliseconds(1));
+
+  EXPECT_FALSE(baskets.Poll());
+  baskets.Push(Scalar_t(3), Scalar_t(6));
+  std::this_thread::sleep_for(std::chrono::milliseconds(5));
+
+  EXPECT_TRUE(baskets.Poll());
+  EXPECT_FALSE(baskets.Poll());
+  EXPECT_EQ(this->fSizes.load(), 1u);
+  EXPECT_EQ(this->fCount[3].load(), 1);
+  EXPECT_EQ(this->fErrors.load(), 0);
+  EXPECT_GE(baskets.Stats().MaxLatency(), 1e-3);
+  EXPECT_EQ(baskets.Stats().fFlushed, 1u);
+}
+
+TYPED_TEST_P(BasketizerTest, Threads)
+{
+  using Scalar_t = typename TestFixture::Scalar_t;
+  using Vector_t = typename TestFixture::Vector_t;
+
+  const size_t producers = 4, n = this->fCount.size() / producers;
+  vecCore::Basketizer<CountKernel<Vector_t>, Vector_t, Vector_t> baskets(this->Kernel(), 16, 2);
+
+  std::vector<std::thread> threads;
+  for (size_t p = 0; p < producers; ++p)
+    threads.emplace_back([&, p] {
+      for (size_t i = p * n; i < (p + 1) * n; ++i) {
+        baskets.Push(Scalar_t(i), Scalar_t(2 * i));
+        if (i % 100 == 0) baskets.Poll();
+      }
+    });
+  for (auto &thread : threads)
+    thread.join();
+
+  baskets.Flush();
+  EXPECT_EQ(this->fErrors.load(), 0);
+  for (auto &c : this->fCount)
+    EXPECT_EQ(c.load(), 1);
+  EXPECT_EQ(baskets.Stats().fItems, producers * n);
+}
+
+REGISTER_TYPED_TEST_CASE_P(BasketizerTest, Capacity, Push, Deadline, Threads);
+
+#define TEST_BACKEND_P(name, x) INSTANTIATE_TYPED_TEST_CASE_P(name, BasketizerTest, FloatTypes<vecCore::backend::x>);
+
+#define TEST_BACKEND(x) TEST_BACKEND_P(x, x)
+
+///////////////////////////////////////////////////////////////////////////////
+
+TEST_BACKEND(Scalar);
+TEST_BACKEND(ScalarWrapper);
+
+#ifdef VECCORE_ENABLE_VC
+TEST_BACKEND(VcScalar);
+TEST_BACKEND(VcVector);
+TEST_BACKEND_P(VcSimdArray, VcSimdArray<16>);
+#endif
+
+#ifdef VECCORE_ENABLE_UMESIMD
+TEST_BACKEND(UMESimd);
+TEST_BACKEND_P(UMESimdArray, UMESimdArray<16>);
+#endif
+
+#ifdef VECCORE_ENABLE_AGNER
+TEST_BACKEND(AgnerAVX);
+TEST_BACKEND(AgnerAVX512);
+#endif
+
+#else // if !GTEST_HAS_TYPED_TEST
+TEST(DummyTest, TypedTestsAreNotSupportedOnThisPlatform)
+{
+}
+#endif
+
+///////////////////////////////////////////////////////////////////////////////
+
+struct Throw {
+  void operator()(const vecCore::Basket<vecCore::Real_s> &b) const
+  {
+    if (b.Data<0>()[0] == 1) throw std::runtime_error("kernel");
+  }
+};
+
+TEST(Basketizer, Exception)
+{
+  vecCore::Basketizer<Throw, vecCore::Real_s> baskets(Throw(), 1, 1);
+
+  EXPECT_THROW(baskets.Push(1), std::runtime_error);
+
+  // the basket is released
+  baskets.Push(2);
+  EXPECT_EQ(baskets.Stats().fBaskets, 2u);
+}
+
+// Blocks the kernel of the item 0 until released
+struct Block {
+  std::atomic<bool> *entered;
+  std::atomic<bool> *release;
+
+  void operator()(const vecCore::Basket<vecCore::Real_s> &b) const
+  {
+    if (b.Data<0>()[0] != 0) return;
+    *entered = true;
+    while (!*release)
+      std::this_thread::yield();
+  }
+};
+
+TEST(Basketizer, FlushWaitsForOlderBaskets)
+{
+  std::atomic<bool> entered(false), release(false), flushed(false);
+  vecCore::Basketizer<Block, vecCore::Real_s> baskets(Block{&entered, &release}, 1, 4);
+
+  std::thread first([&] { baskets.Push(0); });
+  while (!entered)
+    std::this_thread::yield();
+
+  baskets.Push(1);
+  std::thread flush([&] {
+    baskets.Flush();
+    flushed = true;
+  });
+  std::this_thread::sleep_for(std::chrono::milliseconds(10));
+
+  // a later basket consumed while the first one is still in its kernel
+  baskets.Push(2);
+  std::this_thread::sleep_for(std::chrono::milliseconds(20));
+  EXPECT_FALSE(flushed.load());
+
+  release = true;
+  first.join();
+  flush.join();
+  EXPECT_TRUE(flushed.load());
+  EXPECT_EQ(baskets.Stats().fBaskets, 3u);
+}
+
+int main(int argc, char *argv[])
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,254 @@
+#include <VecCore/VecCore>
+
+#include <complex>
+#include <limits>
+#include <vector>
+#include <gtest/gtest.h>
+
+using namespace testing;
+
+#if defined(GTEST_HAS_TYPED_TEST) && defined(GTEST_HAS_TYPED_TEST_P)
+
+template <class Backend>
+using FloatTypes = Types<typename Backend::Float_v, typename Backend::Double_v>;
+
+///////////////////////////////////////////////////////////////////////////////
+
+template <class T>
+class VectorTypeTest : public Test {
+public:
+  using Scalar_t  = typename vecCore::ScalarType<T>::Type;
+  using Vector_t  = T;
+  using Complex_t = std::complex<Scalar_t>;
+  using Complex_v = vecCore::Complex<T>;
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+template <class T>
+class ComplexTest : public VectorTypeTest<T> {
+public:
+  using Complex_t = typename VectorTypeTest<T>::Complex_t;
+
+  static constexpr size_t kN = 64;
+
+  std::vector<Complex_t> Random(double range)
+  {
+    std::vector<Complex_t> z(kN);
+    for (auto &x : z)
+      x = Complex_t(range * (2.0 * drand48() - 1.0), range * (2.0 * drand48() - 1.0));
+    return z;
+  }
+
+  // relative error of a result in units of epsilon
+  static double Error(Complex_t z, Complex_t ref)
+  {
+    return std::abs(z - ref) / std::abs(ref) / std::numeric_limits<typename Complex_t::value_type>::epsilon();
+  }
+};
+
+TYPED_TEST_CASE_P(ComplexTest);
+
+TYPED_TEST_P(ComplexTest, LoadStore)
+{
+  using Complex_t = typename TestFixture::Complex_t;
+  using Complex_v = typename TestFixture::Complex_v;
+  using Vector_t  = typename TestFixture::Vector_t;
+
+  size_t kVS = vecCore::VectorSize<Vector_t>();
+
+  EXPECT_EQ(kVS, vecCore::VectorSize<Complex_v>());
+
+  std::vector<Complex_t> input = this->Random(1.0), output(TestFixture::kN);
+
+  for (size_t j = 0; j < TestFixture::kN; j += kVS) {
+    Complex_v z;
+    vecCore::Load(z, &input[j]);
+
+    for (size_t i = 0; i < kVS; ++i) {
+      EXPECT_EQ(input[j + i].real(), vecCore::Get(z.Real(), i));
+      EXPECT_EQ(input[j + i].imag(), vecCore::Get(z.Imag(), i));
+    }
+
+    vecCore::Store(z, &output[j]);
+  }
+
+  EXPECT_EQ(input, output);
+}
+
+TYPED_TEST_P(ComplexTest, Arithmetic)
+{
+  using Complex_t = typename TestFixture::Complex_t;
+  using Complex_v = typename TestFixture::Complex_v;
+  using Vector_t  = typename TestFixture::Vector_t;
+
+  size_t kVS = vecCore::VectorSize<Vector_t>();
+
+  std::vector<Complex_t> a = this->Random(4.0), b = this->Random(4.0);
+
+  for (size_t j = 0; j < TestFixture::kN; j += kVS) {
+    Complex_v x, y;
+    vecCore::Load(x, &a[j]);
+    vecCore::Load(y, &b[j]);
+
+    Complex_v sum = x + y, diff = x - y, prod = x * y, quot = x / y, neg = -x;
+    Complex_v scaled = y.Real() * x, shifted = x + y.Real();
+
+    for (size_t i = 0; i < kVS; ++i) {
+      Complex_t u = a[j + i], v = b[j + i];
+      EXPECT_EQ(u + v, vecCore::Get(sum, i));
+      EXPECT_EQ(u - v, vecCore::Get(diff, i));
+      EXPECT_EQ(-u, vecCore::Get(neg, i));
+      EXPECT_EQ(v.real() * u, vecCore::Get(scaled, i));
+      EXPECT_EQ(u + v.real(), vecCore::Get(shifted, i));
+      EXPECT_LT(this->Error(vecCore::Get(prod, i), u * v), 2.0);
+      EXPECT_LT(this->Error(vecCore::Get(quot, i), u / v), 4.0);
+    }
+  }
+}
+
+TYPED_TEST_P(ComplexTest, Functions)
+{
+  using Complex_t = typename TestFixture::Complex_t;
+  using Complex_v = typename TestFixture::Complex_v;
+  using Vector_t  = typename TestFixture::Vector_t;
+
+  size_t kVS = vecCore::VectorSize<Vector_t>();
+
+  std::vector<Complex_t> a = this->Random(4.0);
+
+  for (size_t j = 0; j < TestFixture::kN; j += kVS) {
+    Complex_v z;
+    vecCore::Load(z, &a[j]);
+
+    Vector_t abs2 = vecCore::math::Abs2(z), abs = vecCore::math::Abs(z), arg = vecCore::math::Arg(z);
+    Complex_v exp = vecCore::math::Exp(z), log = vecCore::math::Log(z), sqrt = vecCore::math::Sqrt(z);
+
+    for (size_t i = 0; i < kVS; ++i) {
+      Complex_t u = a[j + i];
+      EXPECT_LT(this->Error(vecCore::Get(abs2, i), std::norm(u)), 2.0);
+      EXPECT_LT(this->Error(vecCore::Get(abs, i), std::abs(u)), 4.0);
+      EXPECT_LT(this->Error(vecCore::Get(arg, i), std::arg(u)), 4.0);
+      EXPECT_LT(this->Error(vecCore::Get(exp, i), std::exp(u)), 8.0);
+      EXPECT_LT(this->Error(vecCore::Get(log, i), std::log(u)), 8.0);
+      EXPECT_LT(this->Error(vecCore::Get(sqrt, i), std::sqrt(u)), 8.0);
+    }
+  }
+}
+
+TYPED_TEST_P(ComplexTest, Pow)
+{
+  using Scalar_t  = typename TestFixture::Scalar_t;
+  using Complex_t = typename TestFixture::Complex_t;
+  using Complex_v = typename TestFixture::Complex_v;
+  using Vector_t  = typename TestFixture::Vector_t;
+
+  size_t kVS = vecCore::VectorSize<Vector_t>();
+
+  // powers of small Gaussian integers are exact
+
+  std::vector<Complex_t> a(TestFixture::kN);
+  for (size_t i = 0; i < TestFixture::kN; ++i)
+    a[i] = Complex_t(Scalar_t(i % 5) - 2, Scalar_t(i % 3) - 1);
+
+  for (size_t j = 0; j < TestFixture::kN; j += kVS) {
+    Complex_v z;
+    vecCore::Load(z, &a[j]);
+
+    for (int n = 0; n <= 7; ++n) {
+      Complex_v p = vecCore::math::Pow(z, n);
+      for (size_t i = 0; i < kVS; ++i) {
+        Complex_t ref(1);
+        for (int k = 0; k < n; ++k)
+          ref *= a[j + i];
+        EXPECT_EQ(ref, vecCore::Get(p, i)) << a[j + i] << "^" << n;
+      }
+    }
+  }
+
+  a = this->Random(2.0);
+
+  for (size_t j = 0; j < TestFixture::kN; j += kVS) {
+    Complex_v z;
+    vecCore::Load(z, &a[j]);
+
+    Complex_v p = vecCore::math::Pow(z, -3), q = vecCore::math::Pow(z, z);
+
+    for (size_t i = 0; i < kVS; ++i) {
+      EXPECT_LT(this->Error(vecCore::Get(p, i), std::pow(a[j + i], -3)), 16.0);
+      EXPECT_LT(this->Error(vecCore::Get(q, i), std::pow(a[j + i], a[j + i])), 32.0);
+    }
+  }
+}
+
+TYPED_TEST_P(ComplexTest, Masking)
+{
+  using Scalar_t  = typename TestFixture::Scalar_t;
+  using Complex_t = typename TestFixture::Complex_t;
+  using Complex_v = typename TestFixture::Complex_v;
+  using Vector_t  = typename TestFixture::Vector_t;
+
+  size_t kVS = vecCore::VectorSize<Vector_t>();
+
+  std::vector<Complex_t> a = this->Random(1.0), b = this->Random(1.0);
+
+  for (size_t j = 0; j < TestFixture::kN; j += kVS) {
+    Complex_v x, y;
+    vecCore::Load(x, &a[j]);
+    vecCore::Load(y, &b[j]);
+
+    vecCore::Mask<Vector_t> mask = x.Real() > Vector_t(Scalar_t(0));
+
+    Complex_v blend = vecCore::Blend(mask, x, y);
+    vecCore::MaskedAssign(y, mask, x);
+
+    vecCore::Mask<Vector_t> equal = blend == y, different = blend != x;
+
+    for (size_t i = 0; i < kVS; ++i) {
+      Complex_t ref = a[j + i].real() > 0 ? a[j + i] : b[j + i];
+      EXPECT_EQ(ref, vecCore::Get(blend, i));
+      EXPECT_EQ(ref, vecCore::Get(y, i));
+      EXPECT_TRUE(vecCore::Get(equal, i));
+      EXPECT_EQ(ref != a[j + i], vecCore::Get(different, i));
+    }
+  }
+}
+
+REGISTER_TYPED_TEST_CASE_P(ComplexTest, LoadStore, Arithmetic, Functions, Pow, Masking);
+
+#define TEST_BACKEND_P(name, x) INSTANTIATE_TYPED_TEST_CASE_P(name, ComplexTest, FloatTypes<vecCore::backend::x>);
+
+#define TEST_BACKEND(x) TEST_BACKEND_P(x, x)
+
+///////////////////////////////////////////////////////////////////////////////
+
+TEST_BACKEND(Scalar);
+TEST_BACKEND(ScalarWrapper);
+
+#ifdef VECCORE_ENABLE_VC
+TEST_BACKEND(VcScalar);
+TEST_BACKEND(VcVector);
+TEST_BACKEND_P(VcSimdArray, VcSimdArray<16>);
+#endif
+
+#ifdef VECCORE_ENABLE_UMESIMD
+TEST_BACKEND(UMESimd);
+TEST_BACKEND_P(UMESimdArray, UMESimdArray<16>);
+#endif
+
+#ifdef VECCORE_ENABLE_AGNER
+TEST_BACKEND(AgnerAVX);
+TEST_BACKEND(AgnerAVX512);
+#endif
+
+#else // if !GTEST_HAS_TYPED_TEST
+TEST(DummyTest, TypedTestsAreNotSupportedOnThisPlatform)
+{
+}
+#endif
+
+int main(int argc, char *argv[])
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
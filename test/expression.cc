@@ -0,0 +1,210 @@
+#include <VecCore/VecCore>
+
+#include <cmath>
+#include <stdexcept>
+#include <vector>
+#include <gtest/gtest.h>
+
+using namespace testing;
+using vecCore::ArrayView;
+
+#if defined(GTEST_HAS_TYPED_TEST) && defined(GTEST_HAS_TYPED_TEST_P)
+
+template <class Backend>
+using FloatTypes = Types<typename Backend::Float_v, typename Backend::Double_v>;
+
+///////////////////////////////////////////////////////////////////////////////
+
+template <class T>
+class VectorTypeTest : public Test {
+public:
+  using Scalar_t = typename vecCore::ScalarType<T>::Type;
+  using Vector_t = T;
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+template <class T>
+class ExpressionTest : public VectorTypeTest<T> {
+public:
+  using Scalar_t = typename VectorTypeTest<T>::Scalar_t;
+  using Array_t  = std::vector<Scalar_t>;
+
+  // sizes with every possible remainder, including empty arrays
+  static size_t MaxSize() { return 3 * vecCore::VectorSize<T>() + 1; }
+
+  static Array_t Random(size_t n, double lo, double hi)
+  {
+    Array_t a(n);
+    for (auto &x : a)
+      x = static_cast<Scalar_t>(lo + (hi - lo) * drand48());
+    return a;
+  }
+
+  static void ExpectNear(const Array_t &a, const Array_t &ref)
+  {
+    ASSERT_EQ(a.size(), ref.size());
+    for (size_t i = 0; i < a.size(); ++i)
+      EXPECT_NEAR(a[i], ref[i], 64 * std::numeric_limits<Scalar_t>::epsilon() * (1 + std::abs(ref[i])));
+  }
+};
+
+TYPED_TEST_CASE_P(ExpressionTest);
+
+TYPED_TEST_P(ExpressionTest, Arithmetic)
+{
+  using Scalar_t = typename TestFixture::Scalar_t;
+  using Array_t  = typename TestFixture::Array_t;
+
+  for (size_t n = 0; n <= TestFixture::MaxSize(); ++n) {
+    Array_t a = TestFixture::Random(n, -2, 2), b = TestFixture::Random(n, 1, 2);
+    Array_t c(n), ref(n);
+
+    ArrayView<TypeParam> va(a.data(), n), vb(b.data(), n), vc(c.data(), n);
+
+    vc = Scalar_t(2) * va + vb / va - (-vb) * 3.0 + 1;
+
+    for (size_t i = 0; i < n; ++i)
+      ref[i] = Scalar_t(2) * a[i] + b[i] / a[i] - (-b[i]) * Scalar_t(3) + Scalar_t(1);
+
+    TestFixture::ExpectNear(c, ref);
+  }
+}
+
+TYPED_TEST_P(ExpressionTest, Blend)
+{
+  using Scalar_t = typename TestFixture::Scalar_t;
+  using Array_t  = typename TestFixture::Array_t;
+
+  for (size_t n = 0; n <= TestFixture::MaxSize(); ++n) {
+    Array_t a = TestFixture::Random(n, -2, 2), b = TestFixture::Random(n, -2, 2);
+    Array_t c(n), ref(n);
+
+    ArrayView<TypeParam> va(a.data(), n), vb(b.data(), n), vc(c.data(), n);
+
+    vc = vecCore::Blend(va < vb && !(va < -1), va - vb, 0.5 * vb);
+
+    for (size_t i = 0; i < n; ++i)
+      ref[i] = (a[i] < b[i] && !(a[i] < -1)) ? a[i] - b[i] : Scalar_t(0.5) * b[i];
+
+    TestFixture::ExpectNear(c, ref);
+
+    // absolute value without math::Abs()
+    vc = vecCore::Blend(va >= 0 || va == vb, va, -va);
+
+    for (size_t i = 0; i < n; ++i)
+      EXPECT_EQ(c[i], std::abs(a[i]));
+  }
+}
+
+TYPED_TEST_P(ExpressionTest, Math)
+{
+  using Scalar_t = typename TestFixture::Scalar_t;
+  using Array_t  = typename TestFixture::Array_t;
+
+  using namespace vecCore::math;
+
+  for (size_t n = 0; n <= TestFixture::MaxSize(); ++n) {
+    Array_t a = TestFixture::Random(n, 0.5, 2), b = TestFixture::Random(n, -1, 1);
+    Array_t c(n), ref(n);
+
+    ArrayView<TypeParam> va(a.data(), n), vb(b.data(), n), vc(c.data(), n);
+
+    // the padding of the last vector must keep Log() and Sqrt() finite
+    vc = Sqrt(va) * Exp(vb) + Log(va * va) - Max(va, vb) + Min(0.25, vb);
+
+    for (size_t i = 0; i < n; ++i)
+      ref[i] = std::sqrt(a[i]) * std::exp(b[i]) + std::log(a[i] * a[i]) - std::max(a[i], b[i]) +
+               std::min(Scalar_t(0.25), b[i]);
+
+    TestFixture::ExpectNear(c, ref);
+
+    vc = FMA(va, vb, Abs(vb)) + Pow(va, va) + ATan2(Sin(vb), Cos(vb + 1));
+
+    for (size_t i = 0; i < n; ++i)
+      ref[i] = a[i] * b[i] + std::abs(b[i]) + std::pow(a[i], a[i]) + std::atan2(std::sin(b[i]), std::cos(b[i] + 1));
+
+    TestFixture::ExpectNear(c, ref);
+  }
+}
+
+TYPED_TEST_P(ExpressionTest, Assignment)
+{
+  using Scalar_t = typename TestFixture::Scalar_t;
+  using Array_t  = typename TestFixture::Array_t;
+
+  for (size_t n = 0; n <= TestFixture::MaxSize(); ++n) {
+    Array_t a = TestFixture::Random(n, 1, 2), b = TestFixture::Random(n, 1, 2);
+    Array_t c(n), ref(a);
+
+    ArrayView<TypeParam> va(a.data(), n), vb(b.data(), n), vc(c.data(), n);
+
+    // a copy refers to the same data
+    ArrayView<TypeParam> alias(va);
+    EXPECT_EQ(alias.Data(), a.data());
+
+    va += vb;
+    va *= 2;
+    va -= vb * vb;
+    va /= vb;
+
+    for (size_t i = 0; i < n; ++i)
+      ref[i] = ((ref[i] + b[i]) * Scalar_t(2) - b[i] * b[i]) / b[i];
+
+    TestFixture::ExpectNear(a, ref);
+
+    // assigning a view copies the elements
+    vc = va;
+    EXPECT_EQ(c, a);
+
+    vc = Scalar_t(3);
+    EXPECT_EQ(c, Array_t(n, Scalar_t(3)));
+
+    // operands of another size are rejected, and nothing is written
+    Array_t d(n + 1, Scalar_t(1));
+    ArrayView<TypeParam> vd(d.data(), n + 1);
+    EXPECT_THROW(vc = va + vd, std::length_error);
+    EXPECT_THROW(vd = va, std::length_error);
+    EXPECT_EQ(c, Array_t(n, Scalar_t(3)));
+    EXPECT_EQ(d, Array_t(n + 1, Scalar_t(1)));
+  }
+}
+
+REGISTER_TYPED_TEST_CASE_P(ExpressionTest, Arithmetic, Blend, Math, Assignment);
+
+#define TEST_BACKEND_P(name, x) INSTANTIATE_TYPED_TEST_CASE_P(name, ExpressionTest, FloatTypes<vecCore::backend::x>);
+
+#define TEST_BACKEND(x) TEST_BACKEND_P(x, x)
+
+///////////////////////////////////////////////////////////////////////////////
+
+TEST_BACKEND(Scalar);
+TEST_BACKEND(ScalarWrapper);
+
+#ifdef VECCORE_ENABLE_VC
+TEST_BACKEND(VcScalar);
+TEST_BACKEND(VcVector);
+TEST_BACKEND_P(VcSimdArray, VcSimdArray<16>);
+#endif
+
+#ifdef VECCORE_ENABLE_UMESIMD
+TEST_BACKEND(UMESimd);
+TEST_BACKEND_P(UMESimdArray, UMESimdArray<16>);
+#endif
+
+#ifdef VECCORE_ENABLE_AGNER
+TEST_BACKEND(AgnerAVX);
+TEST_BACKEND(AgnerAVX512);
+#endif
+
+#else // if !GTEST_HAS_TYPED_TEST
+TEST(DummyTest, TypedTestsAreNotSupportedOnThisPlatform)
+{
+}
+#endif
+
+int main(int argc, char *argv[])
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,141 @@
+#define VECCORE_REPORT_FALLBACKS
+
+#include <VecCore/VecCore>
+
+#include <gtest/gtest.h>
+
+using namespace testing;
+
+#if defined(GTEST_HAS_TYPED_TEST) && defined(GTEST_HAS_TYPED_TEST_P)
+
+template <class Backend>
+using FloatTypes = Types<typename Backend::Float_v, typename Backend::Double_v>;
+
+///////////////////////////////////////////////////////////////////////////////
+
+template <class T>
+class VectorTypeTest : public Test {
+public:
+  using Scalar_t = typename vecCore::ScalarType<T>::Type;
+  using Vector_t = T;
+  using Index_v  = typename vecCore::Index_v<T>;
+  using Index_t  = typename vecCore::ScalarType<Index_v>::Type;
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+template <class T>
+class FallbackTest : public VectorTypeTest<T> {
+public:
+  template <typename U>
+  static uint64_t Count(const char *operation)
+  {
+    return vecCore::fallback::Registry::Instance().Count<U>(operation);
+  }
+};
+
+TYPED_TEST_CASE_P(FallbackTest);
+
+TYPED_TEST_P(FallbackTest, Gather)
+{
+  using Scalar_t = typename TestFixture::Scalar_t;
+  using Vector_t = typename TestFixture::Vector_t;
+  using Index_v  = typename TestFixture::Index_v;
+  using Index_t  = typename TestFixture::Index_t;
+
+  constexpr size_t kVS = vecCore::VectorSize<Vector_t>();
+
+  Scalar_t data[kVS];
+  Index_v idx(Index_t(0));
+  for (size_t i = 0; i < kVS; ++i) {
+    data[i] = Scalar_t(i);
+    vecCore::Set(idx, i, Index_t(kVS - 1 - i));
+  }
+
+  const uint64_t before = TestFixture::template Count<Vector_t>("Gather");
+  Vector_t v = vecCore::Gather<Vector_t>(data, idx);
+  const uint64_t after = TestFixture::template Count<Vector_t>("Gather");
+
+  for (size_t i = 0; i < kVS; ++i)
+    EXPECT_EQ(vecCore::Get(v, i), Scalar_t(kVS - 1 - i));
+
+  // counted once, unless the gather is native, as for types of one lane
+  EXPECT_EQ(after - before, vecCore::HasNativeGather<Vector_t>::value ? 0u : 1u);
+}
+
+TYPED_TEST_P(FallbackTest, Convert)
+{
+  using Scalar_t = typename TestFixture::Scalar_t;
+  using Vector_t = typename TestFixture::Vector_t;
+  using Index_v  = typename TestFixture::Index_v;
+  using Index_t  = typename TestFixture::Index_t;
+
+  constexpr size_t kVS = vecCore::VectorSize<Vector_t>();
+
+  const uint64_t before = TestFixture::template Count<Vector_t>("Convert");
+  for (int k = 0; k < 3; ++k) {
+    Index_v idx = vecCore::Convert<Index_v>(Vector_t(Scalar_t(k)));
+    EXPECT_EQ(vecCore::Get(idx, 0), Index_t(k));
+  }
+  const uint64_t after = TestFixture::template Count<Vector_t>("Convert");
+
+  EXPECT_EQ(after - before, kVS > 1 ? 3u : 0u);
+}
+
+TYPED_TEST_P(FallbackTest, Specialized)
+{
+  using Scalar_t = typename TestFixture::Scalar_t;
+  using Vector_t = typename TestFixture::Vector_t;
+
+  constexpr size_t kVS = vecCore::VectorSize<Vector_t>();
+
+  // Load() is specialized by all backends, so is never counted
+  Scalar_t data[kVS];
+  for (size_t i = 0; i < kVS; ++i)
+    data[i] = Scalar_t(i);
+
+  Vector_t v;
+  vecCore::Load(v, data);
+
+  EXPECT_EQ(vecCore::Get(v, kVS - 1), Scalar_t(kVS - 1));
+  EXPECT_EQ(TestFixture::template Count<Vector_t>("Load"), 0u);
+}
+
+REGISTER_TYPED_TEST_CASE_P(FallbackTest, Gather, Convert, Specialized);
+
+#define TEST_BACKEND_P(name, x) INSTANTIATE_TYPED_TEST_CASE_P(name, FallbackTest, FloatTypes<vecCore::backend::x>);
+
+#define TEST_BACKEND(x) TEST_BACKEND_P(x, x)
+
+///////////////////////////////////////////////////////////////////////////////
+
+TEST_BACKEND(Scalar);
+TEST_BACKEND(ScalarWrapper);
+
+#ifdef VECCORE_ENABLE_VC
+TEST_BACKEND(VcScalar);
+TEST_BACKEND(VcVector);
+TEST_BACKEND_P(VcSimdArray, VcSimdArray<16>);
+#endif
+
+#ifdef VECCORE_ENABLE_UMESIMD
+TEST_BACKEND(UMESimd);
+TEST_BACKEND_P(UMESimdArray, UMESimdArray<16>);
+#endif
+
+#ifdef VECCORE_ENABLE_AGNER
+TEST_BACKEND(AgnerAVX);
+TEST_BACKEND(AgnerAVX512);
+#endif
+
+#else // if !GTEST_HAS_TYPED_TEST
+TEST(DummyTest, TypedTestsAreNotSupportedOnThisPlatform)
+{
+}
+#endif
+
+int main(int argc, char *argv[])
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
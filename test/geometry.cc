@@ -0,0 +1,240 @@
+#include <VecCore/VecCore>
+
+#include <cmath>
+#include <limits>
+#include <gtest/gtest.h>
+
+using namespace testing;
+using namespace vecCore::geometry;
+
+#if defined(GTEST_HAS_TYPED_TEST) && defined(GTEST_HAS_TYPED_TEST_P)
+
+template <class Backend>
+using FloatTypes = Types<typename Backend::Float_v, typename Backend::Double_v>;
+
+///////////////////////////////////////////////////////////////////////////////
+
+template <class T>
+class VectorTypeTest : public Test {
+public:
+  using Scalar_t = typename vecCore::ScalarType<T>::Type;
+  using Vector_t = T;
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+template <class T>
+class GeometryTest : public VectorTypeTest<T> {
+public:
+  using Scalar_t   = typename VectorTypeTest<T>::Scalar_t;
+  using Vector3D_s = vecCore::Vector3D<Scalar_t>;
+  using Vector3D_v = vecCore::Vector3D<T>;
+
+  static constexpr size_t kN       = 256;
+  static constexpr size_t kSamples = 64;
+
+  // absolute tolerance for points on the surface of solids of size ~1
+  static Scalar_t Tolerance() { return 4096 * std::numeric_limits<Scalar_t>::epsilon(); }
+
+  static Scalar_t Random() { return static_cast<Scalar_t>(4.0 * drand48() - 2.0); }
+
+  static Vector3D_s RandomDirection()
+  {
+    Vector3D_s d;
+    do {
+      d = Vector3D_s(Random(), Random(), Random());
+    } while (d.Mag2() > 4 || d.Mag2() < Scalar_t(0.01));
+    return d.Unit();
+  }
+
+  // batches of random points in [-2, 2]^3 and of isotropic directions
+  static void RandomRays(Vector3D_v &p, Vector3D_v &d)
+  {
+    for (size_t i = 0; i < vecCore::VectorSize<T>(); ++i) {
+      vecCore::Set(p, i, Vector3D_s(Random(), Random(), Random()));
+      vecCore::Set(d, i, RandomDirection());
+    }
+  }
+
+  static bool Lane(const vecCore::Mask<T> &mask, size_t i)
+  {
+    return vecCore::Get(vecCore::Blend(mask, T(Scalar_t(1)), T(Scalar_t(0))), i) != 0;
+  }
+
+  // as EXPECT_NEAR, but also accepting equal infinite distances
+  static void ExpectNear(Scalar_t a, Scalar_t b)
+  {
+    if (a != b) {
+      EXPECT_NEAR(a, b, Tolerance());
+    }
+  }
+
+  template <class Shape>
+  static bool OnSurface(const Shape &shape, const Vector3D_s &p)
+  {
+    return shape.SafetyToIn(p) <= Tolerance() && shape.SafetyToOut(p) <= Tolerance();
+  }
+
+  // checks each lane against the scalar kernels and against samples of the
+  // Contains() predicate along the ray
+  template <class Shape>
+  static void CheckShape(const Shape &shape)
+  {
+    const Scalar_t inf = std::numeric_limits<Scalar_t>::infinity();
+
+    for (size_t n = 0; n < kN; ++n) {
+      Vector3D_v pv, dv;
+      RandomRays(pv, dv);
+
+      T din   = shape.DistanceToIn(pv, dv);
+      T dout  = shape.DistanceToOut(pv, dv);
+      T sin   = shape.SafetyToIn(pv);
+      T sout  = shape.SafetyToOut(pv);
+      auto in = shape.Contains(pv);
+
+      for (size_t i = 0; i < vecCore::VectorSize<T>(); ++i) {
+        Vector3D_s p = vecCore::Get(pv, i), d = vecCore::Get(dv, i);
+        Scalar_t tin = vecCore::Get(din, i), tout = vecCore::Get(dout, i);
+
+        EXPECT_EQ(Lane(in, i), shape.Contains(p));
+        ExpectNear(tin, shape.DistanceToIn(p, d));
+        ExpectNear(tout, shape.DistanceToOut(p, d));
+        EXPECT_NEAR(vecCore::Get(sin, i), shape.SafetyToIn(p), Tolerance());
+        EXPECT_NEAR(vecCore::Get(sout, i), shape.SafetyToOut(p), Tolerance());
+
+        // safeties are lower bounds on the distances along any direction
+        EXPECT_LE(vecCore::Get(sin, i), tin);
+        EXPECT_LE(vecCore::Get(sout, i), tout);
+
+        if (shape.Contains(p)) {
+          EXPECT_EQ(tin, Scalar_t(0));
+          EXPECT_TRUE(OnSurface(shape, p + d * tout));
+          for (size_t k = 0; k < kSamples; ++k)
+            EXPECT_TRUE(shape.Contains(p + d * Scalar_t(tout * (k + 0.5) / kSamples)));
+        } else {
+          EXPECT_EQ(tout, Scalar_t(0));
+          EXPECT_GT(tin, Scalar_t(0));
+          Scalar_t range = tin < inf ? tin : Scalar_t(8);
+          if (tin < inf) {
+            EXPECT_TRUE(OnSurface(shape, p + d * tin));
+          }
+          for (size_t k = 0; k < kSamples; ++k)
+            EXPECT_FALSE(shape.Contains(p + d * Scalar_t(range * (k + 0.5) / kSamples)));
+        }
+      }
+    }
+  }
+};
+
+TYPED_TEST_CASE_P(GeometryTest);
+
+TYPED_TEST_P(GeometryTest, Slabs)
+{
+  using Scalar_t   = typename TestFixture::Scalar_t;
+  using Vector3D_s = typename TestFixture::Vector3D_s;
+  using Vector3D_v = typename TestFixture::Vector3D_v;
+
+  const Vector3D_v lo(Scalar_t(-0.5), Scalar_t(0.0), Scalar_t(0.5));
+  const Vector3D_v hi(Scalar_t(1.0), Scalar_t(0.5), Scalar_t(1.5));
+  const Box box(0.75, 0.25, 0.5);
+  const Vector3D_v center(Scalar_t(0.25), Scalar_t(0.25), Scalar_t(1.0));
+  const Scalar_t one(1);
+
+  for (size_t n = 0; n < TestFixture::kN; ++n) {
+    Vector3D_v p, d;
+    TestFixture::RandomRays(p, d);
+
+    TypeParam tnear, tfar;
+    auto hit = RayAABB(lo, hi, p, Vector3D_v(one / d.X(), one / d.Y(), one / d.Z()), tnear, tfar);
+
+    // same as the distance to the box centered at the origin
+    TypeParam dist = box.DistanceToIn(p - center, d);
+
+    for (size_t i = 0; i < vecCore::VectorSize<TypeParam>(); ++i) {
+      Scalar_t t = vecCore::Get(dist, i);
+      EXPECT_EQ(TestFixture::Lane(hit, i), t < std::numeric_limits<Scalar_t>::infinity());
+      if (TestFixture::Lane(hit, i)) {
+        EXPECT_NEAR(t, std::max(vecCore::Get(tnear, i), Scalar_t(0)), TestFixture::Tolerance());
+        Vector3D_s q = vecCore::Get(p, i) + vecCore::Get(d, i) * vecCore::Get(tfar, i);
+        EXPECT_TRUE(TestFixture::OnSurface(box, q - vecCore::Get(center, i)));
+      }
+    }
+  }
+}
+
+TYPED_TEST_P(GeometryTest, BoxKernels)
+{
+  TestFixture::CheckShape(Box(1.0, 0.5, 0.75));
+}
+
+TYPED_TEST_P(GeometryTest, SphereKernels)
+{
+  TestFixture::CheckShape(Sphere(1.25));
+}
+
+TYPED_TEST_P(GeometryTest, TubeKernels)
+{
+  TestFixture::CheckShape(Tube(0.0, 1.0, 0.75));
+  TestFixture::CheckShape(Tube(0.5, 1.25, 1.0));
+}
+
+TYPED_TEST_P(GeometryTest, ConeKernels)
+{
+  TestFixture::CheckShape(Cone(0.5, 1.25, 1.0));
+  TestFixture::CheckShape(Cone(1.0, 0.0, 0.75));
+}
+
+TYPED_TEST_P(GeometryTest, EarlyReturn)
+{
+  using Scalar_t   = typename TestFixture::Scalar_t;
+  using Vector3D_v = typename TestFixture::Vector3D_v;
+
+  // all lanes moving away from the solids, which may return early
+  const Vector3D_v p(Scalar_t(0.5), Scalar_t(-0.5), Scalar_t(3.0));
+  const Vector3D_v d(Scalar_t(0.0), Scalar_t(0.6), Scalar_t(0.8));
+  const TypeParam inf = vecCore::NumericLimits<TypeParam>::Infinity();
+
+  EXPECT_TRUE(vecCore::MaskFull(Box(1.0, 1.0, 1.0).DistanceToIn(p, d) == inf));
+  EXPECT_TRUE(vecCore::MaskFull(Sphere(1.0).DistanceToIn(p, d) == inf));
+  EXPECT_TRUE(vecCore::MaskFull(Tube(0.5, 1.0, 1.0).DistanceToIn(p, d) == inf));
+  EXPECT_TRUE(vecCore::MaskFull(Cone(0.5, 1.0, 1.0).DistanceToIn(p, d) == inf));
+}
+
+REGISTER_TYPED_TEST_CASE_P(GeometryTest, Slabs, BoxKernels, SphereKernels, TubeKernels, ConeKernels, EarlyReturn);
+
+#define TEST_BACKEND_P(name, x) INSTANTIATE_TYPED_TEST_CASE_P(name, GeometryTest, FloatTypes<vecCore::backend::x>);
+
+#define TEST_BACKEND(x) TEST_BACKEND_P(x, x)
+
+///////////////////////////////////////////////////////////////////////////////
+
+TEST_BACKEND(Scalar);
+TEST_BACKEND(ScalarWrapper);
+
+#ifdef VECCORE_ENABLE_VC
+TEST_BACKEND(VcScalar);
+TEST_BACKEND(VcVector);
+TEST_BACKEND_P(VcSimdArray, VcSimdArray<16>);
+#endif
+
+#ifdef VECCORE_ENABLE_UMESIMD
+TEST_BACKEND(UMESimd);
+TEST_BACKEND_P(UMESimdArray, UMESimdArray<16>);
+#endif
+
+#ifdef VECCORE_ENABLE_AGNER
+TEST_BACKEND(AgnerAVX);
+TEST_BACKEND(AgnerAVX512);
+#endif
+
+#else // if !GTEST_HAS_TYPED_TEST
+TEST(DummyTest, TypedTestsAreNotSupportedOnThisPlatform)
+{
+}
+#endif
+
+int main(int argc, char *argv[])
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,68 @@
+#include <VecCore/Agner>
+
+#include <gtest/gtest.h>
+
+// VecCore/Agner includes only the scalar and Agner backends, and the rest of
+// VecCore works with them as with VecCore/VecCore
+
+#if defined(VECCORE_BACKEND_VC_H) || defined(VECCORE_BACKEND_UMESIMD_H)
+#error "VecCore/Agner includes other backends"
+#endif
+
+#if !defined(VECCORE_ENABLE_AGNER) || !defined(VECCORE_MATH_INCLUDED)
+#error "VecCore/Agner is incomplete"
+#endif
+
+// the 512 bit vectors are left out unless VECCORE_ENABLE_AGNER_AVX512 is
+// defined first
+
+#if MAX_VECTOR_SIZE > 256 || defined(VECCORE_ENABLE_AGNER_AVX512)
+#error "VecCore/Agner includes the 512 bit vectors"
+#endif
+
+// the containers and utilities of VecCore/Library are left out
+
+#if defined(VECCORE_LIBRARY_INCLUDED) || defined(VECCORE_ARENA_H) || defined(VECCORE_HISTOGRAM_H) ||             \
+    defined(VECCORE_AOSOA_H) || defined(VECCORE_COMPLEX_H) || defined(VECCORE_VECTOR3D_H) ||                    \
+    defined(VECCORE_GEOMETRY_H) || defined(VECCORE_ARRAY_EXPRESSION_H) || defined(VECCORE_LANE_PROFILER_H)
+#error "VecCore/Agner includes VecCore/Library"
+#endif
+
+// and are included one by one after it
+
+#include <VecCore/Complex.h>
+#include <VecCore/Vector3D.h>
+
+using namespace vecCore;
+
+TEST(HeaderTest, Agner)
+{
+  using Float_v = backend::AgnerAVX::Float_v;
+
+  Float_v x(2.0f);
+  EXPECT_FLOAT_EQ(Get(math::Sqrt(x * x), 0), 2.0f);
+  EXPECT_EQ(Get(NumericLimits<Float_v>::Max(), 0), std::numeric_limits<float>::max());
+
+  const float data[] = {1.0f, -5.0f, 3.0f};
+  EXPECT_EQ(ArgMin<Float_v>(data, 3), 1u);
+}
+
+TEST(HeaderTest, Library)
+{
+  using Float_v = backend::AgnerAVX::Float_v;
+
+  Complex<Float_v> z(Float_v(3.0f), Float_v(4.0f));
+  Float_v r = math::Sqrt(math::Abs2(z));
+
+  for (size_t i = 0; i < VectorSize<Float_v>(); ++i)
+    EXPECT_FLOAT_EQ(Get(r, i), 5.0f);
+
+  Vector3D<double> v(3.0, 4.0, 12.0);
+  EXPECT_DOUBLE_EQ(v.Mag2(), 169.0);
+}
+
+int main(int argc, char *argv[])
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,43 @@
+#include <VecCore/Scalar>
+
+#include <gtest/gtest.h>
+
+// VecCore/Scalar compiles on its own, with neither the vector backends nor
+// the containers and utilities of VecCore/Library
+
+#if defined(VECCORE_BACKEND_AGNER_VECTORCLASS_H) || defined(VECCORE_BACKEND_VC_H) ||                          \
+    defined(VECCORE_BACKEND_UMESIMD_H)
+#error "VecCore/Scalar includes other backends"
+#endif
+
+#if !defined(VECCORE_MATH_INCLUDED) || defined(VECCORE_LIBRARY_INCLUDED) || defined(VECCORE_ARENA_H) ||        \
+    defined(VECCORE_COMPLEX_H) || defined(VECCORE_VECTOR3D_H) || defined(VECCORE_AOSOA_H)
+#error "VecCore/Scalar includes VecCore/Library"
+#endif
+
+using namespace vecCore;
+
+template <class Backend>
+void TestMath()
+{
+  using Double_v = typename Backend::Double_v;
+
+  Double_v x(-4.0);
+  EXPECT_DOUBLE_EQ(Get(math::Sqrt(math::Abs(x)), 0), 2.0);
+  EXPECT_DOUBLE_EQ(Get(NumericLimits<Double_v>::Lowest(), 0), std::numeric_limits<double>::lowest());
+
+  const double data[] = {1.0, -5.0, 3.0};
+  EXPECT_EQ(ArgMax<Double_v>(data, 3), 2u);
+}
+
+TEST(HeaderTest, Scalar)
+{
+  TestMath<backend::Scalar>();
+  TestMath<backend::ScalarWrapper>();
+}
+
+int main(int argc, char *argv[])
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
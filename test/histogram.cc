@@ -0,0 +1,292 @@
+#include <VecCore/VecCore>
+
+#include <thread>
+#include <vector>
+#include <gtest/gtest.h>
+
+using namespace testing;
+
+#if defined(GTEST_HAS_TYPED_TEST) && defined(GTEST_HAS_TYPED_TEST_P)
+
+template <class Backend>
+using FloatTypes = Types<typename Backend::Float_v, typename Backend::Double_v>;
+
+///////////////////////////////////////////////////////////////////////////////
+
+template <class T>
+class VectorTypeTest : public Test {
+public:
+  using Scalar_t = typename vecCore::ScalarType<T>::Type;
+  using Vector_t = T;
+  using Index_v  = typename vecCore::Index_v<T>;
+  using Index_t  = typename vecCore::ScalarType<Index_v>::Type;
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+template <class T>
+class ConflictTest : public VectorTypeTest<T> {
+};
+
+TYPED_TEST_CASE_P(ConflictTest);
+
+TYPED_TEST_P(ConflictTest, ConflictFree)
+{
+  using Index_v = typename TestFixture::Index_v;
+  using Index_t = typename TestFixture::Index_t;
+
+  size_t kVS = vecCore::VectorSize<Index_v>();
+
+  Index_v idx(Index_t(0));
+  for (size_t i = 0; i < kVS; ++i)
+    vecCore::Set(idx, i, Index_t(kVS - i));
+
+  EXPECT_TRUE(vecCore::ConflictFree(idx));
+
+  if (kVS == 1) return;
+
+  vecCore::Set(idx, kVS - 1, Index_t(kVS));
+
+  EXPECT_FALSE(vecCore::ConflictFree(idx));
+}
+
+TYPED_TEST_P(ConflictTest, ConflictPrefixSum)
+{
+  using Scalar_t = typename TestFixture::Scalar_t;
+  using Vector_t = typename TestFixture::Vector_t;
+  using Index_v  = typename TestFixture::Index_v;
+  using Index_t  = typename TestFixture::Index_t;
+
+  size_t kVS = vecCore::VectorSize<Vector_t>();
+
+  Index_v idx(Index_t(0));
+  Vector_t v(Scalar_t(0));
+
+  for (size_t i = 0; i < kVS; ++i) {
+    vecCore::Set(idx, i, Index_t(i % 3));
+    vecCore::Set(v, i, Scalar_t(i + 1));
+  }
+
+  Vector_t sum = vecCore::ConflictPrefixSum(v, idx);
+
+  for (size_t i = 0; i < kVS; ++i) {
+    Scalar_t expected(0);
+    for (size_t j = 0; j <= i; ++j)
+      if (j % 3 == i % 3) expected += Scalar_t(j + 1);
+    EXPECT_EQ(expected, vecCore::Get(sum, i));
+  }
+}
+
+REGISTER_TYPED_TEST_CASE_P(ConflictTest, ConflictFree, ConflictPrefixSum);
+
+///////////////////////////////////////////////////////////////////////////////
+
+template <class T>
+class HistogramTest : public VectorTypeTest<T> {
+public:
+  static constexpr size_t kNbins = 7;
+  static constexpr size_t kN     = 1024;
+
+  // few bins, so that most vectors have conflicts
+  void FillRandom(std::vector<size_t> &bins, std::vector<double> &weights)
+  {
+    bins.resize(kN);
+    weights.resize(kN);
+    for (size_t i = 0; i < kN; ++i) {
+      bins[i]    = static_cast<size_t>(kNbins * drand48());
+      weights[i] = static_cast<double>(static_cast<int>(16.0 * drand48()));
+    }
+  }
+};
+
+TYPED_TEST_CASE_P(HistogramTest);
+
+TYPED_TEST_P(HistogramTest, Unweighted)
+{
+  using Vector_t = typename TestFixture::Vector_t;
+  using Index_v  = typename TestFixture::Index_v;
+  using Index_t  = typename TestFixture::Index_t;
+
+  const size_t kNbins = TestFixture::kNbins;
+  const size_t kN     = TestFixture::kN;
+  size_t kVS          = vecCore::VectorSize<Vector_t>();
+
+  std::vector<size_t> bins;
+  std::vector<double> weights, expected(kNbins, 0.0);
+  this->FillRandom(bins, weights);
+
+  vecCore::Histogram<Vector_t> h(kNbins);
+
+  for (size_t i = 0; i < kN; i += kVS) {
+    Index_v idx(Index_t(0));
+    for (size_t j = 0; j < kVS; ++j) {
+      vecCore::Set(idx, j, Index_t(bins[i + j]));
+      expected[bins[i + j]] += 1.0;
+    }
+    h.Fill(idx);
+  }
+
+  for (size_t i = 0; i < kNbins; ++i)
+    EXPECT_EQ(expected[i], h[i]);
+}
+
+TYPED_TEST_P(HistogramTest, Weighted)
+{
+  using Scalar_t = typename TestFixture::Scalar_t;
+  using Vector_t = typename TestFixture::Vector_t;
+  using Index_v  = typename TestFixture::Index_v;
+  using Index_t  = typename TestFixture::Index_t;
+
+  const size_t kNbins = TestFixture::kNbins;
+  const size_t kN     = TestFixture::kN;
+  size_t kVS          = vecCore::VectorSize<Vector_t>();
+
+  std::vector<size_t> bins;
+  std::vector<double> weights, expected(kNbins, 0.0);
+  this->FillRandom(bins, weights);
+
+  vecCore::Histogram<Vector_t> h(kNbins);
+
+  for (size_t i = 0; i < kN; i += kVS) {
+    Index_v idx(Index_t(0));
+    Vector_t w(Scalar_t(0));
+    for (size_t j = 0; j < kVS; ++j) {
+      vecCore::Set(idx, j, Index_t(bins[i + j]));
+      vecCore::Set(w, j, Scalar_t(weights[i + j]));
+      expected[bins[i + j]] += weights[i + j];
+    }
+    h.Fill(idx, w);
+  }
+
+  for (size_t i = 0; i < kNbins; ++i)
+    EXPECT_EQ(Scalar_t(expected[i]), h[i]);
+}
+
+TYPED_TEST_P(HistogramTest, Masked)
+{
+  using Scalar_t = typename TestFixture::Scalar_t;
+  using Vector_t = typename TestFixture::Vector_t;
+  using Index_v  = typename TestFixture::Index_v;
+  using Index_t  = typename TestFixture::Index_t;
+
+  const size_t kNbins = TestFixture::kNbins;
+  const size_t kN     = TestFixture::kN;
+  size_t kVS          = vecCore::VectorSize<Vector_t>();
+
+  std::vector<size_t> bins;
+  std::vector<double> weights, expected(kNbins, 0.0);
+  this->FillRandom(bins, weights);
+
+  vecCore::Histogram<Vector_t> h(kNbins);
+
+  for (size_t i = 0; i < kN; i += kVS) {
+    Index_v idx(Index_t(0));
+    Vector_t w(Scalar_t(0));
+    vecCore::Mask<Vector_t> m(false);
+    for (size_t j = 0; j < kVS; ++j) {
+      bool active = (i / kVS + j) % 3 != 0;
+      // inactive lanes get an out of range bin, which must not be touched
+      vecCore::Set(idx, j, Index_t(active ? bins[i + j] : 1000000));
+      vecCore::Set(w, j, Scalar_t(weights[i + j]));
+      vecCore::Set(m, j, active);
+      if (active) expected[bins[i + j]] += weights[i + j];
+    }
+    h.Fill(idx, w, m);
+  }
+
+  for (size_t i = 0; i < kNbins; ++i)
+    EXPECT_EQ(Scalar_t(expected[i]), h[i]);
+}
+
+TYPED_TEST_P(HistogramTest, PerThread)
+{
+  using Scalar_t = typename TestFixture::Scalar_t;
+  using Vector_t = typename TestFixture::Vector_t;
+  using Index_v  = typename TestFixture::Index_v;
+  using Index_t  = typename TestFixture::Index_t;
+
+  const size_t kNbins   = TestFixture::kNbins;
+  const size_t kN       = TestFixture::kN;
+  const size_t kThreads = 4;
+  size_t kVS            = vecCore::VectorSize<Vector_t>();
+
+  std::vector<size_t> bins;
+  std::vector<double> weights, expected(kNbins, 0.0);
+  this->FillRandom(bins, weights);
+
+  for (size_t i = 0; i < kN; ++i)
+    expected[bins[i]] += weights[i];
+
+  vecCore::PerThreadHistogram<Vector_t> histograms(kNbins, kThreads);
+
+  std::vector<std::thread> threads;
+  for (size_t t = 0; t < kThreads; ++t) {
+    threads.emplace_back([&, t]() {
+      vecCore::Histogram<Vector_t> &h = histograms.Local(t);
+      for (size_t i = t * kVS; i < kN; i += kThreads * kVS) {
+        Index_v idx(Index_t(0));
+        Vector_t w(Scalar_t(0));
+        for (size_t j = 0; j < kVS; ++j) {
+          vecCore::Set(idx, j, Index_t(bins[i + j]));
+          vecCore::Set(w, j, Scalar_t(weights[i + j]));
+        }
+        h.Fill(idx, w);
+      }
+    });
+  }
+
+  for (auto &thread : threads)
+    thread.join();
+
+  vecCore::Histogram<Vector_t> h = histograms.Merge();
+
+  for (size_t i = 0; i < kNbins; ++i)
+    EXPECT_EQ(Scalar_t(expected[i]), h[i]);
+
+  // zero threads are one
+  vecCore::PerThreadHistogram<Vector_t> single(kNbins, 0);
+  EXPECT_EQ(single.GetNthreads(), 1u);
+  EXPECT_EQ(single.GetNbins(), kNbins);
+  EXPECT_EQ(single.Merge().GetNbins(), kNbins);
+}
+
+REGISTER_TYPED_TEST_CASE_P(HistogramTest, Unweighted, Weighted, Masked, PerThread);
+
+#define TEST_BACKEND_P(name, x)                                                      \
+  INSTANTIATE_TYPED_TEST_CASE_P(name, ConflictTest, FloatTypes<vecCore::backend::x>); \
+  INSTANTIATE_TYPED_TEST_CASE_P(name, HistogramTest, FloatTypes<vecCore::backend::x>)
+
+#define TEST_BACKEND(x) TEST_BACKEND_P(x, x)
+
+///////////////////////////////////////////////////////////////////////////////
+
+TEST_BACKEND(Scalar);
+TEST_BACKEND(ScalarWrapper);
+
+#ifdef VECCORE_ENABLE_VC
+TEST_BACKEND(VcScalar);
+TEST_BACKEND(VcVector);
+TEST_BACKEND_P(VcSimdArray, VcSimdArray<16>);
+#endif
+
+#ifdef VECCORE_ENABLE_UMESIMD
+TEST_BACKEND(UMESimd);
+TEST_BACKEND_P(UMESimdArray, UMESimdArray<16>);
+#endif
+
+#ifdef VECCORE_ENABLE_AGNER
+TEST_BACKEND(AgnerAVX);
+TEST_BACKEND(AgnerAVX512);
+#endif
+
+#else // if !GTEST_HAS_TYPED_TEST
+TEST(DummyTest, TypedTestsAreNotSupportedOnThisPlatform)
+{
+}
+#endif
+
+int main(int argc, char *argv[])
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
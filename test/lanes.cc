@@ -0,0 +1,181 @@
+#define VECCORE_PROFILE_LANES
+
+#include <VecCore/VecCore>
+
+#include <cstring>
+#include <gtest/gtest.h>
+
+using namespace testing;
+
+#if defined(GTEST_HAS_TYPED_TEST) && defined(GTEST_HAS_TYPED_TEST_P)
+
+template <class Backend>
+using FloatTypes = Types<typename Backend::Float_v, typename Backend::Double_v>;
+
+///////////////////////////////////////////////////////////////////////////////
+
+template <class T>
+class VectorTypeTest : public Test {
+public:
+  using Scalar_t = typename vecCore::ScalarType<T>::Type;
+  using Vector_t = T;
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+template <class T>
+class LaneProfileTest : public VectorTypeTest<T> {
+public:
+  using Scalar_t = typename VectorTypeTest<T>::Scalar_t;
+
+  // iota, i.e. 0, 1, 2, ..., so that x < n has the first n lanes active
+  static T Iota()
+  {
+    T x(Scalar_t(0));
+    for (size_t i = 0; i < vecCore::VectorSize<T>(); ++i)
+      vecCore::Set(x, i, Scalar_t(i));
+    return x;
+  }
+
+  // total number of calls recorded for a file and line
+  static uint64_t Calls(const char *file, int line)
+  {
+    uint64_t calls = 0;
+    for (auto site : vecCore::profile::LaneProfile::Instance().Sites())
+      if (strcmp(site->File(), file) == 0 && site->Line() == line) calls += site->Calls();
+    return calls;
+  }
+};
+
+TYPED_TEST_CASE_P(LaneProfileTest);
+
+TYPED_TEST_P(LaneProfileTest, Loop)
+{
+  using Scalar_t = typename TestFixture::Scalar_t;
+  using Vector_t = typename TestFixture::Vector_t;
+
+  constexpr size_t kVS = vecCore::VectorSize<Vector_t>();
+
+  vecCore::profile::LaneSite site(__FILE__, __LINE__, "MaskEmpty");
+
+  // one lane less is active in each iteration
+  const Vector_t iota = TestFixture::Iota();
+  Vector_t n = Vector_t(Scalar_t(kVS));
+  size_t iterations = 0;
+
+  while (!(vecCore::MaskEmpty)(site, iota < n)) {
+    n = n - Vector_t(Scalar_t(1));
+    ++iterations;
+  }
+
+  EXPECT_EQ(iterations, kVS);
+  EXPECT_EQ(site.Lanes(), kVS);
+  EXPECT_EQ(site.Calls(), kVS + 1);
+  EXPECT_EQ(site.Exits(), 1u);
+
+  for (size_t k = 0; k <= kVS; ++k)
+    EXPECT_EQ(site.Count(k), 1u);
+
+  EXPECT_EQ(site.ActiveLanes(), kVS * (kVS + 1) / 2);
+  EXPECT_DOUBLE_EQ(site.Utilization(), 0.5);
+}
+
+TYPED_TEST_P(LaneProfileTest, Masking)
+{
+  using Scalar_t = typename TestFixture::Scalar_t;
+  using Vector_t = typename TestFixture::Vector_t;
+
+  constexpr size_t kVS = vecCore::VectorSize<Vector_t>();
+
+  vecCore::profile::LaneSite assign(__FILE__, __LINE__, "MaskedAssign");
+  vecCore::profile::LaneSite blend(__FILE__, __LINE__, "Blend");
+  vecCore::profile::LaneSite full(__FILE__, __LINE__, "MaskFull");
+
+  const Vector_t iota = TestFixture::Iota();
+  const Vector_t one(Scalar_t(1));
+  const Vector_t zero(Scalar_t(0));
+
+  // results are the same as without the profiler
+  Vector_t x(zero);
+  (vecCore::MaskedAssign)(assign, x, iota < Vector_t(Scalar_t(1)), one);
+  Vector_t y = (vecCore::Blend)(blend, iota < Vector_t(Scalar_t(1)), one, zero);
+
+  for (size_t i = 0; i < kVS; ++i) {
+    EXPECT_EQ(vecCore::Get(x, i), i < 1 ? Scalar_t(1) : Scalar_t(0));
+    EXPECT_EQ(vecCore::Get(y, i), i < 1 ? Scalar_t(1) : Scalar_t(0));
+  }
+
+  EXPECT_EQ(assign.Calls(), 1u);
+  EXPECT_EQ(assign.Count(1), 1u);
+  EXPECT_EQ(assign.Exits(), 0u);
+  EXPECT_EQ(blend.Calls(), 1u);
+  EXPECT_EQ(blend.Count(1), 1u);
+
+  EXPECT_TRUE((vecCore::MaskFull)(full, iota < Vector_t(Scalar_t(kVS))));
+  EXPECT_FALSE((vecCore::MaskFull)(full, iota < Vector_t(Scalar_t(kVS - 1))));
+  EXPECT_EQ(full.Calls(), 2u);
+  EXPECT_EQ(full.Exits(), 1u);
+  EXPECT_EQ(full.Count(kVS), 1u);
+  EXPECT_EQ(full.Count(kVS - 1), 1u);
+}
+
+TYPED_TEST_P(LaneProfileTest, CallSites)
+{
+  using Scalar_t = typename TestFixture::Scalar_t;
+  using Vector_t = typename TestFixture::Vector_t;
+
+  const Vector_t iota = TestFixture::Iota();
+
+  // calls through the macros are recorded at the line of the call
+  const int line = __LINE__ + 1;
+  const bool empty = vecCore::MaskEmpty(iota < Vector_t(Scalar_t(0)));
+
+  EXPECT_TRUE(empty);
+  EXPECT_GE(TestFixture::Calls(__FILE__, line), 1u);
+
+  Vector_t x(Scalar_t(0));
+  const int assign = __LINE__ + 1;
+  vecCore::MaskedAssign(x, iota < Vector_t(Scalar_t(1)), Vector_t(Scalar_t(1)));
+
+  EXPECT_EQ(vecCore::Get(x, 0), Scalar_t(1));
+  EXPECT_GE(TestFixture::Calls(__FILE__, assign), 1u);
+}
+
+REGISTER_TYPED_TEST_CASE_P(LaneProfileTest, Loop, Masking, CallSites);
+
+#define TEST_BACKEND_P(name, x) INSTANTIATE_TYPED_TEST_CASE_P(name, LaneProfileTest, FloatTypes<vecCore::backend::x>);
+
+#define TEST_BACKEND(x) TEST_BACKEND_P(x, x)
+
+///////////////////////////////////////////////////////////////////////////////
+
+TEST_BACKEND(Scalar);
+TEST_BACKEND(ScalarWrapper);
+
+#ifdef VECCORE_ENABLE_VC
+TEST_BACKEND(VcScalar);
+TEST_BACKEND(VcVector);
+TEST_BACKEND_P(VcSimdArray, VcSimdArray<16>);
+#endif
+
+#ifdef VECCORE_ENABLE_UMESIMD
+TEST_BACKEND(UMESimd);
+TEST_BACKEND_P(UMESimdArray, UMESimdArray<16>);
+#endif
+
+#ifdef VECCORE_ENABLE_AGNER
+TEST_BACKEND(AgnerAVX);
+TEST_BACKEND(AgnerAVX512);
+#endif
+
+#else // if !GTEST_HAS_TYPED_TEST
+TEST(DummyTest, TypedTestsAreNotSupportedOnThisPlatform)
+{
+}
+#endif
+
+int main(int argc, char *argv[])
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
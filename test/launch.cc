@@ -0,0 +1,215 @@
+#include <VecCore/VecCore>
+#include <VecCore/Launch.h>
+
+#include <atomic>
+#include <stdexcept>
+#include <vector>
+#include <gtest/gtest.h>
+
+using namespace testing;
+
+#if defined(GTEST_HAS_TYPED_TEST) && defined(GTEST_HAS_TYPED_TEST_P)
+
+template <class Backend>
+using FloatTypes = Types<typename Backend::Float_v, typename Backend::Double_v>;
+
+///////////////////////////////////////////////////////////////////////////////
+
+template <class T>
+class VectorTypeTest : public Test {
+public:
+  using Scalar_t = typename vecCore::ScalarType<T>::Type;
+  using Vector_t = T;
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+// y = a * x + y, for the first n elements
+struct SaxpyKernel {
+  template <typename T, typename S>
+  void operator()(const vecCore::cpu::Thread<T> &t, S a, const S *x, S *y, size_t n) const
+  {
+    vecCore::Mask<T> m = t.Below(n);
+    if (vecCore::MaskEmpty(m)) return;
+
+    vecCore::Index<T> i = t.GlobalX();
+    for (size_t k = 0; k < vecCore::VectorSize<T>(); ++k)
+      if (vecCore::Get(m, k)) {
+        size_t j = size_t(vecCore::Get(i, k));
+        y[j]     = a * x[j] + y[j];
+      }
+  }
+};
+
+// Counts each thread of the grid once, and checks its indices
+struct CountKernel {
+  template <typename T>
+  void operator()(const vecCore::cpu::Thread<T> &t, std::atomic<int> *count, std::atomic<int> *errors) const
+  {
+    const vecCore::cpu::Dim3 &b = t.blockDim;
+    for (size_t k = 0; k < vecCore::VectorSize<T>(); ++k) {
+      if (!vecCore::Get(t.active, k)) continue;
+
+      const size_t x = size_t(vecCore::Get(t.threadIdx.x, k));
+      const size_t y = size_t(vecCore::Get(t.threadIdx.y, k));
+      const size_t z = size_t(vecCore::Get(t.threadIdx.z, k));
+      if (x >= b.x || y >= b.y || z >= b.z) ++*errors;
+      if (size_t(vecCore::Get(t.GlobalX(), k)) != t.blockIdx.x * b.x + x) ++*errors;
+
+      const size_t block  = (size_t(t.blockIdx.z) * t.gridDim.y + t.blockIdx.y) * t.gridDim.x + t.blockIdx.x;
+      const size_t thread = (z * b.y + y) * b.x + x;
+      ++count[block * b.Size() + thread];
+    }
+  }
+};
+
+template <class T>
+class LaunchTest : public VectorTypeTest<T> {
+};
+
+TYPED_TEST_CASE_P(LaunchTest);
+
+TYPED_TEST_P(LaunchTest, Saxpy)
+{
+  using Scalar_t = typename TestFixture::Scalar_t;
+  using Vector_t = typename TestFixture::Vector_t;
+
+  // the block size is not a multiple of the vector size, and the grid has
+  // more threads than elements
+  const size_t n = 1000, block = 100;
+
+  std::vector<Scalar_t> x(n + block), y(n + block);
+  for (size_t i = 0; i < x.size(); ++i) {
+    x[i] = Scalar_t(i);
+    y[i] = Scalar_t(1);
+  }
+
+  vecCore::cpu::Launch<Vector_t>(vecCore::cpu::Dim3((n + 2 * block - 1) / block), vecCore::cpu::Dim3(block),
+                                 SaxpyKernel(), Scalar_t(2), x.data(), y.data(), n);
+
+  for (size_t i = 0; i < y.size(); ++i)
+    EXPECT_EQ(y[i], i < n ? Scalar_t(2 * i + 1) : Scalar_t(1));
+}
+
+TYPED_TEST_P(LaunchTest, Indices)
+{
+  using Vector_t = typename TestFixture::Vector_t;
+
+  const vecCore::cpu::Dim3 grid(3, 2, 2), block(13, 3, 2);
+
+  std::vector<std::atomic<int>> count(grid.Size() * block.Size());
+  for (auto &c : count)
+    c = 0;
+  std::atomic<int> errors(0);
+
+  vecCore::cpu::Launch<Vector_t>(grid, block, CountKernel(), count.data(), &errors);
+
+  EXPECT_EQ(errors.load(), 0);
+  for (auto &c : count)
+    EXPECT_EQ(c.load(), 1);
+}
+
+REGISTER_TYPED_TEST_CASE_P(LaunchTest, Saxpy, Indices);
+
+#define TEST_BACKEND_P(name, x) INSTANTIATE_TYPED_TEST_CASE_P(name, LaunchTest, FloatTypes<vecCore::backend::x>);
+
+#define TEST_BACKEND(x) TEST_BACKEND_P(x, x)
+
+///////////////////////////////////////////////////////////////////////////////
+
+TEST_BACKEND(Scalar);
+TEST_BACKEND(ScalarWrapper);
+
+#ifdef VECCORE_ENABLE_VC
+TEST_BACKEND(VcScalar);
+TEST_BACKEND(VcVector);
+TEST_BACKEND_P(VcSimdArray, VcSimdArray<16>);
+#endif
+
+#ifdef VECCORE_ENABLE_UMESIMD
+TEST_BACKEND(UMESimd);
+TEST_BACKEND_P(UMESimdArray, UMESimdArray<16>);
+#endif
+
+#ifdef VECCORE_ENABLE_AGNER
+TEST_BACKEND(AgnerAVX);
+TEST_BACKEND(AgnerAVX512);
+#endif
+
+#else // if !GTEST_HAS_TYPED_TEST
+TEST(DummyTest, TypedTestsAreNotSupportedOnThisPlatform)
+{
+}
+#endif
+
+///////////////////////////////////////////////////////////////////////////////
+
+// Throws in one block
+struct Throw {
+  template <typename T>
+  void operator()(const vecCore::cpu::Thread<T> &t) const
+  {
+    if (t.blockIdx.x == 7) throw std::runtime_error("kernel");
+  }
+};
+
+// Launches a grid of one thread per block from each thread
+struct Nested {
+  template <typename T>
+  void operator()(const vecCore::cpu::Thread<T> &, std::atomic<int> *calls) const
+  {
+    vecCore::cpu::Launch(vecCore::cpu::Dim3(4), vecCore::cpu::Dim3(1), Inner(), calls);
+  }
+
+  struct Inner {
+    template <typename T>
+    void operator()(const vecCore::cpu::Thread<T> &, std::atomic<int> *calls) const
+    {
+      ++*calls;
+    }
+  };
+};
+
+TEST(ThreadPool, Exception)
+{
+  vecCore::cpu::ThreadPool pool(3);
+  EXPECT_THROW(vecCore::cpu::Launch(pool, vecCore::cpu::Dim3(16), vecCore::cpu::Dim3(4), Throw()),
+               std::runtime_error);
+
+  // the pool is still usable
+  std::atomic<int> calls(0);
+  vecCore::cpu::Launch(pool, vecCore::cpu::Dim3(16), vecCore::cpu::Dim3(1), Nested::Inner(), &calls);
+  EXPECT_EQ(calls.load(), 16);
+}
+
+TEST(ThreadPool, Nested)
+{
+  vecCore::cpu::ThreadPool pool(3);
+  std::atomic<int> calls(0);
+  vecCore::cpu::Launch(pool, vecCore::cpu::Dim3(8), vecCore::cpu::Dim3(2), Nested(), &calls);
+  EXPECT_EQ(calls.load(), 8 * 2 * 4);
+}
+
+TEST(ThreadPool, Run)
+{
+  for (size_t workers : {0, 1, 4}) {
+    vecCore::cpu::ThreadPool pool(workers);
+    EXPECT_EQ(pool.Size(), workers + 1);
+
+    std::vector<std::atomic<int>> count(1000);
+    for (auto &c : count)
+      c = 0;
+
+    for (int run = 0; run < 10; ++run)
+      pool.Run(count.size(), [&](size_t i) { ++count[i]; });
+
+    for (auto &c : count)
+      EXPECT_EQ(c.load(), 10);
+  }
+}
+
+int main(int argc, char *argv[])
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,286 @@
+#include <VecCore/VecCore>
+
+#include <cmath>
+#include <limits>
+#include <vector>
+#include <gtest/gtest.h>
+
+using namespace testing;
+
+#if defined(GTEST_HAS_TYPED_TEST) && defined(GTEST_HAS_TYPED_TEST_P)
+
+template <class Backend>
+using FloatTypes = Types<typename Backend::Float_v, typename Backend::Double_v>;
+
+///////////////////////////////////////////////////////////////////////////////
+
+template <class T>
+class VectorTypeTest : public Test {
+public:
+  using Scalar_t = typename vecCore::ScalarType<T>::Type;
+  using Vector_t = T;
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+template <class T>
+class LinearAlgebraTest : public VectorTypeTest<T> {
+public:
+  using Scalar_t   = typename VectorTypeTest<T>::Scalar_t;
+  using Vector3D_s = vecCore::Vector3D<Scalar_t>;
+  using Vector3D_v = vecCore::Vector3D<T>;
+
+  static constexpr size_t kN = 64;
+
+  static Scalar_t Tolerance() { return 32 * std::numeric_limits<Scalar_t>::epsilon(); }
+
+  static Scalar_t Random() { return static_cast<Scalar_t>(2.0 * drand48() - 1.0); }
+
+  static Vector3D_s RandomVector() { return Vector3D_s(Random(), Random(), Random()); }
+
+  // batch of random vectors
+  static Vector3D_v RandomVectors()
+  {
+    Vector3D_v v;
+    for (size_t i = 0; i < vecCore::VectorSize<T>(); ++i)
+      vecCore::Set(v, i, RandomVector());
+    return v;
+  }
+
+  // batch of random rotations
+  static vecCore::Quaternion<T> RandomRotations()
+  {
+    vecCore::Quaternion<T> q;
+    for (size_t i = 0; i < vecCore::VectorSize<T>(); ++i)
+      vecCore::Set(q, i, vecCore::Quaternion<Scalar_t>(Random(), RandomVector()));
+    q.Normalize();
+    return q;
+  }
+
+  static void ExpectNear(const Vector3D_s &u, const Vector3D_s &v)
+  {
+    for (int k = 0; k < 3; ++k)
+      EXPECT_NEAR(u[k], v[k], Tolerance());
+  }
+};
+
+TYPED_TEST_CASE_P(LinearAlgebraTest);
+
+TYPED_TEST_P(LinearAlgebraTest, Vector3D)
+{
+  using Scalar_t   = typename TestFixture::Scalar_t;
+  using Vector_t   = typename TestFixture::Vector_t;
+  using Vector3D_s = typename TestFixture::Vector3D_s;
+  using Vector3D_v = typename TestFixture::Vector3D_v;
+
+  size_t kVS = vecCore::VectorSize<Vector_t>();
+
+  EXPECT_EQ(kVS, vecCore::VectorSize<Vector3D_v>());
+
+  std::vector<Vector3D_s> input(TestFixture::kN), output(TestFixture::kN);
+  for (auto &v : input)
+    v = TestFixture::RandomVector();
+
+  for (size_t j = 0; j < TestFixture::kN; j += kVS) {
+    Vector3D_v u, v;
+    vecCore::Load(u, &input[j]);
+    v = TestFixture::RandomVectors();
+
+    Vector_t dot = vecCore::math::Dot(u, v), mag = u.Mag();
+    Vector3D_v cross = vecCore::math::Cross(u, v), unit = u.Unit(), sum = u + v, scaled = Vector_t(Scalar_t(2)) * u;
+
+    for (size_t i = 0; i < kVS; ++i) {
+      Vector3D_s a = input[j + i], b = vecCore::Get(v, i);
+
+      EXPECT_NEAR(a.X() * b.X() + a.Y() * b.Y() + a.Z() * b.Z(), vecCore::Get(dot, i), TestFixture::Tolerance());
+      EXPECT_NEAR(std::sqrt(a.X() * a.X() + a.Y() * a.Y() + a.Z() * a.Z()), vecCore::Get(mag, i),
+                  TestFixture::Tolerance());
+
+      Vector3D_s c(a.Y() * b.Z() - a.Z() * b.Y(), a.Z() * b.X() - a.X() * b.Z(), a.X() * b.Y() - a.Y() * b.X());
+      TestFixture::ExpectNear(c, vecCore::Get(cross, i));
+      TestFixture::ExpectNear(a / a.Mag(), vecCore::Get(unit, i));
+      TestFixture::ExpectNear(a + b, vecCore::Get(sum, i));
+      TestFixture::ExpectNear(a * Scalar_t(2), vecCore::Get(scaled, i));
+    }
+
+    vecCore::Store(u, &output[j]);
+  }
+
+  for (size_t i = 0; i < TestFixture::kN; ++i)
+    EXPECT_TRUE(input[i] == output[i]);
+}
+
+TYPED_TEST_P(LinearAlgebraTest, Matrix3x3)
+{
+  using Scalar_t   = typename TestFixture::Scalar_t;
+  using Vector_t   = typename TestFixture::Vector_t;
+  using Vector3D_v = typename TestFixture::Vector3D_v;
+  using Matrix_v   = vecCore::Matrix3x3<Vector_t>;
+
+  size_t kVS = vecCore::VectorSize<Vector_t>();
+
+  Matrix_v a(TestFixture::RandomVectors(), TestFixture::RandomVectors(), TestFixture::RandomVectors());
+  Matrix_v b(TestFixture::RandomVectors(), TestFixture::RandomVectors(), TestFixture::RandomVectors());
+  Vector3D_v v = TestFixture::RandomVectors();
+
+  Vector3D_v av = a * v, abv = (a * b) * v, atv = a.Transpose() * v;
+  Vector3D_v inv = a.Inverse() * av;
+  Vector_t det = a.Determinant();
+
+  for (size_t i = 0; i < kVS; ++i) {
+    auto as = vecCore::Get(a, i);
+    auto bs = vecCore::Get(b, i);
+    auto vs = vecCore::Get(v, i);
+
+    for (int r = 0; r < 3; ++r) {
+      Scalar_t ref = 0, ref_t = 0, ref_ab = 0;
+      for (int c = 0; c < 3; ++c) {
+        ref += as(r, c) * vs[c];
+        ref_t += as(c, r) * vs[c];
+        for (int k = 0; k < 3; ++k)
+          ref_ab += as(r, k) * bs(k, c) * vs[c];
+      }
+      EXPECT_NEAR(ref, vecCore::Get(av, i)[r], TestFixture::Tolerance());
+      EXPECT_NEAR(ref_t, vecCore::Get(atv, i)[r], TestFixture::Tolerance());
+      EXPECT_NEAR(ref_ab, vecCore::Get(abv, i)[r], TestFixture::Tolerance());
+    }
+
+    Scalar_t ref_det = as(0, 0) * (as(1, 1) * as(2, 2) - as(1, 2) * as(2, 1)) -
+                       as(0, 1) * (as(1, 0) * as(2, 2) - as(1, 2) * as(2, 0)) +
+                       as(0, 2) * (as(1, 0) * as(2, 1) - as(1, 1) * as(2, 0));
+    EXPECT_NEAR(ref_det, vecCore::Get(det, i), TestFixture::Tolerance());
+
+    // skip nearly singular matrices, for which the inverse is inaccurate
+    if (std::abs(ref_det) > Scalar_t(0.1)) {
+      for (int r = 0; r < 3; ++r)
+        EXPECT_NEAR(vs[r], vecCore::Get(inv, i)[r], 10 * TestFixture::Tolerance());
+    }
+  }
+}
+
+TYPED_TEST_P(LinearAlgebraTest, Quaternion)
+{
+  using Scalar_t   = typename TestFixture::Scalar_t;
+  using Vector_t   = typename TestFixture::Vector_t;
+  using Vector3D_v = typename TestFixture::Vector3D_v;
+  using Vector3D_s = typename TestFixture::Vector3D_s;
+  using Quat_v     = vecCore::Quaternion<Vector_t>;
+
+  size_t kVS = vecCore::VectorSize<Vector_t>();
+
+  // quarter turn around the z axis maps x onto y
+  const Vector_t zero(Scalar_t(0)), one(Scalar_t(1));
+  Quat_v z90 = Quat_v::AxisAngle(Vector3D_v(zero, zero, one), Vector_t(Scalar_t(M_PI / 2)));
+  Vector3D_v y = z90.Rotate(Vector3D_v(one, zero, zero));
+
+  for (size_t i = 0; i < kVS; ++i)
+    TestFixture::ExpectNear(Vector3D_s(0, 1, 0), vecCore::Get(y, i));
+
+  Quat_v p = TestFixture::RandomRotations(), q = TestFixture::RandomRotations();
+  Vector3D_v v = TestFixture::RandomVectors();
+
+  Vector3D_v rotated = q.Rotate(v), matrix = q.RotationMatrix() * v, composed = (p * q).Rotate(v);
+  Vector3D_v sequential = p.Rotate(q.Rotate(v)), back = q.Inverse().Rotate(rotated);
+  Vector_t det = q.RotationMatrix().Determinant(), norm = (p * q).Norm();
+
+  for (size_t i = 0; i < kVS; ++i) {
+    TestFixture::ExpectNear(vecCore::Get(rotated, i), vecCore::Get(matrix, i));
+    TestFixture::ExpectNear(vecCore::Get(sequential, i), vecCore::Get(composed, i));
+    TestFixture::ExpectNear(vecCore::Get(v, i), vecCore::Get(back, i));
+    EXPECT_NEAR(vecCore::Get(v, i).Mag(), vecCore::Get(rotated, i).Mag(), TestFixture::Tolerance());
+    EXPECT_NEAR(Scalar_t(1), vecCore::Get(det, i), TestFixture::Tolerance());
+    EXPECT_NEAR(Scalar_t(1), vecCore::Get(norm, i), TestFixture::Tolerance());
+  }
+}
+
+TYPED_TEST_P(LinearAlgebraTest, Transform3D)
+{
+  using Vector_t    = typename TestFixture::Vector_t;
+  using Vector3D_v  = typename TestFixture::Vector3D_v;
+  using Transform_v = vecCore::Transform3D<Vector_t>;
+
+  size_t kVS = vecCore::VectorSize<Vector_t>();
+
+  Transform_v a(TestFixture::RandomRotations(), TestFixture::RandomVectors());
+  Transform_v b(TestFixture::RandomRotations(), TestFixture::RandomVectors());
+  Vector3D_v p = TestFixture::RandomVectors(), d = TestFixture::RandomVectors();
+
+  Vector3D_v composed = (a * b).TransformPoint(p), sequential = a.TransformPoint(b.TransformPoint(p));
+  Vector3D_v back = a.InverseTransformPoint(a.TransformPoint(p)), inverse = a.Inverse().TransformPoint(a.TransformPoint(p));
+  Vector3D_v direction = a.InverseTransformDirection(a.TransformDirection(d));
+  Vector3D_v translated = a.TransformPoint(p) - a.TransformDirection(p);
+
+  for (size_t i = 0; i < kVS; ++i) {
+    TestFixture::ExpectNear(vecCore::Get(sequential, i), vecCore::Get(composed, i));
+    TestFixture::ExpectNear(vecCore::Get(p, i), vecCore::Get(back, i));
+    TestFixture::ExpectNear(vecCore::Get(p, i), vecCore::Get(inverse, i));
+    TestFixture::ExpectNear(vecCore::Get(d, i), vecCore::Get(direction, i));
+    TestFixture::ExpectNear(vecCore::Get(a.Translation(), i), vecCore::Get(translated, i));
+  }
+}
+
+TYPED_TEST_P(LinearAlgebraTest, Masking)
+{
+  using Scalar_t   = typename TestFixture::Scalar_t;
+  using Vector_t   = typename TestFixture::Vector_t;
+  using Vector3D_v = typename TestFixture::Vector3D_v;
+  using Quat_v     = vecCore::Quaternion<Vector_t>;
+
+  size_t kVS = vecCore::VectorSize<Vector_t>();
+
+  Vector3D_v u = TestFixture::RandomVectors(), v = TestFixture::RandomVectors(), w = v;
+  Quat_v p = TestFixture::RandomRotations(), q = TestFixture::RandomRotations(), r = q;
+
+  vecCore::Mask<Vector_t> mask = u.X() > Vector_t(Scalar_t(0));
+
+  vecCore::MaskedAssign(w, mask, u);
+  vecCore::MaskedAssign(r, mask, p);
+  Vector3D_v blend = vecCore::Blend(mask, u, v);
+
+  for (size_t i = 0; i < kVS; ++i) {
+    bool m = vecCore::Get(u, i).X() > 0;
+    EXPECT_TRUE(vecCore::Get(m ? u : v, i) == vecCore::Get(w, i));
+    EXPECT_TRUE(vecCore::Get(m ? u : v, i) == vecCore::Get(blend, i));
+    EXPECT_EQ(vecCore::Get(m ? p : q, i).W(), vecCore::Get(r, i).W());
+    EXPECT_TRUE(vecCore::Get(m ? p : q, i).V() == vecCore::Get(r, i).V());
+  }
+}
+
+REGISTER_TYPED_TEST_CASE_P(LinearAlgebraTest, Vector3D, Matrix3x3, Quaternion, Transform3D, Masking);
+
+#define TEST_BACKEND_P(name, x) INSTANTIATE_TYPED_TEST_CASE_P(name, LinearAlgebraTest, FloatTypes<vecCore::backend::x>);
+
+#define TEST_BACKEND(x) TEST_BACKEND_P(x, x)
+
+///////////////////////////////////////////////////////////////////////////////
+
+TEST_BACKEND(Scalar);
+TEST_BACKEND(ScalarWrapper);
+
+#ifdef VECCORE_ENABLE_VC
+TEST_BACKEND(VcScalar);
+TEST_BACKEND(VcVector);
+TEST_BACKEND_P(VcSimdArray, VcSimdArray<16>);
+#endif
+
+#ifdef VECCORE_ENABLE_UMESIMD
+TEST_BACKEND(UMESimd);
+TEST_BACKEND_P(UMESimdArray, UMESimdArray<16>);
+#endif
+
+#ifdef VECCORE_ENABLE_AGNER
+TEST_BACKEND(AgnerAVX);
+TEST_BACKEND(AgnerAVX512);
+#endif
+
+#else // if !GTEST_HAS_TYPED_TEST
+TEST(DummyTest, TypedTestsAreNotSupportedOnThisPlatform)
+{
+}
+#endif
+
+int main(int argc, char *argv[])
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -1,6 +1,10 @@
 #include <VecCore/VecCore>
+#include <VecCore/Backend/ExponentBits.h>
 
+#include <algorithm>
+#include <limits>
 #include <type_traits>
+#include <vector>
 #include <gtest/gtest.h>
 
 using namespace testing;
@@ -95,6 +99,350 @@ double uniform_random(double a, double b)
 
 #define TEST_MATH_FUNCTION_2(F, f) TEST_MATH_FUNCTION_RANGE_2(F, f, FLT_MIN, FLT_MAX, FLT_MIN, FLT_MAX)
 
+// special functions are compared against long double references, allowing
+// for an error of a given number of epsilons relative to max(|ref|, floor)
+
+#define TEST_MATH_FUNCTION_ULPS(func, reffunc, a, b, ulps, floor)                    \
+  TYPED_TEST_P(MathFunctions, func)                                                  \
+  {                                                                                  \
+    using Scalar_t = typename TestFixture::Scalar_t;                                 \
+    using Vector_t = typename TestFixture::Vector_t;                                 \
+                                                                                     \
+    auto kVS = vecCore::VectorSize<Vector_t>();                                      \
+    size_t N = 64 * kVS;                                                             \
+    Scalar_t input[N];                                                               \
+    Scalar_t output[N];                                                              \
+                                                                                     \
+    for (size_t i = 0; i < N; ++i) {                                                 \
+      input[i] = static_cast<Scalar_t>(uniform_random(a, b));                        \
+    }                                                                                \
+                                                                                     \
+    for (size_t j = 0; j < N; j += kVS) {                                            \
+      Vector_t x(vecCore::FromPtr<Vector_t>(&input[j]));                             \
+      Vector_t y = vecCore::math::func(x);                                           \
+      vecCore::Store<Vector_t>(y, &output[j]);                                       \
+    }                                                                                \
+                                                                                     \
+    for (size_t i = 0; i < N; ++i) {                                                 \
+      long double ref = reffunc(static_cast<long double>(input[i]));                 \
+      long double tol = ulps * std::numeric_limits<Scalar_t>::epsilon();             \
+      EXPECT_NEAR(output[i], ref, tol * std::max(std::abs(ref), floor)) << input[i]; \
+    }                                                                                \
+                                                                                     \
+    auto special = SpecialTestInputs<Scalar_t>(kVS);                                 \
+    for (size_t j = 0; j < special.size(); j += kVS) {                               \
+      Vector_t x(vecCore::FromPtr<Vector_t>(&special[j]));                           \
+      Vector_t y = vecCore::math::func(x);                                           \
+      for (size_t i = 0; i < kVS; ++i) {                                             \
+        Scalar_t ref = static_cast<Scalar_t>(reffunc(special[j + i]));               \
+        EXPECT_TRUE(SameSpecialValue(vecCore::Get(y, i), ref)) << special[j + i];    \
+      }                                                                              \
+    }                                                                                \
+  }
+
+// infinities, NaN and the largest finite value, where intermediate results
+// overflow, padded to a whole number of vectors
+
+template <typename S>
+std::vector<S> SpecialTestInputs(size_t kVS)
+{
+  using L = std::numeric_limits<S>;
+
+  std::vector<S> v = {L::infinity(), -L::infinity(), L::quiet_NaN(), L::max()};
+  while (v.size() % kVS)
+    v.push_back(L::infinity());
+
+  return v;
+}
+
+// both NaN, both infinite with the same sign, or equal up to rounding
+template <typename S>
+::testing::AssertionResult SameSpecialValue(S x, S ref)
+{
+  if (std::isnan(x) && std::isnan(ref)) return ::testing::AssertionSuccess();
+  if (std::isinf(ref) ? x == ref : std::abs(x - ref) <= 4 * std::numeric_limits<S>::epsilon() * std::abs(ref))
+    return ::testing::AssertionSuccess();
+  return ::testing::AssertionFailure() << x << " != " << ref;
+}
+
+long double BesselIRef(long double x, int nu)
+{
+  long double y = 0.25L * x * x, term = 1.0L, sum = 1.0L;
+  for (int k = 1; term > 1.0e-22L * sum; ++k) {
+    term *= y / (k * (k + nu));
+    sum += term;
+  }
+  return nu == 0 ? sum : 0.5L * x * sum;
+}
+
+long double BesselI0Ref(long double x)
+{
+  return BesselIRef(x, 0);
+}
+
+long double BesselI1Ref(long double x)
+{
+  return BesselIRef(x, 1);
+}
+
+// Frexp(), Ldexp(), Ilogb(), Modf() and Fmod() are exact, so results must be
+// identical to those of the standard library, including the sign of zero
+
+template <typename S>
+std::vector<S> ExponentTestInputs(size_t kVS)
+{
+  using L = std::numeric_limits<S>;
+
+  std::vector<S> v = {S(0),     -S(0),         S(1),           S(-1),                S(0.5),
+                      S(-2.75), S(7.25),       S(-0.3),        S(123456.7),
+                      L::min(), -L::min() / 3, L::denorm_min(), -7 * L::denorm_min(),
+                      L::max(), -L::max(),     L::infinity(),  -L::infinity(),       L::quiet_NaN()};
+
+  for (size_t i = 0; i < 64; ++i)
+    v.push_back(static_cast<S>(uniform_random(-1.0, 1.0) * std::pow(10.0, uniform_random(-30.0, 30.0))));
+
+  while (v.size() % kVS)
+    v.push_back(S(1));
+
+  return v;
+}
+
+template <typename S>
+::testing::AssertionResult SameValue(S x, S y)
+{
+  if ((std::isnan(x) && std::isnan(y)) || (x == y && std::signbit(x) == std::signbit(y)))
+    return ::testing::AssertionSuccess();
+  return ::testing::AssertionFailure() << x << " != " << y;
+}
+
+TYPED_TEST_P(MathFunctions, Frexp)
+{
+  using Scalar_t   = typename TestFixture::Scalar_t;
+  using Vector_t   = typename TestFixture::Vector_t;
+  using Exponent_t = vecCore::Exponent<Vector_t>;
+
+  auto kVS   = vecCore::VectorSize<Vector_t>();
+  auto input = ExponentTestInputs<Scalar_t>(kVS);
+
+  for (size_t j = 0; j < input.size(); j += kVS) {
+    Exponent_t exp;
+    Vector_t x(vecCore::FromPtr<Vector_t>(&input[j]));
+    Vector_t y = vecCore::math::Frexp(x, &exp);
+
+    for (size_t i = 0; i < kVS; ++i) {
+      int e;
+      Scalar_t ref = std::frexp(input[j + i], &e);
+      EXPECT_TRUE(SameValue<Scalar_t>(vecCore::Get(y, i), ref)) << input[j + i];
+      if (std::isfinite(input[j + i])) {
+        EXPECT_EQ(e, int(vecCore::Get(exp, i))) << input[j + i];
+      }
+    }
+  }
+}
+
+TYPED_TEST_P(MathFunctions, Ldexp)
+{
+  using Scalar_t   = typename TestFixture::Scalar_t;
+  using Vector_t   = typename TestFixture::Vector_t;
+  using Exponent_t = vecCore::Exponent<Vector_t>;
+
+  auto kVS   = vecCore::VectorSize<Vector_t>();
+  auto input = ExponentTestInputs<Scalar_t>(kVS);
+
+  // exponents which overflow, underflow and cross the subnormal range
+  for (int e : {0, 1, -1, 5, -30, 100, -140, 300, -300, 1070, -1070, 2000, -2000}) {
+    for (size_t j = 0; j < input.size(); j += kVS) {
+      Vector_t x(vecCore::FromPtr<Vector_t>(&input[j]));
+      Vector_t y = vecCore::math::Ldexp(x, Exponent_t(e));
+
+      for (size_t i = 0; i < kVS; ++i)
+        EXPECT_TRUE(SameValue<Scalar_t>(vecCore::Get(y, i), std::ldexp(input[j + i], e))) << input[j + i] << ", " << e;
+    }
+  }
+}
+
+TYPED_TEST_P(MathFunctions, Ilogb)
+{
+  using Scalar_t   = typename TestFixture::Scalar_t;
+  using Vector_t   = typename TestFixture::Vector_t;
+  using Exponent_t = vecCore::Exponent<Vector_t>;
+
+  auto kVS   = vecCore::VectorSize<Vector_t>();
+  auto input = ExponentTestInputs<Scalar_t>(kVS);
+
+  for (size_t j = 0; j < input.size(); j += kVS) {
+    Vector_t x(vecCore::FromPtr<Vector_t>(&input[j]));
+    Exponent_t y = vecCore::math::Ilogb(x);
+
+    for (size_t i = 0; i < kVS; ++i)
+      EXPECT_EQ(std::ilogb(input[j + i]), int(vecCore::Get(y, i))) << input[j + i];
+  }
+}
+
+TYPED_TEST_P(MathFunctions, Modf)
+{
+  using Scalar_t = typename TestFixture::Scalar_t;
+  using Vector_t = typename TestFixture::Vector_t;
+
+  auto kVS   = vecCore::VectorSize<Vector_t>();
+  auto input = ExponentTestInputs<Scalar_t>(kVS);
+
+  for (size_t j = 0; j < input.size(); j += kVS) {
+    Vector_t intpart;
+    Vector_t x(vecCore::FromPtr<Vector_t>(&input[j]));
+    Vector_t y = vecCore::math::Modf(x, &intpart);
+
+    for (size_t i = 0; i < kVS; ++i) {
+      Scalar_t ref_intpart;
+      Scalar_t ref = std::modf(input[j + i], &ref_intpart);
+      EXPECT_TRUE(SameValue<Scalar_t>(vecCore::Get(y, i), ref)) << input[j + i];
+      EXPECT_TRUE(SameValue<Scalar_t>(vecCore::Get(intpart, i), ref_intpart)) << input[j + i];
+    }
+  }
+}
+
+TYPED_TEST_P(MathFunctions, Fmod)
+{
+  using Scalar_t = typename TestFixture::Scalar_t;
+  using Vector_t = typename TestFixture::Vector_t;
+
+  auto kVS   = vecCore::VectorSize<Vector_t>();
+  auto input = ExponentTestInputs<Scalar_t>(kVS);
+
+  for (size_t j = 0; j < input.size(); j += kVS) {
+    Vector_t x(vecCore::FromPtr<Vector_t>(&input[j]));
+
+    for (size_t k = 0; k < input.size(); k += kVS) {
+      Vector_t y(vecCore::FromPtr<Vector_t>(&input[k]));
+      Vector_t r = vecCore::math::Fmod(x, y);
+
+      for (size_t i = 0; i < kVS; ++i) {
+        Scalar_t ref = std::fmod(input[j + i], input[k + i]);
+        EXPECT_TRUE(SameValue<Scalar_t>(vecCore::Get(r, i), ref)) << input[j + i] << ", " << input[k + i];
+      }
+    }
+  }
+
+  // the largest ratios of arguments, which take the most steps
+  using L = std::numeric_limits<Scalar_t>;
+  const Scalar_t pairs[][2] = {{L::max(), L::denorm_min()},   {L::max(), 3 * L::denorm_min()},
+                               {L::max(), Scalar_t(0.1)},     {-L::max(), L::min()},
+                               {L::max(), L::max() / 3},      {L::min(), 7 * L::denorm_min()},
+                               {Scalar_t(1e30), Scalar_t(3)}, {Scalar_t(5.5), Scalar_t(1.75)}};
+
+  for (auto &p : pairs) {
+    Vector_t r = vecCore::math::Fmod(Vector_t(p[0]), Vector_t(p[1]));
+    EXPECT_TRUE(SameValue<Scalar_t>(vecCore::Get(r, 0), std::fmod(p[0], p[1]))) << p[0] << ", " << p[1];
+  }
+}
+
+// sum of c[i] x^i and of its absolute terms, used for the error bound
+template <typename S>
+void PolynomialRef(const std::vector<S> &c, S x, long double *p, long double *abs)
+{
+  long double xi = 1.0L;
+  *p = *abs = 0.0L;
+  for (size_t i = 0; i < c.size(); ++i, xi *= x) {
+    *p += c[i] * xi;
+    *abs += std::abs(c[i] * xi);
+  }
+}
+
+struct AlternatingCoefficients {
+  static constexpr size_t kSize = 13;
+
+  static constexpr double Coef(size_t i) { return (i % 2 ? -1.0 : 1.0) / double(i + 1); }
+};
+
+TYPED_TEST_P(MathFunctions, Polynomial)
+{
+  using Scalar_t = typename TestFixture::Scalar_t;
+  using Vector_t = typename TestFixture::Vector_t;
+
+  const size_t kVS  = vecCore::VectorSize<Vector_t>();
+  const Scalar_t c[] = {Scalar_t(0.5),   Scalar_t(-1.25), Scalar_t(0.75), Scalar_t(2.0),  Scalar_t(-0.5),
+                        Scalar_t(0.125), Scalar_t(1.5),   Scalar_t(-1.0), Scalar_t(0.25), Scalar_t(-0.75),
+                        Scalar_t(1.0),   Scalar_t(0.5),   Scalar_t(-2.0), Scalar_t(0.375), Scalar_t(-0.125),
+                        Scalar_t(1.75),  Scalar_t(-1.5)};
+  std::vector<Scalar_t> coef(c, c + 17), alternating;
+  for (size_t i = 0; i < AlternatingCoefficients::kSize; ++i)
+    alternating.push_back(Scalar_t(AlternatingCoefficients::Coef(i)));
+
+  for (size_t n = 0; n < 1000; ++n) {
+    Vector_t x(Scalar_t(0));
+    for (size_t i = 0; i < kVS; ++i)
+      vecCore::Set(x, i, Scalar_t(uniform_random(-1.5, 1.5)));
+
+    // every degree up to 16, with both schemes, from arrays
+    Vector_t horner[17], estrin[17];
+#define EVAL_DEGREE(d)                                                 \
+  {                                                                    \
+    Scalar_t cd[d + 1];                                                \
+    std::copy(c, c + d + 1, cd);                                       \
+    horner[d] = vecCore::math::Horner(x, cd);                          \
+    estrin[d] = vecCore::math::Estrin(x, cd);                          \
+  }
+    EVAL_DEGREE(0) EVAL_DEGREE(1) EVAL_DEGREE(2) EVAL_DEGREE(3) EVAL_DEGREE(4) EVAL_DEGREE(5)
+    EVAL_DEGREE(6) EVAL_DEGREE(7) EVAL_DEGREE(8) EVAL_DEGREE(9) EVAL_DEGREE(10) EVAL_DEGREE(11)
+    EVAL_DEGREE(12) EVAL_DEGREE(13) EVAL_DEGREE(14) EVAL_DEGREE(15) EVAL_DEGREE(16)
+#undef EVAL_DEGREE
+
+    // coefficients as arguments and from a class
+    Vector_t hargs = vecCore::math::Horner(x, 0.5, -1.25, 0.75, 2.0);
+    Vector_t eargs = vecCore::math::Estrin(x, 0.5, -1.25, 0.75, 2.0, -0.5);
+    Vector_t hclass = vecCore::math::Horner<AlternatingCoefficients>(x);
+    Vector_t eclass = vecCore::math::Estrin<AlternatingCoefficients>(x);
+
+    for (size_t i = 0; i < kVS; ++i) {
+      Scalar_t xi = vecCore::Get(x, i);
+      long double ref, abs;
+
+      for (size_t d = 0; d <= 16; ++d) {
+        PolynomialRef(std::vector<Scalar_t>(c, c + d + 1), xi, &ref, &abs);
+        Scalar_t tol = Scalar_t(4 * (d + 1) * std::numeric_limits<Scalar_t>::epsilon() * abs);
+        EXPECT_NEAR(vecCore::Get(horner[d], i), ref, tol) << "degree " << d << ", x = " << xi;
+        EXPECT_NEAR(vecCore::Get(estrin[d], i), ref, tol) << "degree " << d << ", x = " << xi;
+      }
+
+      PolynomialRef(std::vector<Scalar_t>(c, c + 4), xi, &ref, &abs);
+      EXPECT_NEAR(vecCore::Get(hargs, i), ref, 16 * std::numeric_limits<Scalar_t>::epsilon() * abs);
+      PolynomialRef(std::vector<Scalar_t>(c, c + 5), xi, &ref, &abs);
+      EXPECT_NEAR(vecCore::Get(eargs, i), ref, 20 * std::numeric_limits<Scalar_t>::epsilon() * abs);
+      PolynomialRef(alternating, xi, &ref, &abs);
+      EXPECT_NEAR(vecCore::Get(hclass, i), ref, 52 * std::numeric_limits<Scalar_t>::epsilon() * abs);
+      EXPECT_NEAR(vecCore::Get(eclass, i), ref, 52 * std::numeric_limits<Scalar_t>::epsilon() * abs);
+    }
+  }
+}
+
+TYPED_TEST_P(MathFunctions, Rational)
+{
+  using Scalar_t = typename TestFixture::Scalar_t;
+  using Vector_t = typename TestFixture::Vector_t;
+
+  // Pade approximant of exp(x) of order [3/3]
+  const Scalar_t P[] = {Scalar_t(1), Scalar_t(0.5), Scalar_t(0.1), Scalar_t(1.0 / 120)};
+  const Scalar_t Q[] = {Scalar_t(1), Scalar_t(-0.5), Scalar_t(0.1), Scalar_t(-1.0 / 120)};
+
+  const size_t kVS = vecCore::VectorSize<Vector_t>();
+
+  for (size_t n = 0; n < 1000; ++n) {
+    Vector_t x(Scalar_t(0));
+    for (size_t i = 0; i < kVS; ++i)
+      vecCore::Set(x, i, Scalar_t(uniform_random(-1.0, 1.0)));
+
+    Vector_t r = vecCore::math::Rational(x, P, Q);
+
+    for (size_t i = 0; i < kVS; ++i) {
+      long double xi = vecCore::Get(x, i);
+      long double p  = 1 + xi * (0.5L + xi * (0.1L + xi / 120));
+      long double q  = 1 - xi * (0.5L - xi * (0.1L - xi / 120));
+      EXPECT_NEAR(vecCore::Get(r, i), p / q, 8 * std::numeric_limits<Scalar_t>::epsilon() * (p / q));
+      EXPECT_NEAR(vecCore::Get(r, i), std::exp(xi), 1.0e-4);
+    }
+  }
+}
+
 // commented functions are not yet implemented in Vc, need to be implemented in VecCore
 
 TEST_MATH_FUNCTION(Abs, abs);
@@ -120,8 +468,16 @@ TEST_MATH_FUNCTION_2(ATan2, atan2);
 TEST_MATH_FUNCTION_2(CopySign, copysign);
 TEST_MATH_FUNCTION_2(Pow, pow);
 
+TEST_MATH_FUNCTION_ULPS(Erf, std::erf, -6.0, 6.0, 4, 0.0L);
+TEST_MATH_FUNCTION_ULPS(Erfc, std::erfc, -3.0, 9.0, 16, 0.0L);
+TEST_MATH_FUNCTION_ULPS(LGamma, std::lgamma, -10.0, 100.0, 64, 1.0L);
+TEST_MATH_FUNCTION_ULPS(TGamma, std::tgamma, -10.0, 30.0, 64, 0.0L);
+TEST_MATH_FUNCTION_ULPS(BesselI0, BesselI0Ref, -50.0, 50.0, 16, 0.0L);
+TEST_MATH_FUNCTION_ULPS(BesselI1, BesselI1Ref, -50.0, 50.0, 16, 0.0L);
+
 REGISTER_TYPED_TEST_CASE_P(MathFunctions, Abs, Floor, Ceil, Sin, ASin, Cos, Tan, ATan, Exp, Log, Sqrt, Cbrt, Trunc, ATan2, CopySign,
-                           Pow);
+                           Pow, Erf, Erfc, LGamma, TGamma, BesselI0, BesselI1, Frexp, Ldexp, Ilogb, Modf, Fmod,
+                           Polynomial, Rational);
 
 #define TEST_BACKEND_P(name, x) INSTANTIATE_TYPED_TEST_CASE_P(name, MathFunctions, FloatTypes<vecCore::backend::x>);
 
@@ -149,6 +505,62 @@ TEST(DummyTest, TypedTestsAreNotSupportedOnThisPlatform)
 }
 #endif
 
+///////////////////////////////////////////////////////////////////////////////
+
+// The exponent bit manipulation used by the UME::SIMD and Vc::SimdArray
+// backends, tested here with the backends built everywhere
+
+template <typename T, typename B>
+void TestExponentBits()
+{
+  using Scalar_t   = vecCore::Scalar<T>;
+  using Exponent_t = vecCore::Exponent<T>;
+  using namespace vecCore::math::detail;
+
+  auto kVS   = vecCore::VectorSize<T>();
+  auto input = ExponentTestInputs<Scalar_t>(kVS);
+
+  for (size_t j = 0; j < input.size(); j += kVS) {
+    T x(vecCore::FromPtr<T>(&input[j]));
+
+    Exponent_t exp;
+    T m           = FrexpBits<B>(x, &exp);
+    Exponent_t lb = IlogbBits<B>(x);
+
+    for (size_t i = 0; i < kVS; ++i) {
+      int e;
+      Scalar_t ref = std::frexp(input[j + i], &e);
+      EXPECT_TRUE(SameValue<Scalar_t>(vecCore::Get(m, i), ref)) << input[j + i];
+      if (std::isfinite(input[j + i])) {
+        EXPECT_EQ(e, int(vecCore::Get(exp, i))) << input[j + i];
+      }
+      EXPECT_EQ(std::ilogb(input[j + i]), int(vecCore::Get(lb, i))) << input[j + i];
+    }
+
+    for (int e : {0, 1, -1, 100, -140, 300, -300, 1070, -1070, 2000, -2000}) {
+      T y = LdexpBits<B>(x, Exponent_t(e));
+      for (size_t i = 0; i < kVS; ++i)
+        EXPECT_TRUE(SameValue<Scalar_t>(vecCore::Get(y, i), std::ldexp(input[j + i], e))) << input[j + i] << ", " << e;
+    }
+  }
+}
+
+TEST(ExponentBits, Scalar)
+{
+  TestExponentBits<float, int32_t>();
+  TestExponentBits<double, int64_t>();
+}
+
+#ifdef VECCORE_ENABLE_AGNER
+TEST(ExponentBits, Agner)
+{
+  TestExponentBits<vcl::Vec8f, vcl::Vec8i>();
+  TestExponentBits<vcl::Vec4d, vcl::Vec4q>();
+  TestExponentBits<vcl::Vec16f, vcl::Vec16i>();
+  TestExponentBits<vcl::Vec8d, vcl::Vec8q>();
+}
+#endif
+
 int main(int argc, char *argv[])
 {
   ::testing::InitGoogleTest(&argc, argv);
@@ -0,0 +1,357 @@
+#include <VecCore/VecCore>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <random>
+#include <vector>
+
+using namespace testing;
+
+#if defined(GTEST_HAS_TYPED_TEST) && defined(GTEST_HAS_TYPED_TEST_P)
+
+template <class Backend>
+using FloatTypes = Types<typename Backend::Float_v, typename Backend::Double_v>;
+
+template <class Backend>
+using ReductionTypes = Types<typename Backend::Float_v, typename Backend::Double_v, typename Backend::Int32_v>;
+
+///////////////////////////////////////////////////////////////////////////////
+
+template <class T>
+class VectorTypeTest : public Test {
+public:
+  using Scalar_t = typename vecCore::ScalarType<T>::Type;
+  using Vector_t = T;
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+template <class T>
+class ReductionTest : public VectorTypeTest<T> {
+public:
+  // sizes with every possible number of elements in the tail
+  static size_t MaxSize() { return 3 * vecCore::VectorSize<T>() + 1; }
+};
+
+TYPED_TEST_CASE_P(ReductionTest);
+
+TYPED_TEST_P(ReductionTest, ArgMinMax)
+{
+  using Scalar_t = typename TestFixture::Scalar_t;
+
+  std::mt19937 gen(42);
+  std::uniform_int_distribution<int> dist(-1000, 1000);
+
+  EXPECT_EQ(vecCore::ArgMin<TypeParam>(nullptr, 0), 0u);
+  EXPECT_EQ(vecCore::ArgMax<TypeParam>(nullptr, 0), 0u);
+
+  for (size_t n = 1; n <= TestFixture::MaxSize(); ++n) {
+    std::vector<Scalar_t> x(n);
+    for (int trial = 0; trial < 16; ++trial) {
+      for (auto &y : x)
+        y = Scalar_t(dist(gen));
+
+      EXPECT_EQ(vecCore::ArgMin<TypeParam>(x.data(), n), size_t(std::min_element(x.begin(), x.end()) - x.begin()));
+      EXPECT_EQ(vecCore::ArgMax<TypeParam>(x.data(), n), size_t(std::max_element(x.begin(), x.end()) - x.begin()));
+    }
+  }
+}
+
+TYPED_TEST_P(ReductionTest, Ties)
+{
+  using Scalar_t = typename TestFixture::Scalar_t;
+
+  // the first of several equal extremes wins, wherever they are
+  for (size_t n = 1; n <= TestFixture::MaxSize(); ++n) {
+    for (size_t i = 0; i < n; ++i) {
+      std::vector<Scalar_t> x(n, Scalar_t(0));
+      for (size_t j = i; j < n; j += 3)
+        x[j] = Scalar_t(-1);
+
+      EXPECT_EQ(vecCore::ArgMin<TypeParam>(x.data(), n), i);
+
+      for (size_t j = i; j < n; j += 3)
+        x[j] = Scalar_t(1);
+
+      EXPECT_EQ(vecCore::ArgMax<TypeParam>(x.data(), n), i);
+    }
+
+    std::vector<Scalar_t> x(n, Scalar_t(5));
+    EXPECT_EQ(vecCore::ArgMin<TypeParam>(x.data(), n), 0u);
+    EXPECT_EQ(vecCore::ArgMax<TypeParam>(x.data(), n), 0u);
+  }
+}
+
+REGISTER_TYPED_TEST_CASE_P(ReductionTest, ArgMinMax, Ties);
+
+template <class T>
+class ReproducibleTest : public VectorTypeTest<T> {
+public:
+  using Scalar_t = typename VectorTypeTest<T>::Scalar_t;
+
+  // values over many orders of magnitude, with both signs, so that the order
+  // of the additions matters for a plain sum
+  static std::vector<Scalar_t> Data(size_t n)
+  {
+    std::mt19937 gen(7);
+    std::uniform_real_distribution<Scalar_t> mantissa(-1, 1);
+    std::uniform_int_distribution<int> exponent(-20, 20);
+
+    std::vector<Scalar_t> x(n);
+    for (auto &y : x)
+      y = std::ldexp(mantissa(gen), exponent(gen));
+    return x;
+  }
+};
+
+TYPED_TEST_CASE_P(ReproducibleTest);
+
+TYPED_TEST_P(ReproducibleTest, Backends)
+{
+  using Scalar_t = typename TestFixture::Scalar_t;
+
+  for (size_t n : {0, 1, 7, 100, 4099, 100003}) {
+    std::vector<Scalar_t> x = TestFixture::Data(n);
+
+    // the scalar backend gives the reference
+    EXPECT_EQ(vecCore::ReproducibleSum<TypeParam>(x.data(), n), vecCore::ReproducibleSum<Scalar_t>(x.data(), n));
+
+    std::vector<Scalar_t> y(x.rbegin(), x.rend());
+    EXPECT_EQ(vecCore::ReproducibleSum<TypeParam>(y.data(), n), vecCore::ReproducibleSum<Scalar_t>(x.data(), n));
+  }
+
+  EXPECT_EQ(vecCore::ReproducibleSum<TypeParam>(nullptr, 0), Scalar_t(0));
+}
+
+TYPED_TEST_P(ReproducibleTest, Merge)
+{
+  using Scalar_t      = typename TestFixture::Scalar_t;
+  using Accumulator_t = vecCore::ReproducibleAccumulator<TypeParam>;
+
+  const size_t n = 10007;
+  std::vector<Scalar_t> x = TestFixture::Data(n);
+
+  const Scalar_t bound = vecCore::MaxAbs<TypeParam>(x.data(), n);
+  const Scalar_t sum   = vecCore::ReproducibleSum<TypeParam>(x.data(), n);
+
+  // splits at arbitrary points, merged in either order, as for threads
+  for (size_t i : {0, 1, 13, 4096, 5003, 10006}) {
+    for (size_t j : {i, i + 1, (i + n) / 2, n}) {
+      Accumulator_t a(bound, n), b(bound, n), c(bound, n);
+      a.Add(x.data(), i);
+      b.Add(x.data() + i, j - i);
+      c.Add(x.data() + j, n - j);
+
+      Accumulator_t ab = a, cb = c;
+      ab.Merge(b);
+      ab.Merge(c);
+      cb.Merge(b);
+      cb.Merge(a);
+
+      EXPECT_EQ(ab.Result(), sum);
+      EXPECT_EQ(cb.Result(), sum);
+    }
+  }
+}
+
+TYPED_TEST_P(ReproducibleTest, Accuracy)
+{
+  using Scalar_t = typename TestFixture::Scalar_t;
+
+  for (size_t n : {1, 100, 100003}) {
+    std::vector<Scalar_t> x = TestFixture::Data(n);
+
+    long double exact = 0, norm = 0;
+    for (Scalar_t y : x) {
+      exact += y;
+      norm += std::abs(y);
+    }
+
+    Scalar_t sum = vecCore::ReproducibleSum<TypeParam>(x.data(), n);
+    EXPECT_LE(std::abs(sum - exact), std::abs(exact) * std::numeric_limits<Scalar_t>::epsilon() +
+                                         norm * std::pow(std::numeric_limits<Scalar_t>::epsilon(), 2));
+  }
+}
+
+TYPED_TEST_P(ReproducibleTest, Special)
+{
+  using Scalar_t = typename TestFixture::Scalar_t;
+
+  // all zeros, tiny and huge values, and exact cancellation
+  std::vector<Scalar_t> zeros(50, Scalar_t(0));
+  EXPECT_EQ(vecCore::ReproducibleSum<TypeParam>(zeros.data(), zeros.size()), Scalar_t(0));
+
+  const Scalar_t tiny = std::numeric_limits<Scalar_t>::denorm_min();
+  std::vector<Scalar_t> small(50, tiny);
+  EXPECT_EQ(vecCore::ReproducibleSum<TypeParam>(small.data(), small.size()), 50 * tiny);
+
+  const Scalar_t huge = std::numeric_limits<Scalar_t>::max() / 65536;
+  std::vector<Scalar_t> large(50, huge);
+  large[7] = -huge;
+  EXPECT_EQ(vecCore::ReproducibleSum<TypeParam>(large.data(), large.size()), 48 * huge);
+
+  std::vector<Scalar_t> cancel = {Scalar_t(1), Scalar_t(1e-5), Scalar_t(-1), Scalar_t(3), Scalar_t(-3)};
+  EXPECT_NEAR(vecCore::ReproducibleSum<TypeParam>(cancel.data(), cancel.size()), Scalar_t(1e-5), Scalar_t(1e-10));
+}
+
+REGISTER_TYPED_TEST_CASE_P(ReproducibleTest, Backends, Merge, Accuracy, Special);
+
+template <class T>
+class KahanTest : public VectorTypeTest<T> {
+};
+
+TYPED_TEST_CASE_P(KahanTest);
+
+TYPED_TEST_P(KahanTest, Accuracy)
+{
+  using Scalar_t = typename TestFixture::Scalar_t;
+
+  // increments below the rounding error of the running sum, which a plain
+  // sum drops entirely
+  const size_t n       = 10001;
+  const Scalar_t small = std::numeric_limits<Scalar_t>::epsilon() / 4;
+
+  std::vector<Scalar_t> x(n, small);
+  x[0] = Scalar_t(1);
+
+  vecCore::KahanAccumulator<TypeParam> sum;
+  sum.Add(x.data(), n);
+
+  const long double exact = 1 + (n - 1) * (long double)small;
+  EXPECT_NEAR(sum.Result(), exact, std::numeric_limits<Scalar_t>::epsilon() * exact);
+
+  // exact cancellation between lanes and within lanes
+  std::vector<Scalar_t> y = {Scalar_t(1e10), Scalar_t(1), Scalar_t(-1e10), Scalar_t(1e-3), Scalar_t(3)};
+  vecCore::KahanAccumulator<TypeParam> cancel;
+  cancel.Add(y.data(), y.size());
+  EXPECT_NEAR(cancel.Result(), Scalar_t(4.001), 4 * std::numeric_limits<Scalar_t>::epsilon());
+}
+
+TYPED_TEST_P(KahanTest, MaskedMerge)
+{
+  using Scalar_t = typename TestFixture::Scalar_t;
+
+  constexpr size_t kVS = vecCore::VectorSize<TypeParam>();
+
+  TypeParam x(Scalar_t(0));
+  vecCore::Mask<TypeParam> odd(false);
+  for (size_t i = 0; i < kVS; ++i) {
+    vecCore::Set(x, i, Scalar_t(i + 1));
+    vecCore::Set(odd, i, i % 2 == 1);
+  }
+
+  vecCore::KahanAccumulator<TypeParam> a, b;
+  for (int k = 0; k < 100; ++k) {
+    a.Add(x, odd);
+    b.Add(x);
+  }
+
+  Scalar_t expected(0), total(0);
+  for (size_t i = 0; i < kVS; ++i) {
+    expected += i % 2 == 1 ? Scalar_t(100 * (i + 1)) : Scalar_t(0);
+    total += Scalar_t(100 * (i + 1));
+  }
+
+  EXPECT_EQ(a.Result(), expected);
+
+  a.Merge(b);
+  EXPECT_EQ(a.Result(), expected + total);
+}
+
+REGISTER_TYPED_TEST_CASE_P(KahanTest, Accuracy, MaskedMerge);
+
+template <class Backend>
+class WideningTest : public Test {
+public:
+  using Float_v  = typename Backend::Float_v;
+  using Double_v = typename Backend::Double_v;
+};
+
+TYPED_TEST_CASE_P(WideningTest);
+
+TYPED_TEST_P(WideningTest, Widen)
+{
+  using Float_v  = typename TestFixture::Float_v;
+  using Double_v = typename TestFixture::Double_v;
+
+  constexpr size_t kVS   = vecCore::VectorSize<Float_v>();
+  constexpr size_t kWide = vecCore::VectorSize<Double_v>();
+
+  Float_v x(0.0f);
+  for (size_t i = 0; i < kVS; ++i)
+    vecCore::Set(x, i, 0.1f * float(i) + 1.0f);
+
+  for (size_t p = 0; p < kVS / kWide; ++p) {
+    Double_v d = vecCore::Widen<Double_v>(x, p);
+    for (size_t i = 0; i < kWide; ++i)
+      EXPECT_EQ(vecCore::Get(d, i), double(vecCore::Get(x, p * kWide + i)));
+  }
+}
+
+TYPED_TEST_P(WideningTest, Accumulator)
+{
+  using Float_v  = typename TestFixture::Float_v;
+  using Double_v = typename TestFixture::Double_v;
+
+  // the sum in single precision stops growing at 2^24
+  const size_t n = 3 * (1 << 24) / 2 + 3;
+  std::vector<float> x(n, 1.0f);
+
+  vecCore::WideningAccumulator<Float_v, Double_v> sum, part;
+  sum.Add(x.data(), n / 2);
+  part.Add(x.data() + n / 2, n - n / 2);
+  sum.Merge(part);
+  EXPECT_EQ(sum.Result(), double(n));
+
+  Float_v ones(1.0f);
+  vecCore::WideningAccumulator<Float_v, Double_v> masked;
+  masked.Add(ones, ones > Float_v(2.0f));
+  masked.Add(ones, ones < Float_v(2.0f));
+  EXPECT_EQ(masked.Result(), double(vecCore::VectorSize<Float_v>()));
+}
+
+REGISTER_TYPED_TEST_CASE_P(WideningTest, Widen, Accumulator);
+
+#define TEST_BACKEND_P(name, x)                                                                      \
+  INSTANTIATE_TYPED_TEST_CASE_P(name, ReductionTest, ReductionTypes<vecCore::backend::x>);           \
+  INSTANTIATE_TYPED_TEST_CASE_P(name, ReproducibleTest, FloatTypes<vecCore::backend::x>);            \
+  INSTANTIATE_TYPED_TEST_CASE_P(name, KahanTest, FloatTypes<vecCore::backend::x>);                   \
+  INSTANTIATE_TYPED_TEST_CASE_P(name, WideningTest, Types<vecCore::backend::x>);
+
+#define TEST_BACKEND(x) TEST_BACKEND_P(x, x)
+
+///////////////////////////////////////////////////////////////////////////////
+
+TEST_BACKEND(Scalar);
+TEST_BACKEND(ScalarWrapper);
+
+#ifdef VECCORE_ENABLE_VC
+TEST_BACKEND(VcScalar);
+TEST_BACKEND(VcVector);
+TEST_BACKEND_P(VcSimdArray, VcSimdArray<16>);
+#endif
+
+#ifdef VECCORE_ENABLE_UMESIMD
+TEST_BACKEND(UMESimd);
+TEST_BACKEND_P(UMESimdArray, UMESimdArray<16>);
+#endif
+
+#ifdef VECCORE_ENABLE_AGNER
+TEST_BACKEND(AgnerAVX);
+TEST_BACKEND(AgnerAVX512);
+#endif
+
+#else // if !GTEST_HAS_TYPED_TEST
+TEST(DummyTest, TypedTestsAreNotSupportedOnThisPlatform)
+{
+}
+#endif
+
+int main(int argc, char *argv[])
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,78 @@
+#define VECCORE_STRICT_FALLBACKS
+
+#include <VecCore/VecCore>
+
+#include <gtest/gtest.h>
+
+// With VECCORE_STRICT_FALLBACKS, operations that backends specialize compile
+// for their vector types, and so do the backend headers themselves
+
+using namespace testing;
+
+#if defined(GTEST_HAS_TYPED_TEST) && defined(GTEST_HAS_TYPED_TEST_P)
+
+template <class Backend>
+using FloatTypes = Types<typename Backend::Float_v, typename Backend::Double_v>;
+
+///////////////////////////////////////////////////////////////////////////////
+
+template <class T>
+class VectorTypeTest : public Test {
+public:
+  using Scalar_t = typename vecCore::ScalarType<T>::Type;
+  using Vector_t = T;
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+template <class T>
+class StrictTest : public VectorTypeTest<T> {
+};
+
+TYPED_TEST_CASE_P(StrictTest);
+
+TYPED_TEST_P(StrictTest, Specialized)
+{
+  using Scalar_t = typename TestFixture::Scalar_t;
+  using Vector_t = typename TestFixture::Vector_t;
+
+  constexpr size_t kVS = vecCore::VectorSize<Vector_t>();
+
+  Scalar_t data[kVS];
+  for (size_t i = 0; i < kVS; ++i)
+    data[i] = Scalar_t((i * 5) % 7);
+
+  Vector_t v;
+  vecCore::Load(v, data);
+
+  EXPECT_EQ(vecCore::ReduceMinIndex(v), 0u);
+  EXPECT_EQ(vecCore::ReduceMaxIndex(v), kVS > 4 ? 4u : kVS > 1 ? 1u : 0u);
+}
+
+REGISTER_TYPED_TEST_CASE_P(StrictTest, Specialized);
+
+#define TEST_BACKEND_P(name, x) INSTANTIATE_TYPED_TEST_CASE_P(name, StrictTest, FloatTypes<vecCore::backend::x>);
+
+#define TEST_BACKEND(x) TEST_BACKEND_P(x, x)
+
+///////////////////////////////////////////////////////////////////////////////
+
+TEST_BACKEND(Scalar);
+TEST_BACKEND(ScalarWrapper);
+
+#ifdef VECCORE_ENABLE_AGNER
+TEST_BACKEND(AgnerAVX);
+TEST_BACKEND(AgnerAVX512);
+#endif
+
+#else // if !GTEST_HAS_TYPED_TEST
+TEST(DummyTest, TypedTestsAreNotSupportedOnThisPlatform)
+{
+}
+#endif
+
+int main(int argc, char *argv[])
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
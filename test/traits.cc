@@ -11,6 +11,16 @@ using namespace vecCore;
 #define TEST_SCALAR_TRAIT(x, vector, scalar) \
   static_assert(std::is_same<TypeTraits<x::vector>::ScalarType, scalar>::value, "Type trait assertion failed");
 
+// testing that masks have as many lanes as their vectors
+#define TEST_MASK_SIZE(x, vector) \
+  static_assert(VectorSize<Mask<x::vector>>() == VectorSize<x::vector>(), "Mask size assertion failed");
+
+#define TEST_MASK_SIZES(x)    \
+  TEST_MASK_SIZE(x, Float_v)  \
+  TEST_MASK_SIZE(x, Double_v) \
+  TEST_MASK_SIZE(x, Int32_v)  \
+  TEST_MASK_SIZE(x, Int64_v)
+
 #define TEST_TRAIT(x)                      \
   TEST_SCALAR_TRAIT(x, Real_v, Real_s)     \
   TEST_SCALAR_TRAIT(x, Float_v, Float_s)   \
@@ -18,7 +28,8 @@ using namespace vecCore;
   TEST_SCALAR_TRAIT(x, Int32_v, Int32_s)   \
   TEST_SCALAR_TRAIT(x, UInt32_v, UInt32_s) \
   TEST_SCALAR_TRAIT(x, Int16_v, Int16_s)   \
-  TEST_SCALAR_TRAIT(x, UInt16_v, UInt16_s)
+  TEST_SCALAR_TRAIT(x, UInt16_v, UInt16_s) \
+  TEST_MASK_SIZES(x)
 
 TEST_TRAIT(backend::Scalar);
 TEST_TRAIT(backend::ScalarWrapper);
@@ -34,6 +45,54 @@ TEST_TRAIT(backend::UMESimd)
 TEST_TRAIT(backend::UMESimdArray<16>)
 #endif
 
+#ifdef VECCORE_ENABLE_AGNER
+TEST_MASK_SIZES(backend::AgnerAVX)
+TEST_MASK_SIZE(backend::AgnerAVX, Int16_v)
+TEST_MASK_SIZES(backend::AgnerAVX512)
+#endif
+
+// testing the capability traits, of which types of one lane have gather
+#define TEST_SCALAR_CAPABILITIES(x, vector)                                                          \
+  static_assert(HasNativeGather<x::vector>::value, "Capability assertion failed");                   \
+  static_assert(!IsHardwareMask<Mask<x::vector>>::value, "Capability assertion failed");            \
+  static_assert(!HasFMA<x::Int32_v>::value, "Capability assertion failed");
+
+TEST_SCALAR_CAPABILITIES(backend::Scalar, Float_v)
+TEST_SCALAR_CAPABILITIES(backend::Scalar, Double_v)
+TEST_SCALAR_CAPABILITIES(backend::ScalarWrapper, Float_v)
+TEST_SCALAR_CAPABILITIES(backend::ScalarWrapper, Double_v)
+
+#ifdef VECCORE_ENABLE_VC
+TEST_SCALAR_CAPABILITIES(backend::VcScalar, Float_v)
+TEST_SCALAR_CAPABILITIES(backend::VcScalar, Double_v)
+#endif
+
+#ifdef VECCORE_ENABLE_AGNER
+static_assert(HasNativeGather<backend::AgnerAVX::Float_v>::value == (INSTRSET >= 8), "Capability assertion failed");
+static_assert(HasNativeGather<backend::AgnerAVX512::Double_v>::value == (INSTRSET >= 8), "Capability assertion failed");
+static_assert(!HasNativeGather<backend::AgnerAVX::Int32_v>::value, "Capability assertion failed");
+static_assert(!HasNativeGather<backend::AgnerAVX::Int16_v>::value, "Capability assertion failed");
+static_assert(IsHardwareMask<Mask<backend::AgnerAVX512::Float_v>>::value == (INSTRSET >= 9), "Capability assertion failed");
+static_assert(!IsHardwareMask<Mask<backend::AgnerAVX::Float_v>>::value, "Capability assertion failed");
+static_assert(HasFMA<backend::AgnerAVX::Float_v>::value == HasFMA<Float_s>::value, "Capability assertion failed");
+static_assert(!HasFMA<backend::AgnerAVX::Int32_v>::value, "Capability assertion failed");
+#endif
+
+// Gather() and FMA() of Vc use the generic versions
+#ifdef VECCORE_ENABLE_VC
+static_assert(!HasNativeGather<backend::VcVector::Float_v>::value, "Capability assertion failed");
+static_assert(!HasNativeGather<backend::VcSimdArray<16>::Float_v>::value, "Capability assertion failed");
+static_assert(!HasFMA<backend::VcVector::Float_v>::value, "Capability assertion failed");
+static_assert(!HasFMA<backend::VcSimdArray<16>::Double_v>::value, "Capability assertion failed");
+#endif
+
+// FMA() of UME::SIMD is fused as for scalars, but Gather() is generic
+#ifdef VECCORE_ENABLE_UMESIMD
+static_assert(!HasNativeGather<backend::UMESimdArray<16>::Float_v>::value, "Capability assertion failed");
+static_assert(HasFMA<backend::UMESimdArray<16>::Float_v>::value == HasFMA<Float_s>::value, "Capability assertion failed");
+static_assert(!HasFMA<backend::UMESimdArray<16>::Int32_v>::value, "Capability assertion failed");
+#endif
+
 TEST(TraitTest, TraitTest)
 {
   // if this runs; it passes trivially